@@ -306,3 +306,43 @@ boundary_flow_integral (BoundaryFlow * bf, JBDOUBLE t, JBDOUBLE tmax)
   return _boundary_flow_integral (bf, t, tmax);
 }
 #endif
+
+/**
+ * \fn int boundary_flow_window(BoundaryFlow *bf, JBDOUBLE t, JBDOUBLE t2)
+ * \brief Function to move the window on the external time series file of a
+ *   flow boundary condition.
+ * \param bf
+ * \brief BoundaryFlow structure.
+ * \param t
+ * \brief initial time.
+ * \param t2
+ * \brief final time.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_BOUNDARY_FLOW_WINDOW
+int
+boundary_flow_window (BoundaryFlow * bf, JBDOUBLE t, JBDOUBLE t2)
+{
+  return _boundary_flow_window (bf, t, t2);
+}
+#endif
+
+/**
+ * \fn int boundary_flow_resample(BoundaryFlow *bf, JBDOUBLE h, JBDOUBLE *e)
+ * \brief Function to resample the time series of a flow boundary condition on
+ *   a uniform time grid.
+ * \param bf
+ * \brief BoundaryFlow structure.
+ * \param h
+ * \brief time interval of the grid.
+ * \param e
+ * \brief pointer to the maximum interpolation error.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_BOUNDARY_FLOW_RESAMPLE
+int
+boundary_flow_resample (BoundaryFlow * bf, JBDOUBLE h, JBDOUBLE * e)
+{
+  return _boundary_flow_resample (bf, h, e);
+}
+#endif
@@ -75,7 +75,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BOUNDARY_FLOW__H
 #define BOUNDARY_FLOW__H 1
 
-#include "points.h"
+#include "series.h"
 #include "junction_data.h"
 
 /**
@@ -225,6 +225,8 @@ typedef struct
  * \brief water mass contribution.
  * \var delay
  * \brief Macro to define the delay to apply the boundary condition.
+ * \var mass
+ * \brief water mass balance increment of the actual time step.
  * \var t
  * \brief array of times.
  * \var p1
@@ -239,13 +241,22 @@ typedef struct
  * \brief name of the last cross section to apply the boundary condition.
  * \var data
  * \brief additional data.
+ * \var cursor
+ * \brief cursors on the time series of the first and second parameters.
+ * \var series
+ * \brief external file of the time series.
+ * \var grid
+ * \brief time series resampled on a uniform time grid.
  */
   int type, pos, pos2, n, i, i2, position;
   JBFLOAT contribution, delay;
-  JBDOUBLE *t;
+  JBDOUBLE mass, *t;
   JBFLOAT *p1, *p2;
   char *name, *section, *section2;
   void *data;
+  SeriesCursor cursor[2];
+  SeriesFile series[1];
+  SeriesGrid grid[1];
 } BoundaryFlow;
 
 extern int simulating;
@@ -364,6 +375,8 @@ _boundary_flow_delete (BoundaryFlow * bf)
   jb_free_null ((void **) &bf->data);
   jb_free_null ((void **) &bf->section);
   jb_free_null ((void **) &bf->section2);
+  series_file_delete (bf->series);
+  series_grid_delete (bf->grid);
 #if DEBUG_BOUNDARY_FLOW_DELETE
   fprintf (stderr, "boundary_flow_delete: end\n");
 #endif
@@ -385,6 +398,8 @@ _boundary_flow_init_empty (BoundaryFlow * bf)
   bf->t = NULL;
   bf->p1 = bf->p2 = NULL;
   bf->data = NULL;
+  series_file_init_empty (bf->series);
+  series_grid_init_empty (bf->grid);
 #if DEBUG_BOUNDARY_FLOW_INIT_EMPTY
   fprintf (stderr, "boundary_flow_init_empty: end\n");
 #endif
@@ -541,6 +556,8 @@ _boundary_flow_copy (BoundaryFlow * bf, BoundaryFlow * bf_copy)
         goto exit1;
       memcpy (bf->p2, bf_copy->p2, i * sizeof (JBFLOAT));
     }
+  if (!series_file_copy (bf->series, bf_copy->series, bf->n))
+    goto exit1;
   switch (bf->type)
     {
     case BOUNDARY_FLOW_TYPE_DAM:
@@ -848,6 +865,11 @@ type3itime:
     }
 
 /*type3time:*/
+  if (xmlHasProp (node, XML_FILE))
+    {
+      i = 2;
+      goto typefile;
+    }
   xmlFree (buffer);
   file = jb_xml_node_get_content_file (node, &buffer);
   if (!file)
@@ -903,6 +925,11 @@ type2itime:
     }
 
 type2time:
+  if (xmlHasProp (node, XML_FILE))
+    {
+      i = 1;
+      goto typefile;
+    }
   xmlFree (buffer);
   file = jb_xml_node_get_content_file (node, &buffer);
   if (!file)
@@ -940,6 +967,15 @@ type2time:
   fclose (file);
   goto exit0;
 
+typefile:
+  if (!series_file_open_xml (bf->series, node, i))
+    {
+      boundary_flow_error (bf, gettext ("Bad file"));
+      goto exit2;
+    }
+  bf->n = -1;
+  goto exit0;
+
 type2:
   xmlFree (buffer);
   file = jb_xml_node_get_content_file (node, &buffer);
@@ -1126,6 +1162,11 @@ _boundary_flow_save_xml (BoundaryFlow * bf, xmlNode * node)
     case BOUNDARY_FLOW_TYPE_ZT:
     case BOUNDARY_FLOW_TYPE_PIPE:
     case BOUNDARY_FLOW_TYPE_GATE:
+      if (bf->series->name)
+        {
+          series_file_save_xml (bf->series, node);
+          break;
+        }
       buffer = NULL;
       for (i = 0; i <= bf->n; ++i)
         {
@@ -1164,6 +1205,11 @@ _boundary_flow_save_xml (BoundaryFlow * bf, xmlNode * node)
       break;
     case BOUNDARY_FLOW_TYPE_QT_HT:
     case BOUNDARY_FLOW_TYPE_QT_ZT:
+      if (bf->series->name)
+        {
+          series_file_save_xml (bf->series, node);
+          break;
+        }
       for (i = 0; i <= bf->n; ++i)
         {
           buffer2 = jb_set_time (bf->t[i]);
@@ -1254,7 +1300,11 @@ _boundary_flow_parameter (BoundaryFlow * bf, JBDOUBLE t)
         case BOUNDARY_FLOW_TYPE_QT_ZT:
           t -= bf->delay;
         }
-      k = jbm_darray_farray_interpolate (t, bf->t, bf->p1, bf->n);
+      if (bf->grid->x)
+        k = series_interpolate (bf->cursor, t, bf->grid->x, bf->grid->p1,
+                                bf->grid->n);
+      else
+        k = series_interpolate (bf->cursor, t, bf->t, bf->p1, bf->n);
     }
 #if DEBUG_BOUNDARY_FLOW_PARAMETER
   fprintf (stderr, "boundary_flow_parameter: end\n");
@@ -1293,7 +1343,11 @@ _boundary_flow_parameter2 (BoundaryFlow * bf, JBDOUBLE t)
         case BOUNDARY_FLOW_TYPE_QT_ZT:
           t -= bf->delay;
         }
-      k = jbm_darray_farray_interpolate (t, bf->t, bf->p2, bf->n);
+      if (bf->grid->x)
+        k = series_interpolate (bf->cursor + 1, t, bf->grid->x, bf->grid->p2,
+                                bf->grid->n);
+      else
+        k = series_interpolate (bf->cursor + 1, t, bf->t, bf->p2, bf->n);
     }
 #if DEBUG_BOUNDARY_FLOW_PARAMETER2
   fprintf (stderr, "boundary_flow_parameter2: end\n");
@@ -1357,7 +1411,11 @@ static inline JBDOUBLE _boundary_flow_integral
       t -= bf->delay;
       tmax -= bf->delay;
     }
-  k = jbm_darray_farray_integral (bf->t, bf->p1, bf->n, t, tmax);
+  if (bf->grid->x)
+    k = series_integral (bf->cursor, t, tmax, bf->grid->x, bf->grid->p1,
+                         bf->grid->n);
+  else
+    k = series_integral (bf->cursor, t, tmax, bf->t, bf->p1, bf->n);
 #if DEBUG_BOUNDARY_FLOW_INTEGRAL
   fprintf (stderr, "BFI m=" FWL "\n", k);
   fprintf (stderr, "boundary_flow_integral: end\n");
@@ -1371,4 +1429,60 @@ static inline JBDOUBLE _boundary_flow_integral
 JBDOUBLE boundary_flow_integral (BoundaryFlow *, JBDOUBLE, JBDOUBLE);
 #endif
 
+static inline int
+_boundary_flow_window (BoundaryFlow * bf, JBDOUBLE t, JBDOUBLE t2)
+{
+  int k;
+#if DEBUG_BOUNDARY_FLOW_WINDOW
+  fprintf (stderr, "boundary_flow_window: start\n");
+  fprintf (stderr, "BFW t=" FWL " t2=" FWL "\n", t, t2);
+#endif
+  switch (bf->type)
+    {
+    case BOUNDARY_FLOW_TYPE_QT:
+    case BOUNDARY_FLOW_TYPE_HT:
+    case BOUNDARY_FLOW_TYPE_ZT:
+    case BOUNDARY_FLOW_TYPE_QT_HT:
+    case BOUNDARY_FLOW_TYPE_QT_ZT:
+      t -= bf->delay;
+      t2 -= bf->delay;
+    }
+  k = series_file_window (bf->series, t, t2, &bf->t, &bf->p1, &bf->p2,
+                          &bf->n, bf->cursor, 2);
+#if DEBUG_BOUNDARY_FLOW_WINDOW
+  fprintf (stderr, "BFW n=%d\n", bf->n);
+  fprintf (stderr, "boundary_flow_window: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_BOUNDARY_FLOW_WINDOW
+#define boundary_flow_window _boundary_flow_window
+#else
+int boundary_flow_window (BoundaryFlow *, JBDOUBLE, JBDOUBLE);
+#endif
+
+static inline int _boundary_flow_resample
+  (BoundaryFlow * bf, JBDOUBLE h, JBDOUBLE * e)
+{
+  int k;
+#if DEBUG_BOUNDARY_FLOW_RESAMPLE
+  fprintf (stderr, "boundary_flow_resample: start\n");
+#endif
+  k = series_grid_open (bf->grid, h, bf->t, bf->p1, bf->p2, bf->n, e);
+  if (k)
+    bf->cursor[0].h = bf->cursor[1].h = h;
+#if DEBUG_BOUNDARY_FLOW_RESAMPLE
+  fprintf (stderr, "BFR name=%s n=%d e=" FWL "\n", bf->name, bf->grid->n, *e);
+  fprintf (stderr, "boundary_flow_resample: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_BOUNDARY_FLOW_RESAMPLE
+#define boundary_flow_resample _boundary_flow_resample
+#else
+int boundary_flow_resample (BoundaryFlow *, JBDOUBLE, JBDOUBLE *);
+#endif
+
 #endif
@@ -165,3 +165,45 @@ boundary_transport_parameter (BoundaryTransport * bt, JBDOUBLE t)
   return _boundary_transport_parameter (bt, t);
 }
 #endif
+
+/**
+ * \fn int boundary_transport_window(BoundaryTransport *bt, JBDOUBLE t, \
+ *   JBDOUBLE t2)
+ * \brief Function to move the window on the external time series file of a
+ *   transported solute boundary condition.
+ * \param bt
+ * \brief BoundaryTransport structure.
+ * \param t
+ * \brief initial time.
+ * \param t2
+ * \brief final time.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_BOUNDARY_TRANSPORT_WINDOW
+int
+boundary_transport_window (BoundaryTransport * bt, JBDOUBLE t, JBDOUBLE t2)
+{
+  return _boundary_transport_window (bt, t, t2);
+}
+#endif
+
+/**
+ * \fn int boundary_transport_resample(BoundaryTransport *bt, JBDOUBLE h, \
+ *   JBDOUBLE *e)
+ * \brief Function to resample the time series of a transported solute
+ *   boundary condition on a uniform time grid.
+ * \param bt
+ * \brief BoundaryTransport structure.
+ * \param h
+ * \brief time interval of the grid.
+ * \param e
+ * \brief pointer to the maximum interpolation error.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_BOUNDARY_TRANSPORT_RESAMPLE
+int
+boundary_transport_resample (BoundaryTransport * bt, JBDOUBLE h, JBDOUBLE * e)
+{
+  return _boundary_transport_resample (bt, h, e);
+}
+#endif
@@ -45,7 +45,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BOUNDARY_TRANSPORT__H
 #define BOUNDARY_TRANSPORT__H 1
 
-#include "points.h"
+#include "series.h"
 
 /**
  * \def N_BOUNDARY_TRANSPORT_TYPES
@@ -95,6 +95,8 @@ typedef struct
  * \brief length to apply the boundary condition.
  * \var delay
  * \brief delay to apply the boundary condition.
+ * \var mass
+ * \brief solute mass balance increment of the actual time step.
  * \var t
  * \brief array of dates.
  * \var p
@@ -105,11 +107,20 @@ typedef struct
  * \brief name of the first cross section to apply the boundary condition.
  * \var section2
  * \brief name of the last cross section to apply the boundary condition.
+ * \var cursor
+ * \brief cursor on the time series.
+ * \var series
+ * \brief external file of the time series.
+ * \var grid
+ * \brief time series resampled on a uniform time grid.
  */
   int type, pos, pos2, n, i, i2;
   JBFLOAT contribution, length, delay, *p;
-  JBDOUBLE *t;
+  JBDOUBLE mass, *t;
   char *name, *section, *section2;
+  SeriesCursor cursor[1];
+  SeriesFile series[1];
+  SeriesGrid grid[1];
 } BoundaryTransport;
 
 extern int simulating;
@@ -176,6 +187,8 @@ _boundary_transport_delete (BoundaryTransport * bt)
   jb_free_null ((void **) &bt->name);
   jb_free_null ((void **) &bt->section);
   jb_free_null ((void **) &bt->section2);
+  series_file_delete (bt->series);
+  series_grid_delete (bt->grid);
 #if DEBUG_BOUNDARY_TRANSPORT_DELETE
   fprintf (stderr, "boundary_transport_delete: end\n");
 #endif
@@ -196,6 +209,8 @@ _boundary_transport_init_empty (BoundaryTransport * bt)
   bt->name = bt->section = bt->section2 = NULL;
   bt->t = NULL;
   bt->p = NULL;
+  series_file_init_empty (bt->series);
+  series_grid_init_empty (bt->grid);
 #if DEBUG_BOUNDARY_TRANSPORT_INIT_EMPTY
   fprintf (stderr, "boundary_transport_init_empty: end\n");
 #endif
@@ -247,6 +262,8 @@ static inline int _boundary_transport_copy
   if (!bt->p)
     goto exit1;
   memcpy (bt->p, bt_copy->p, i);
+  if (!series_file_copy (bt->series, bt_copy->series, bt->n))
+    goto exit1;
 
 exit0:
 #if DEBUG_BOUNDARY_TRANSPORT_COPY
@@ -391,6 +408,16 @@ static inline int _boundary_transport_open_xml
   else if (!xmlStrcmp ((const xmlChar *) buffer, XML_Q))
     {
       bt->type = 1;
+      if (xmlHasProp (node, XML_FILE))
+        {
+          if (!series_file_open_xml (bt->series, node, 1))
+            {
+              boundary_transport_error (bt, gettext ("Bad file"));
+              goto exit2;
+            }
+          bt->n = -1;
+          goto exit0;
+        }
       xmlFree (buffer);
       file = jb_xml_node_get_content_file (node, &buffer);
       if (!file)
@@ -429,6 +456,7 @@ static inline int _boundary_transport_open_xml
       goto exit2;
     }
 
+exit0:
 #if DEBUG_BOUNDARY_TRANSPORT_OPEN_XML
   boundary_transport_print (bt, stderr);
   fprintf (stderr, "boundary_transport_open_xml: end\n");
@@ -482,6 +510,11 @@ static inline void _boundary_transport_save_xml
       jb_xml_node_set_float (node, XML_MASS, bt->p[0]);
       break;
     case BOUNDARY_TRANSPORT_TYPE_Q:
+      if (bt->series->name)
+        {
+          series_file_save_xml (bt->series, node);
+          break;
+        }
       buffer = NULL;
       for (i = 0; i <= bt->n; ++i)
         {
@@ -518,7 +551,10 @@ static inline JBDOUBLE _boundary_transport_parameter
 {
   if (!simulating)
     return bt->p[0];
-  return jbm_darray_farray_interpolate (t - bt->delay, bt->t, bt->p, bt->n);
+  if (bt->grid->x)
+    return series_interpolate (bt->cursor, t - bt->delay, bt->grid->x,
+                               bt->grid->p1, bt->grid->n);
+  return series_interpolate (bt->cursor, t - bt->delay, bt->t, bt->p, bt->n);
 }
 
 #if INLINE_BOUNDARY_TRANSPORT_PARAMETER
@@ -527,4 +563,52 @@ static inline JBDOUBLE _boundary_transport_parameter
 JBDOUBLE boundary_transport_parameter (BoundaryTransport *, JBDOUBLE);
 #endif
 
+static inline int _boundary_transport_window
+  (BoundaryTransport * bt, JBDOUBLE t, JBDOUBLE t2)
+{
+  int k;
+#if DEBUG_BOUNDARY_TRANSPORT_WINDOW
+  fprintf (stderr, "boundary_transport_window: start\n");
+  fprintf (stderr, "BTW t=" FWL " t2=" FWL "\n", t, t2);
+#endif
+  // the parameter is delayed but the mass integral is not
+  k = series_file_window (bt->series, t - fmax (bt->delay, 0.),
+                          t2 - fmin (bt->delay, 0.), &bt->t, &bt->p, NULL,
+                          &bt->n, bt->cursor, 1);
+#if DEBUG_BOUNDARY_TRANSPORT_WINDOW
+  fprintf (stderr, "BTW n=%d\n", bt->n);
+  fprintf (stderr, "boundary_transport_window: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_BOUNDARY_TRANSPORT_WINDOW
+#define boundary_transport_window _boundary_transport_window
+#else
+int boundary_transport_window (BoundaryTransport *, JBDOUBLE, JBDOUBLE);
+#endif
+
+static inline int _boundary_transport_resample
+  (BoundaryTransport * bt, JBDOUBLE h, JBDOUBLE * e)
+{
+  int k;
+#if DEBUG_BOUNDARY_TRANSPORT_RESAMPLE
+  fprintf (stderr, "boundary_transport_resample: start\n");
+#endif
+  k = series_grid_open (bt->grid, h, bt->t, bt->p, NULL, bt->n, e);
+  if (k)
+    bt->cursor->h = h;
+#if DEBUG_BOUNDARY_TRANSPORT_RESAMPLE
+  fprintf (stderr, "BTR name=%s n=%d e=" FWL "\n", bt->name, bt->grid->n, *e);
+  fprintf (stderr, "boundary_transport_resample: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_BOUNDARY_TRANSPORT_RESAMPLE
+#define boundary_transport_resample _boundary_transport_resample
+#else
+int boundary_transport_resample (BoundaryTransport *, JBDOUBLE, JBDOUBLE *);
+#endif
+
 #endif
@@ -0,0 +1,157 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file calibration.c
+ * \brief Source file to define the calibration of the controlled cross
+ *   sections with checkpoint rollbacks.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "calibration.h"
+
+/**
+ * \fn void calibration_init_empty(Calibration *c)
+ * \brief Function to init an empty calibration.
+ * \param c
+ * \brief calibration.
+ */
+#if !INLINE_CALIBRATION_INIT_EMPTY
+void
+calibration_init_empty (Calibration * c)
+{
+  _calibration_init_empty (c);
+}
+#endif
+
+/**
+ * \fn void calibration_delete(Calibration *c)
+ * \brief Function to free the memory used by a calibration and to stop the
+ *   calibrating mode.
+ * \param c
+ * \brief calibration.
+ */
+#if !INLINE_CALIBRATION_DELETE
+void
+calibration_delete (Calibration * c)
+{
+  _calibration_delete (c);
+}
+#endif
+
+/**
+ * \fn int calibration_open(Calibration *c, System *s)
+ * \brief Function to open the calibration of the controlled cross sections of
+ *   a system. The controls are not actuated while calibrating.
+ * \param c
+ * \brief calibration.
+ * \param s
+ * \brief system of channels.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_CALIBRATION_OPEN
+int
+calibration_open (Calibration * c, System * s)
+{
+  return _calibration_open (c, s);
+}
+#endif
+
+/**
+ * \fn int calibration_start(Calibration *c, Sampler *sampler, \
+ *   Stream *plumes, Stream *contributions, System *s)
+ * \brief Function to start the calibration of a measured interval resetting
+ *   the gauges and saving the state in the calibration checkpoint.
+ * \param c
+ * \brief calibration with the state of the simulation loop in its checkpoint
+ *   header.
+ * \param sampler
+ * \brief solution sampler.
+ * \param plumes
+ * \brief plumes stream.
+ * \param contributions
+ * \brief contributions stream.
+ * \param s
+ * \brief system of channels.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_CALIBRATION_START
+int
+calibration_start (Calibration * c, Sampler * sampler, Stream * plumes,
+                   Stream * contributions, System * s)
+{
+  return _calibration_start (c, sampler, plumes, contributions, s);
+}
+#endif
+
+/**
+ * \fn int calibration_step(Calibration *c, System *s)
+ * \brief Function to compare the mean of the gauges in a measured interval with
+ *   the control parameters and to select the next gate positions by a secant
+ *   iteration.
+ * \param c
+ * \brief calibration.
+ * \param s
+ * \brief system of channels.
+ * \return 1 if the measured interval has to be simulated again, 0 otherwise.
+ */
+#if !INLINE_CALIBRATION_STEP
+int
+calibration_step (Calibration * c, System * s)
+{
+  return _calibration_step (c, s);
+}
+#endif
+
+/**
+ * \fn int calibration_rollback(Calibration *c, Sampler *sampler, \
+ *   Stream *plumes, Stream *contributions, System *s)
+ * \brief Function to restore the state at the start of the measured interval
+ *   with the next gate positions.
+ * \param c
+ * \brief calibration.
+ * \param sampler
+ * \brief opened solution sampler.
+ * \param plumes
+ * \brief plumes stream.
+ * \param contributions
+ * \brief contributions stream.
+ * \param s
+ * \brief system of channels.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_CALIBRATION_ROLLBACK
+int
+calibration_rollback (Calibration * c, Sampler * sampler, Stream * plumes,
+                      Stream * contributions, System * s)
+{
+  return _calibration_rollback (c, sampler, plumes, contributions, s);
+}
+#endif
@@ -0,0 +1,350 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file calibration.h
+ * \brief Header file to define the calibration of the controlled cross
+ *   sections with checkpoint rollbacks.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef CALIBRATION__H
+#define CALIBRATION__H 1
+
+#include "write.h"
+
+/**
+ * \struct CalibrationGauge
+ * \brief Structure to define the secant iteration calibrating a controlled
+ *   cross section.
+ */
+typedef struct
+{
+/**
+ * \var sg
+ * \brief section gauge of the controlled cross section.
+ * \var x
+ * \brief gate position of the next trial.
+ * \var x0
+ * \brief gate position of the former trial.
+ * \var f0
+ * \brief error of the gauge in the former trial.
+ * \var xb
+ * \brief gate position with the minimum error.
+ * \var fb
+ * \brief minimum error of the gauge.
+ * \var converged
+ * \brief 1 if the gate position is calibrated, 0 otherwise.
+ */
+  SectionGauge *sg;
+  JBDOUBLE x, x0, f0, xb, fb;
+  int converged;
+} CalibrationGauge;
+
+/**
+ * \struct Calibration
+ * \brief Structure to define the calibration of the controlled cross sections
+ *   in every measured interval.
+ */
+typedef struct
+{
+/**
+ * \var checkpoint
+ * \brief checkpoint header of the state at the start of the measured
+ *   interval.
+ * \var gauge
+ * \brief array of secant iterations of the controlled cross sections.
+ * \var n
+ * \brief number of controlled cross sections minus 1.
+ * \var iteration
+ * \brief number of trials in the actual measured interval.
+ * \var best
+ * \brief 1 if the actual trial simulates the best gate positions, 0
+ *   otherwise.
+ * \var periods
+ * \brief number of calibrated measured intervals.
+ * \var trials
+ * \brief number of repeated trials.
+ */
+  Checkpoint checkpoint[1];
+  CalibrationGauge *gauge;
+  int n, iteration, best, periods, trials;
+} Calibration;
+
+static inline void
+_calibration_init_empty (Calibration * c)
+{
+  c->gauge = NULL;
+  c->n = -1;
+  c->iteration = c->best = c->periods = c->trials = 0;
+}
+
+#if INLINE_CALIBRATION_INIT_EMPTY
+#define calibration_init_empty _calibration_init_empty
+#else
+void calibration_init_empty (Calibration *);
+#endif
+
+static inline void
+_calibration_delete (Calibration * c)
+{
+  g_free (c->gauge);
+  c->gauge = NULL;
+  c->n = -1;
+  calibrating = 0;
+}
+
+#if INLINE_CALIBRATION_DELETE
+#define calibration_delete _calibration_delete
+#else
+void calibration_delete (Calibration *);
+#endif
+
+static inline int
+_calibration_open (Calibration * c, System * s)
+{
+  int i, j;
+  GSList *list;
+  Channel *channel;
+#if DEBUG_CALIBRATION_OPEN
+  fprintf (stderr, "calibration_open: start\n");
+#endif
+  for (i = j = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+    j += g_slist_length (channel->list_section_gauge);
+  c->n = j - 1;
+  if (j)
+    {
+      c->gauge =
+        (CalibrationGauge *) g_try_malloc (j * sizeof (CalibrationGauge));
+      if (!c->gauge)
+        {
+          c->n = -1;
+          jbw_show_error2 (gettext ("Calibration"),
+                           gettext ("Not enough memory"));
+#if DEBUG_CALIBRATION_OPEN
+          fprintf (stderr, "calibration_open: end\n");
+#endif
+          return 0;
+        }
+      for (i = j = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+        for (list = channel->list_section_gauge; list; list = list->next)
+          c->gauge[j++].sg = (SectionGauge *) list->data;
+      mesh_cache_key (c->checkpoint->key, s, p, n);
+    }
+  calibrating = j > 0;
+#if DEBUG_CALIBRATION_OPEN
+  fprintf (stderr, "CO n=%d\n", c->n);
+  fprintf (stderr, "calibration_open: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_CALIBRATION_OPEN
+#define calibration_open _calibration_open
+#else
+int calibration_open (Calibration *, System *);
+#endif
+
+static inline int
+_calibration_start (Calibration * c, Sampler * sampler, Stream * plumes,
+                    Stream * contributions, System * s)
+{
+  int i;
+  CalibrationGauge *g;
+  CrossSection *cs;
+#if DEBUG_CALIBRATION_START
+  fprintf (stderr, "calibration_start: start\n");
+  fprintf (stderr, "CS t=" FWL "\n", t);
+#endif
+  for (i = 0, g = c->gauge; i <= c->n; ++i, ++g)
+    {
+      cs = g->sg->cs;
+      cs->nt = 0;
+      cs->pt = 0.;
+      g->x = g->xb = cs->j;
+      g->fb = INFINITY;
+      g->converged = 0;
+    }
+  c->iteration = c->best = 0;
+  ++c->periods;
+#if DEBUG_CALIBRATION_START
+  fprintf (stderr, "calibration_start: end\n");
+#endif
+  return checkpoint_save (c->checkpoint, sampler, plumes, contributions, s,
+                          s->calibration_path);
+}
+
+#if INLINE_CALIBRATION_START
+#define calibration_start _calibration_start
+#else
+int calibration_start (Calibration *, Sampler *, Stream *, Stream *, System *);
+#endif
+
+static inline int
+_calibration_step (Calibration * c, System * s)
+{
+  int i, k;
+  JBDOUBLE x, f;
+  CalibrationGauge *g;
+  CrossSection *cs;
+#if DEBUG_CALIBRATION_STEP
+  fprintf (stderr, "calibration_step: start\n");
+  fprintf (stderr, "CS t=" FWL " iteration=%d best=%d\n",
+           t, c->iteration, c->best);
+#endif
+  if (c->best)
+    {
+      c->best = 0;
+#if DEBUG_CALIBRATION_STEP
+      fprintf (stderr, "calibration_step: end\n");
+#endif
+      return 0;
+    }
+  ++c->iteration;
+  for (i = k = 0, g = c->gauge; i <= c->n; ++i, ++g)
+    {
+      cs = g->sg->cs;
+      f = cs->nt ? cs->pt / cs->nt - cs->parameter : 0.;
+#if DEBUG_CALIBRATION_STEP
+      fprintf (stderr, "CS i=%d j=%d error=" FWL "\n", i, cs->j, f);
+#endif
+      if (fabs (f) < fabs (g->fb))
+        {
+          g->xb = cs->j;
+          g->fb = f;
+        }
+      if (g->converged)
+        continue;
+      if (fabs (f) <= cs->tolerance)
+        {
+          g->converged = 1;
+          continue;
+        }
+      if (c->iteration == 1 || f == g->f0)
+        x = cs->j + (f > 0. ? 1. : -1.);
+      else
+        x = cs->j - f * (cs->j - g->x0) / (f - g->f0);
+      x = rint (fmax (0., fmin (x, cs->n)));
+      if (x == cs->j || (c->iteration > 1 && x == g->x0))
+        {
+          g->converged = 1;
+          continue;
+        }
+      g->x0 = cs->j;
+      g->f0 = f;
+      g->x = x;
+      k = 1;
+    }
+  if (k && c->iteration < s->calibration_iterations)
+    {
+      for (i = 0, g = c->gauge; i <= c->n; ++i, ++g)
+        if (g->converged)
+          g->x = g->xb;
+    }
+  else
+    {
+      for (i = 0, g = c->gauge; i <= c->n; ++i, ++g)
+        {
+          g->x = g->xb;
+          if (g->xb != g->sg->cs->j)
+            c->best = 1;
+        }
+      k = c->best;
+    }
+#if DEBUG_CALIBRATION_STEP
+  fprintf (stderr, "CS rollback=%d best=%d\n", k, c->best);
+  fprintf (stderr, "calibration_step: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_CALIBRATION_STEP
+#define calibration_step _calibration_step
+#else
+int calibration_step (Calibration *, System *);
+#endif
+
+static inline int
+_calibration_rollback (Calibration * c, Sampler * sampler, Stream * plumes,
+                       Stream * contributions, System * s)
+{
+  int i, j;
+  CalibrationGauge *g;
+  SectionVariable *sv;
+#if DEBUG_CALIBRATION_ROLLBACK
+  fprintf (stderr, "calibration_rollback: start\n");
+  fprintf (stderr, "CR t=" FWL "\n", t);
+#endif
+  if (s->save_solution)
+    {
+      fclose (s->solution_file);
+      s->solution_file = NULL;
+    }
+  for (i = 0; i <= s->nout; ++i)
+    write_output_close (s->output + i);
+  stream_close (plumes);
+  stream_close (contributions);
+  if (!checkpoint_load (c->checkpoint, sampler, plumes, contributions, s,
+                        s->calibration_name, s->calibration_path))
+    goto exit0;
+  for (i = 0, g = c->gauge; i <= c->n; ++i, ++g)
+    {
+      g->sg->cs->j = (int) g->x;
+      g->sg->cs->position = g->x;
+      for (j = 0; j < 2; ++j)
+        {
+          sv = g->sg->sv[j];
+          if (sv)
+            sv->ts1 = sv->ts2 = NULL;
+        }
+    }
+  if (!event_queue_open (event_queue, s))
+    goto exit0;
+  ++c->trials;
+#if DEBUG_CALIBRATION_ROLLBACK
+  fprintf (stderr, "calibration_rollback: end\n");
+#endif
+  return 1;
+
+exit0:
+#if DEBUG_CALIBRATION_ROLLBACK
+  fprintf (stderr, "calibration_rollback: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_CALIBRATION_ROLLBACK
+#define calibration_rollback _calibration_rollback
+#else
+int calibration_rollback
+  (Calibration *, Sampler *, Stream *, Stream *, System *);
+#endif
+
+#endif
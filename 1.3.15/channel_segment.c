@@ -47,9 +47,10 @@ channel_segment_delete (ChannelSegment * seg)
 
 #if !INLINE_CHANNEL_SEGMENT_OPEN_SECTION
 int
-channel_segment_open_section (ChannelSegment * seg, Section * s, JBDOUBLE x)
+channel_segment_open_section (ChannelSegment * seg, Section * s, JBDOUBLE x,
+                              SectionArena * arena)
 {
-  return _channel_segment_open_section (seg, s, x);
+  return _channel_segment_open_section (seg, s, x, arena);
 }
 #endif
 
@@ -37,6 +37,7 @@ typedef struct
   int n, nf;
   JBFLOAT x1, x2, z1, z2;
   SectionParameters *sp1, *sp2;
+  TransientSection *ts1, *ts2;
   Section s1[1], s2[1];
 } ChannelSegment;
 
@@ -85,10 +86,10 @@ void channel_segment_delete (ChannelSegment *);
 #endif
 
 static inline int _channel_segment_open_section
-  (ChannelSegment * seg, Section * s, JBDOUBLE x)
+  (ChannelSegment * seg, Section * s, JBDOUBLE x, SectionArena * arena)
 {
   int i;
-  register JBDOUBLE k, k2, z;
+  register JBDOUBLE k, k2, z, w;
   SectionParameters *sp, *sp1, *sp2;
   FrictionParameters *fp, *fp1, *fp2, *fp3;
 #if DEBUG_CHANNEL_SEGMENT_OPEN_SECTION
@@ -96,7 +97,7 @@ static inline int _channel_segment_open_section
   fprintf (stderr, "CSOS n=%d nf=%d\n", seg->n, seg->nf);
 //              channel_segment_print(seg,stderr);
 #endif
-  if (!section_create (s, seg->n, seg->nf))
+  if (!section_create (s, seg->n, seg->nf, arena))
     {
       i = 0;
       goto exit1;
@@ -128,33 +129,42 @@ static inline int _channel_segment_open_section
   s->hmin = seg->s1->hmin + k * (seg->s2->hmin - seg->s1->hmin);
   s->hmax = fmin (seg->s1->hmax, seg->s2->hmax);
   s->zleft = s->zright = z + seg->sp1[seg->n].z;
-  if (seg->s1->dz < seg->s2->dz)
-    {
-      s->dz = seg->s1->dz;
-      fp1 = seg->s1->fp;
-      fp2 = seg->s2->fp;
-      k2 = seg->s2->dz / s->dz;
-    }
+  if (seg->ts1 && seg->ts2
+      && section_pair_memo_get (s, seg->ts1, seg->ts2, k))
+    i = 1;
   else
     {
-      s->dz = seg->s2->dz;
-      fp1 = seg->s2->fp;
-      fp2 = seg->s1->fp;
-      k = 1. - k;
-      k2 = seg->s1->dz / s->dz;
-    }
+      w = k;
+      if (seg->s1->dz < seg->s2->dz)
+        {
+          s->dz = seg->s1->dz;
+          fp1 = seg->s1->fp;
+          fp2 = seg->s2->fp;
+          k2 = seg->s2->dz / s->dz;
+        }
+      else
+        {
+          s->dz = seg->s2->dz;
+          fp1 = seg->s2->fp;
+          fp2 = seg->s1->fp;
+          k = 1. - k;
+          k2 = seg->s1->dz / s->dz;
+        }
 #if DEBUG_CHANNEL_SEGMENT_OPEN_SECTION
-  fprintf (stderr, "CSOS nf=%d\n", seg->nf);
+      fprintf (stderr, "CSOS nf=%d\n", seg->nf);
 #endif
-  for (i = 0, fp = s->fp; i <= seg->nf; ++fp, ++i, ++fp1)
-    {
-      fp3 = fp2 + (int) rint (i * k2);
-      if (isfinite (fp1->r) && isfinite (fp3->r))
-        fp->r = fp1->r + k * (fp3->r - fp1->r);
-      else
-        fp->r = INFINITY;
-      fp->beta = fp1->beta + k * (fp3->beta - fp1->beta);
-      fp->dbetaA = fp1->dbetaA + k * (fp3->dbetaA - fp1->dbetaA);
+      for (i = 0, fp = s->fp; i <= seg->nf; ++fp, ++i, ++fp1)
+        {
+          fp3 = fp2 + (int) rint (i * k2);
+          if (isfinite (fp1->r) && isfinite (fp3->r))
+            fp->r = fp1->r + k * (fp3->r - fp1->r);
+          else
+            fp->r = INFINITY;
+          fp->beta = fp1->beta + k * (fp3->beta - fp1->beta);
+          fp->dbetaA = fp1->dbetaA + k * (fp3->dbetaA - fp1->dbetaA);
+        }
+      if (seg->ts1 && seg->ts2)
+        section_pair_memo_add (s, seg->ts1, seg->ts2, w);
     }
 #if DEBUG_CHANNEL_SEGMENT_OPEN_SECTION
   fprintf (stderr, "CSOS opening parameters\n");
@@ -176,7 +186,8 @@ exit2:
 #if INLINE_CHANNEL_SEGMENT_OPEN_SECTION
 #define channel_segment_open_section _channel_segment_open_section
 #else
-int channel_segment_open_section (ChannelSegment *, Section *, JBDOUBLE);
+int channel_segment_open_section (ChannelSegment *, Section *, JBDOUBLE,
+                                 SectionArena *);
 #endif
 
 static inline int
@@ -278,6 +289,12 @@ _channel_segment_open (ChannelSegment * seg,
   seg->x1 = x1;
   seg->x2 = x2;
   seg->z1 = sp1[0].z;
+  seg->ts1 = seg->ts2 = NULL;
+  if (section_pair_memo)
+    {
+      seg->ts1 = section_memo_key (ts1);
+      seg->ts2 = section_memo_key (ts2);
+    }
   seg->z2 = sp2[0].z;
 
   seg->nf = jbm_min (seg->s1->nf, seg->s2->nf);
@@ -57,6 +57,23 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * \brief Implicit coefficient for source terms.
  * \def FRICTION_CFL
  * \brief Number controlling the maximum time step size allowed by friction.
+ * \def STATUS_INTERVAL
+ * \brief Default wall time interval in seconds to rewrite the status file.
+ * \def CALIBRATION_ITERATIONS
+ * \brief Default maximum number of trials to calibrate the controlled cross
+ *   sections in every measured interval.
+ * \def CONTROL_TIME
+ * \brief Default control time in seconds of the controlled cross sections.
+ * \def SERIES_CURSOR_STEPS
+ * \brief Maximum number of intervals walked by a time series cursor before
+ *   searching.
+ * \def SERIES_FILE_WINDOW
+ * \brief Initial records number of the windows on the external time series
+ *   files.
+ * \def SERIES_GRID_MAX
+ * \brief Maximum number of intervals of a resampled time series.
+ * \def SECTION_ARENA_BLOCK
+ * \brief Size in bytes of the memory blocks of the section arenas.
  */
 #define INTERFACE INTERFACE_MARKET
 #define GUAD2D 0
@@ -66,6 +83,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CFL_DEFAULT 0.9
 #define flow_implicit 0.5
 #define FRICTION_CFL 20.
+#define STATUS_INTERVAL 10.
+#define CALIBRATION_ITERATIONS 4
+#define CONTROL_TIME 60.
+#define SERIES_CURSOR_STEPS 8
+#define SERIES_FILE_WINDOW 4096
+#define SERIES_GRID_MAX 16777216
+#define SECTION_ARENA_BLOCK 1048576
 
 #define SECTION_WIDTH_MIN 0.01
 #define DEPTH_MIN 1
@@ -73,6 +97,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define FRICTION_DZ 0.1
 #define GRANULOMETRIC_COEFFICIENT 0.12
 #define friction_b (1./6.)
+#define FRICTION_SIXTHS 1
 #define DIFFUSION_CONSTANT 10.
 
 #define MESH_BOUNDARY MESH_BOUNDARY_REDUCED
@@ -118,6 +143,21 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_SECTION_POINT2_COPY								0
 #define DEBUG_SECTION_POINT2_OPEN								0
 #define DEBUG_SECTION_POINT_TRANSFORM							0
+#define DEBUG_SERIES_CURSOR_RESET								0
+#define DEBUG_SERIES_SEARCH										0
+#define DEBUG_SERIES_INTERPOLATE								0
+#define DEBUG_SERIES_INTEGRAL									0
+#define DEBUG_SERIES_FILE_INIT_EMPTY							0
+#define DEBUG_SERIES_FILE_DELETE								0
+#define DEBUG_SERIES_FILE_COPY									0
+#define DEBUG_SERIES_FILE_OPEN_XML								0
+#define DEBUG_SERIES_FILE_SAVE_XML								0
+#define DEBUG_SERIES_FILE_OPEN									0
+#define DEBUG_SERIES_FILE_READ									0
+#define DEBUG_SERIES_FILE_WINDOW								0
+#define DEBUG_SERIES_GRID_INIT_EMPTY							0
+#define DEBUG_SERIES_GRID_DELETE								0
+#define DEBUG_SERIES_GRID_OPEN									0
 #define DEBUG_TRANSIENT_SECTION_ERROR							0
 #define DEBUG_TRANSIENT_SECTION_DELETE							0
 #define DEBUG_TRANSIENT_SECTION_INIT_EMPTY						0
@@ -153,6 +193,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_CROSS_SECTION_OPEN_XML							0
 #define DEBUG_CROSS_SECTION_SAVE_XML							0
 #define DEBUG_CROSS_SECTION_GET_TRANSIENT						0
+#define DEBUG_CROSS_SECTION_CONTROL								0
 #define DEBUG_CHANNEL_GEOMETRY_ERROR							0
 #define DEBUG_CHANNEL_GEOMETRY_DELETE							0
 #define DEBUG_CHANNEL_GEOMETRY_INIT_EMPTY						0
@@ -181,6 +222,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_BOUNDARY_FLOW_PARAMETER2							0
 #define DEBUG_BOUNDARY_FLOW_PARAMETER3							0
 #define DEBUG_BOUNDARY_FLOW_INTEGRAL							0
+#define DEBUG_BOUNDARY_FLOW_WINDOW								0
+#define DEBUG_BOUNDARY_FLOW_RESAMPLE							0
 #define DEBUG_BOUNDARY_TRANSPORT_ERROR							0
 #define DEBUG_BOUNDARY_TRANSPORT_DELETE							0
 #define DEBUG_BOUNDARY_TRANSPORT_INIT_EMPTY						0
@@ -188,6 +231,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_BOUNDARY_TRANSPORT_OPEN_XML						0
 #define DEBUG_BOUNDARY_TRANSPORT_SAVE_XML						0
 #define DEBUG_BOUNDARY_TRANSPORT_PARAMETER						0
+#define DEBUG_BOUNDARY_TRANSPORT_WINDOW							0
+#define DEBUG_BOUNDARY_TRANSPORT_RESAMPLE						0
 #define DEBUG_TRANSPORT_ERROR									0
 #define DEBUG_TRANSPORT_DELETE									0
 #define DEBUG_TRANSPORT_INIT_EMPTY								0
@@ -195,6 +240,31 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_TRANSPORT_COPY									0
 #define DEBUG_TRANSPORT_OPEN_XML								0
 #define DEBUG_TRANSPORT_SAVE_XML								0
+#define DEBUG_OUTPUT_ERROR										0
+#define DEBUG_OUTPUT_DELETE										0
+#define DEBUG_OUTPUT_INIT_EMPTY									0
+#define DEBUG_OUTPUT_COPY										0
+#define DEBUG_OUTPUT_VARIABLE									0
+#define DEBUG_OUTPUT_VARIABLE_NAME								0
+#define DEBUG_OUTPUT_OPEN_XML									0
+#define DEBUG_OUTPUT_SAVE_XML									0
+#define DEBUG_PROFILE_OPEN										0
+#define DEBUG_PROFILE_COUNTERS_OPEN								0
+#define DEBUG_PROFILE_PRINT										0
+#define DEBUG_PROFILE_SAVE										0
+#define DEBUG_PROFILE_CLOSE										0
+#define DEBUG_LIMITER_OPEN										0
+#define DEBUG_LIMITER_PRINT										0
+#define DEBUG_LIMITER_SAVE										0
+#define DEBUG_LIMITER_CLOSE										0
+#define DEBUG_EVENT_QUEUE_PUSH									0
+#define DEBUG_EVENT_QUEUE_OPEN									0
+#define DEBUG_EVENT_QUEUE_OPEN_OUTPUTS							0
+#define DEBUG_EVENT_QUEUE_STEP									0
+#define DEBUG_MEMORY_OPEN										0
+#define DEBUG_MEMORY_ACCOUNT									0
+#define DEBUG_MEMORY_RSS										0
+#define DEBUG_MEMORY_PRINT										0
 #define DEBUG_CHANNEL_TRANSPORT_ERROR							0
 #define DEBUG_CHANNEL_TRANSPORT_DELETE							0
 #define DEBUG_CHANNEL_TRANSPORT_INIT_EMPTY						0
@@ -229,6 +299,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_SYSTEM_CREATE										0
 #define DEBUG_SYSTEM_COPY										0
 #define DEBUG_SYSTEM_JUNCTIONS_SET_UP							0
+#define DEBUG_SYSTEM_OUTPUTS_SET_UP								0
 #define DEBUG_SYSTEM_OPEN_XML									0
 #define DEBUG_SYSTEM_SAVE_XML									0
 #define DEBUG_WAVE_VELOCITY										0
@@ -249,9 +320,17 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_SECTION_CRITICAL_DISCHARGE						0
 #define DEBUG_SECTION_CRITICAL_FUNCTION							0
 #define DEBUG_SECTION_CRITICAL_AREA								0
+#define DEBUG_SECTION_ARENA_DELETE								0
+#define DEBUG_SECTION_ARENA_ALLOC								0
 #define DEBUG_SECTION_DELETE									0
 #define DEBUG_SECTION_CREATE									0
 #define DEBUG_SECTION_COPY										0
+#define DEBUG_SECTION_SHARE										0
+#define DEBUG_SECTION_LINK										0
+#define DEBUG_SECTION_HASH_PARAMETERS							0
+#define DEBUG_SECTION_EQUAL_PARAMETERS							0
+#define DEBUG_SECTION_HASH_FRICTION								0
+#define DEBUG_SECTION_EQUAL_FRICTION							0
 #define DEBUG_SECTION_BM										0
 #define DEBUG_SECTION_BL										0
 #define DEBUG_SECTION_BR										0
@@ -269,6 +348,14 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_SECTION_RHC										0
 #define DEBUG_SECTION_RI										0
 #define DEBUG_SECTION_OPEN_PARAMETERS							0
+#define DEBUG_SECTION_MEMO_OPEN									0
+#define DEBUG_SECTION_MEMO_CLOSE								0
+#define DEBUG_SECTION_MEMO_GET									0
+#define DEBUG_SECTION_MEMO_ADD									0
+#define DEBUG_SECTION_PAIR_MEMO_OPEN							0
+#define DEBUG_SECTION_PAIR_MEMO_CLOSE							0
+#define DEBUG_SECTION_PAIR_MEMO_GET								0
+#define DEBUG_SECTION_PAIR_MEMO_ADD								0
 #define DEBUG_SECTION_OPEN										0
 #define DEBUG_CHANNEL_SEGMENT_PRINT								0
 #define DEBUG_CHANNEL_SEGMENT_DELETE							0
@@ -285,6 +372,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_LIST_SECTION_GAUGE_TMAX							0
 #define DEBUG_LIST_SECTION_GAUGE_OPEN							0
 #define DEBUG_LIST_VARIABLE_SEGMENTS_OPEN						0
+#define DEBUG_SECTION_GEOMETRY_DELETE							0
+#define DEBUG_SECTION_VARIABLE_DELETE							0
+#define DEBUG_LIST_VARIABLE_SEGMENTS_DELETE						0
 #define DEBUG_PARAMETERS_PRINT									0
 #define DEBUG_MASS_START										0
 #define DEBUG_MASS_COPY											0
@@ -298,11 +388,19 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_MESH_HMIN											0
 #define DEBUG_MESH_ACTUALIZE									0
 #define DEBUG_INITIAL_VARIABLES_OPEN							0
+#define DEBUG_MESH_CACHE_KEY									0
+#define DEBUG_MESH_CACHE_CLOSE									0
+#define DEBUG_MESH_CACHE_OPEN									0
+#define DEBUG_MESH_CACHE_SECTION								0
+#define DEBUG_MESH_CACHE_SAVE									0
+#define DEBUG_MESH_PACK_SECTIONS								0
+#define DEBUG_MESH_THREAD_ARENAS_DELETE							0
 #define DEBUG_PART_OPEN											0
 #define DEBUG_PART_OPEN_EXIT									0
 #define DEBUG_SORT_INT											0
 #define DEBUG_SORT_INVERSE_INT									0
 #define DEBUG_SYSTEM_LIST										0
+#define DEBUG_MESH_PARTITION									0
 #define DEBUG_JUNCTION_DELETE									0
 #define DEBUG_JUNCTION_CREATE									0
 #define DEBUG_JUNCTION_ADD_PARAMETER							0
@@ -329,8 +427,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_CHANNEL_DRY_CORRECTION_EXIT						0
 #define DEBUG_SYSTEM_DRY_CORRECTION_PARALLEL					0
 #define DEBUG_SYSTEM_DRY_CORRECTION_SIMPLE						0
+#define DEBUG_CHANGE_SECTIONS_GEOMETRY							0
+#define DEBUG_CHANGE_SECTIONS_SEGMENT							0
 #define DEBUG_CHANGE_SECTIONS									0
-#define DEBUG_LIST_SECTION_GAUGE_STEP							0
+#define DEBUG_SECTION_GAUGE_SAMPLE								0
 #define DEBUG_DIFFUSION_PARAMETERS_EXPLICIT_EXPLICIT			0
 #define DEBUG_DIFFUSION_PARAMETERS_EXPLICIT_IMPLICIT			0
 #define DEBUG_DIFFUSION_PARAMETERS_IMPLICIT_EXPLICIT			0
@@ -351,6 +451,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_PART_PARAMETERS2									0
 #define DEBUG_PART_PARAMETERS2_EXIT								0
 #define DEBUG_BOUNDARY_FLOW_TMAX								0
+#define DEBUG_SYSTEM_SERIES_WINDOW								0
+#define DEBUG_SYSTEM_RESAMPLE									0
 #define DEBUG_SYSTEM_PARAMETERS2_PARALLEL						0
 #define DEBUG_SYSTEM_PARAMETERS2_SIMPLE							0
 #define DEBUG_FLOW_LINEARIZATION								0
@@ -376,6 +478,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_FLOW_IMPLICIT_FRICTION							0
 #define DEBUG_PART_SIMULATE_STEP								0
 #define DEBUG_PART_SIMULATE_STEP_EXIT							0
+#define DEBUG_SYSTEM_MASS_BOUNDARIES							0
 #define DEBUG_JUNCTION_FLOW_SCHEME								0
 #define DEBUG_SYSTEM_SIMULATE_STEP_PARALLEL						0
 #define DEBUG_SYSTEM_SIMULATE_STEP_SIMPLE						0
@@ -401,6 +504,32 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DEBUG_WRITE_PLUMES_CHANNEL								0
 #define DEBUG_WRITE_PLUMES										0
 #define DEBUG_WRITE_CONTRIBUTIONS								0
+#define DEBUG_WRITE_FILE_OPEN									0
+#define DEBUG_WRITE_FILE_OFFSET									0
+#define DEBUG_STREAM_PLUMES_HEADER								0
+#define DEBUG_STREAM_CONTRIBUTIONS_HEADER						0
+#define DEBUG_STREAM_PLUMES_RECORD								0
+#define DEBUG_STREAM_CONTRIBUTIONS_RECORD						0
+#define DEBUG_STREAM_OPEN										0
+#define DEBUG_STREAM_WRITE										0
+#define DEBUG_STREAM_CLOSE										0
+#define DEBUG_STREAM_CONVERT									0
+#define DEBUG_WRITE_OUTPUT_OPEN									0
+#define DEBUG_WRITE_OUTPUT										0
+#define DEBUG_WRITE_OUTPUT_CLOSE								0
+#define DEBUG_SAMPLER_OPEN										0
+#define DEBUG_SAMPLER_ADVANCE									0
+#define DEBUG_SAMPLER_WRITE										0
+#define DEBUG_SAMPLER_CLOSE										0
+#define DEBUG_CHECKPOINT_SAVE									0
+#define DEBUG_CHECKPOINT_LOAD									0
+#define DEBUG_STATUS_OPEN										0
+#define DEBUG_STATUS_WRITE										0
+#define DEBUG_STATUS_STEP										0
+#define DEBUG_CALIBRATION_OPEN									0
+#define DEBUG_CALIBRATION_START									0
+#define DEBUG_CALIBRATION_STEP									0
+#define DEBUG_CALIBRATION_ROLLBACK								0
 #define DEBUG_SIMULATE_STEADY									0
 #define DEBUG_SIMULATE_START									0
 #define DEBUG_SIMULATE											0
@@ -519,6 +648,21 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_SECTION_POINT2_OPEN								1
 /* editor channel */
 #define INLINE_SECTION_POINT_TRANSFORM							1
+#define INLINE_SERIES_CURSOR_RESET								1
+#define INLINE_SERIES_SEARCH									1
+#define INLINE_SERIES_INTERPOLATE								1
+#define INLINE_SERIES_INTEGRAL									0
+#define INLINE_SERIES_FILE_INIT_EMPTY							1
+#define INLINE_SERIES_FILE_DELETE								0
+#define INLINE_SERIES_FILE_COPY									0
+#define INLINE_SERIES_FILE_OPEN_XML								0
+#define INLINE_SERIES_FILE_SAVE_XML								0
+#define INLINE_SERIES_FILE_OPEN									0
+#define INLINE_SERIES_FILE_READ									0
+#define INLINE_SERIES_FILE_WINDOW								0
+#define INLINE_SERIES_GRID_INIT_EMPTY							1
+#define INLINE_SERIES_GRID_DELETE								0
+#define INLINE_SERIES_GRID_OPEN									0
 #define INLINE_TRANSIENT_SECTION_PRINT							1
 #define INLINE_TRANSIENT_SECTION_ERROR							0
 #define INLINE_TRANSIENT_SECTION_DELETE							0
@@ -558,6 +702,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_CROSS_SECTION_OPEN_XML							1
 #define INLINE_CROSS_SECTION_SAVE_XML							1
 #define INLINE_CROSS_SECTION_GET_TRANSIENT						0
+#define INLINE_CROSS_SECTION_CONTROL							0
 #define INLINE_CHANNEL_GEOMETRY_PRINT							1
 #define INLINE_CHANNEL_GEOMETRY_ERROR							0
 #define INLINE_CHANNEL_GEOMETRY_DELETE							0
@@ -589,6 +734,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_BOUNDARY_FLOW_PARAMETER2							0
 #define INLINE_BOUNDARY_FLOW_PARAMETER3							0
 #define INLINE_BOUNDARY_FLOW_INTEGRAL							0
+#define INLINE_BOUNDARY_FLOW_WINDOW								0
+#define INLINE_BOUNDARY_FLOW_RESAMPLE							0
 #define INLINE_BOUNDARY_TRANSPORT_ERROR							0
 #define INLINE_BOUNDARY_TRANSPORT_DELETE						0
 #define INLINE_BOUNDARY_TRANSPORT_INIT_EMPTY					0
@@ -596,6 +743,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_BOUNDARY_TRANSPORT_OPEN_XML						1
 #define INLINE_BOUNDARY_TRANSPORT_SAVE_XML						1
 #define INLINE_BOUNDARY_TRANSPORT_PARAMETER						0
+#define INLINE_BOUNDARY_TRANSPORT_WINDOW						0
+#define INLINE_BOUNDARY_TRANSPORT_RESAMPLE						0
 #define INLINE_TRANSPORT_PRINT									1
 #define INLINE_TRANSPORT_ERROR									0
 #define INLINE_TRANSPORT_DELETE									0
@@ -604,6 +753,54 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_TRANSPORT_COPY									1
 #define INLINE_TRANSPORT_OPEN_XML								1
 #define INLINE_TRANSPORT_SAVE_XML								1
+#define INLINE_OUTPUT_PRINT										1
+#define INLINE_OUTPUT_ERROR										0
+#define INLINE_OUTPUT_DELETE									0
+#define INLINE_OUTPUT_INIT_EMPTY								0
+#define INLINE_OUTPUT_COPY										1
+#define INLINE_OUTPUT_VARIABLE									0
+#define INLINE_OUTPUT_VARIABLE_NAME								0
+#define INLINE_OUTPUT_OPEN_XML									1
+#define INLINE_OUTPUT_SAVE_XML									1
+#define INLINE_PROFILE_OPEN										0
+#define INLINE_PROFILE_COUNTER_OPEN								0
+#define INLINE_PROFILE_COUNTERS_READ							1
+#define INLINE_PROFILE_COUNTERS_CLOSE							1
+#define INLINE_PROFILE_COUNTERS_OPEN							0
+#define INLINE_PROFILE_COUNTERS_LAP								0
+#define INLINE_PROFILE_ADD										1
+#define INLINE_PROFILE_LAP										1
+#define INLINE_PROFILE_START									1
+#define INLINE_PROFILE_THREAD_ADD								1
+#define INLINE_PROFILE_IMBALANCE								0
+#define INLINE_PROFILE_PRINT									0
+#define INLINE_PROFILE_SAVE										0
+#define INLINE_PROFILE_CLOSE									0
+#define INLINE_LIMITER_OPEN										0
+#define INLINE_LIMITER_SET										1
+#define INLINE_LIMITER_UPDATE									1
+#define INLINE_LIMITER_CELL										0
+#define INLINE_LIMITER_FRICTION									0
+#define INLINE_LIMITER_STEP										1
+#define INLINE_LIMITER_RANK										0
+#define INLINE_LIMITER_EVENT_PRINT								0
+#define INLINE_LIMITER_PRINT									0
+#define INLINE_LIMITER_SAVE										0
+#define INLINE_LIMITER_CLOSE									0
+#define INLINE_EVENT_QUEUE_INIT_EMPTY							1
+#define INLINE_EVENT_QUEUE_DELETE								0
+#define INLINE_EVENT_QUEUE_PUSH									1
+#define INLINE_EVENT_QUEUE_POP									1
+#define INLINE_EVENT_QUEUE_SECTION_CHANGES						1
+#define INLINE_EVENT_QUEUE_SECTION_GAUGE						1
+#define INLINE_EVENT_QUEUE_OPEN									0
+#define INLINE_EVENT_QUEUE_OPEN_OUTPUTS							0
+#define INLINE_EVENT_QUEUE_STEP									1
+#define INLINE_EVENT_QUEUE_TMAX									1
+#define INLINE_MEMORY_OPEN										1
+#define INLINE_MEMORY_ACCOUNT									0
+#define INLINE_MEMORY_RSS										1
+#define INLINE_MEMORY_PRINT										0
 #define INLINE_CHANNEL_TRANSPORT_PRINT							1
 #define INLINE_CHANNEL_TRANSPORT_ERROR							0
 #define INLINE_CHANNEL_TRANSPORT_DELETE							0
@@ -640,6 +837,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_SYSTEM_CREATE									1
 #define INLINE_SYSTEM_COPY										1
 #define INLINE_SYSTEM_JUNCTIONS_SET_UP							1
+#define INLINE_SYSTEM_OUTPUTS_SET_UP							1
 #define INLINE_SYSTEM_OPEN_XML									1
 #define INLINE_SYSTEM_SAVE_XML									1
 #define INLINE_WAVE_VELOCITY									0
@@ -660,15 +858,27 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_SECTION_CRITICAL_DISCHARGE						0
 #define INLINE_SECTION_CRITICAL_FUNCTION						0
 #define INLINE_SECTION_CRITICAL_AREA							1
+#define INLINE_SECTION_ARENA_INIT_EMPTY							1
+#define INLINE_SECTION_ARENA_DELETE								0
+#define INLINE_SECTION_ARENA_ALLOC								1
+#define INLINE_SECTION_RELEASE									1
 #define INLINE_SECTION_DELETE									0
 #define INLINE_SECTION_CREATE									0
 #define INLINE_SECTION_COPY										0
+#define INLINE_SECTION_SHARE									0
+#define INLINE_SECTION_LINK										0
+#define INLINE_SECTION_HASH_ADD									1
+#define INLINE_SECTION_HASH_PARAMETERS							0
+#define INLINE_SECTION_EQUAL_PARAMETERS							0
+#define INLINE_SECTION_HASH_FRICTION							0
+#define INLINE_SECTION_EQUAL_FRICTION							0
 #define INLINE_SECTION_BM										0
 #define INLINE_SECTION_BL										1
 #define INLINE_SECTION_BR										1
 #define INLINE_SECTION_BC										1
 #define INLINE_SECTION_B										0
 #define INLINE_SECTION_P										1
+#define INLINE_SECTION_POW6										1
 #define INLINE_SECTION_RHPA										0
 #define INLINE_SECTION_RHPB										0
 #define INLINE_SECTION_RHPC										1
@@ -680,6 +890,21 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_SECTION_RHC										0
 #define INLINE_SECTION_RI										1
 #define INLINE_SECTION_OPEN_PARAMETERS							0
+#define INLINE_SECTION_MEMO_HASH								0
+#define INLINE_SECTION_MEMO_EQUAL								0
+#define INLINE_SECTION_MEMO_FREE								0
+#define INLINE_SECTION_MEMO_OPEN								1
+#define INLINE_SECTION_MEMO_CLOSE								0
+#define INLINE_SECTION_MEMO_GET									0
+#define INLINE_SECTION_MEMO_ADD									0
+#define INLINE_SECTION_MEMO_KEY									1
+#define INLINE_SECTION_PAIR_MEMO_HASH							0
+#define INLINE_SECTION_PAIR_MEMO_EQUAL							0
+#define INLINE_SECTION_PAIR_MEMO_FREE							0
+#define INLINE_SECTION_PAIR_MEMO_OPEN							1
+#define INLINE_SECTION_PAIR_MEMO_CLOSE							0
+#define INLINE_SECTION_PAIR_MEMO_GET							0
+#define INLINE_SECTION_PAIR_MEMO_ADD							0
 #define INLINE_SECTION_OPEN										0
 #define INLINE_CHANNEL_SEGMENT_PRINT							1
 #define INLINE_CHANNEL_SEGMENT_DELETE							0
@@ -687,6 +912,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_CHANNEL_SEGMENT_OPEN								0
 #define INLINE_SECTION_CHANGES_PRINT							1
 #define INLINE_SECTION_CHANGES_TMAX								1
+#define INLINE_SECTION_CHANGES_NEXT								1
 #define INLINE_LIST_SECTION_CHANGES_PRINT						1
 #define INLINE_LIST_SECTION_CHANGES_TMAX						0
 #define INLINE_LIST_SECTION_CHANGES_OPEN						1
@@ -696,6 +922,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_LIST_SECTION_GAUGE_TMAX							0
 #define INLINE_LIST_SECTION_GAUGE_OPEN							1
 #define INLINE_LIST_VARIABLE_SEGMENTS_OPEN						1
+#define INLINE_LIST_SECTION_GAUGE_LINK							0
+#define INLINE_LIST_SECTION_CHANGES_LINK						0
+#define INLINE_SECTION_GEOMETRY_DELETE							0
+#define INLINE_SECTION_VARIABLE_DELETE							1
+#define INLINE_LIST_VARIABLE_SEGMENTS_DELETE					0
 #define INLINE_PARAMETERS_PRINT									1
 #define INLINE_MASS_START										0
 #define INLINE_MASS_COPY										1
@@ -709,11 +940,20 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_MESH_HMIN										0
 #define INLINE_MESH_ACTUALIZE									1
 #define INLINE_INITIAL_VARIABLES_OPEN							1
+#define INLINE_MESH_CACHE_KEY_ADD								1
+#define INLINE_MESH_CACHE_KEY									0
+#define INLINE_MESH_CACHE_CLOSE									1
+#define INLINE_MESH_CACHE_OPEN									0
+#define INLINE_MESH_CACHE_SECTION								1
+#define INLINE_MESH_CACHE_SAVE									0
+#define INLINE_MESH_PACK_SECTIONS								0
+#define INLINE_MESH_THREAD_ARENAS_DELETE						1
 #define INLINE_PART_OPEN										0
 #define INLINE_PART_OPEN_EXIT									0
 #define INLINE_SORT_INT											1
 #define INLINE_SORT_INVERSE_INT									1
 #define INLINE_SYSTEM_LIST										1
+#define INLINE_MESH_PARTITION									1
 #define INLINE_JUNCTION_PRINT									1
 #define INLINE_JUNCTION_DELETE									0
 #define INLINE_JUNCTION_CREATE									0
@@ -741,8 +981,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_CHANNEL_DRY_CORRECTION_EXIT						0
 #define INLINE_SYSTEM_DRY_CORRECTION_PARALLEL					1
 #define INLINE_SYSTEM_DRY_CORRECTION_SIMPLE						1
+#define INLINE_CHANGE_SECTIONS_GEOMETRY							0
+#define INLINE_CHANGE_SECTIONS_SEGMENT							1
 #define INLINE_CHANGE_SECTIONS									1
-#define INLINE_LIST_SECTION_GAUGE_STEP							0
+#define INLINE_SECTION_GAUGE_SAMPLE								1
 #define INLINE_DIFFUSION_PARAMETERS_EXPLICIT_EXPLICIT			0
 #define INLINE_DIFFUSION_PARAMETERS_EXPLICIT_IMPLICIT			0
 #define INLINE_DIFFUSION_PARAMETERS_IMPLICIT_EXPLICIT			0
@@ -763,6 +1005,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_PART_PARAMETERS2									0
 #define INLINE_PART_PARAMETERS2_EXIT							0
 #define INLINE_BOUNDARY_FLOW_TMAX								0
+#define INLINE_SYSTEM_SERIES_WINDOW								1
+#define INLINE_SYSTEM_RESAMPLE									0
 #define INLINE_SYSTEM_PARAMETERS2_PARALLEL						0
 #define INLINE_SYSTEM_PARAMETERS2_SIMPLE						0
 #define INLINE_FLOW_LINEARIZATION								1
@@ -789,6 +1033,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_PART_SIMULATE_STEP								0
 #define INLINE_JUNCTION_FLOW_SCHEME								0
 #define INLINE_PART_SIMULATE_STEP_EXIT							0
+#define INLINE_SYSTEM_MASS_BOUNDARIES							1
 #define INLINE_SYSTEM_SIMULATE_STEP_PARALLEL					0
 #define INLINE_SYSTEM_SIMULATE_STEP_SIMPLE						0
 #define INLINE_PART_SIMULATE_STEP2								0
@@ -813,6 +1058,34 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INLINE_WRITE_PLUMES_CHANNEL								0
 #define INLINE_WRITE_PLUMES										0
 #define INLINE_WRITE_CONTRIBUTIONS								0
+#define INLINE_WRITE_FILE_OPEN									0
+#define INLINE_WRITE_FILE_OFFSET								0
+#define INLINE_STREAM_PLUMES_HEADER								0
+#define INLINE_STREAM_CONTRIBUTIONS_HEADER						0
+#define INLINE_STREAM_PLUMES_RECORD								1
+#define INLINE_STREAM_CONTRIBUTIONS_RECORD						1
+#define INLINE_STREAM_OPEN										0
+#define INLINE_STREAM_WRITE										0
+#define INLINE_STREAM_CLOSE										0
+#define INLINE_STREAM_CONVERT									0
+#define INLINE_WRITE_OUTPUT_OPEN								0
+#define INLINE_WRITE_OUTPUT										0
+#define INLINE_WRITE_OUTPUT_CLOSE								0
+#define INLINE_SAMPLER_OPEN										0
+#define INLINE_SAMPLER_ADVANCE									1
+#define INLINE_SAMPLER_WRITE									0
+#define INLINE_SAMPLER_CLOSE									0
+#define INLINE_CHECKPOINT_SAVE									0
+#define INLINE_CHECKPOINT_LOAD									0
+#define INLINE_STATUS_OPEN										1
+#define INLINE_STATUS_WRITE										0
+#define INLINE_STATUS_STEP										1
+#define INLINE_CALIBRATION_INIT_EMPTY							1
+#define INLINE_CALIBRATION_DELETE								1
+#define INLINE_CALIBRATION_OPEN									0
+#define INLINE_CALIBRATION_START								0
+#define INLINE_CALIBRATION_STEP									0
+#define INLINE_CALIBRATION_ROLLBACK								0
 #define INLINE_SIMULATE_STEADY									1
 #define INLINE_SIMULATE_START									0
 #define INLINE_SIMULATE											0
@@ -828,17 +1101,26 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define XML_ADVANCES			(const xmlChar*)"advances"
 #define XML_ANGLE				(const xmlChar*)"angle"
+#define XML_AVERAGE				(const xmlChar*)"average"
+#define XML_BINARY				(const xmlChar*)"binary"
 #define XML_BOUNDARY_FLOW		(const xmlChar*)"boundary"
 #define XML_BOUNDARY_TRANSPORT	(const xmlChar*)"boundary"
+#define XML_CALIBRATION			(const xmlChar*)"calibration"
+#define XML_CALIBRATION_ITERATIONS	(const xmlChar*)"calibration_iterations"
 #define XML_CELL_SIZE	 		(const xmlChar*)"cell_size"
 #define XML_CFL			 		(const xmlChar*)"cfl"
 #define XML_CHANNEL				(const xmlChar*)"channel"
 #define XML_CHANNEL_GEOMETRY	(const xmlChar*)"geometry"
 #define XML_CHANNEL_TRANSPORT	(const xmlChar*)"transport"
+#define XML_CHECKPOINT			(const xmlChar*)"checkpoint"
+#define XML_CHECKPOINT_INTERVAL	(const xmlChar*)"checkpoint_interval"
+#define XML_CLIP				(const xmlChar*)"clip"
 #define XML_CONTRACTION 		(const xmlChar*)"contraction"
 #define XML_CONTRIBUTIONS 		(const xmlChar*)"contributions"
 #define XML_CONTROL		 		(const xmlChar*)"control"
+#define XML_COUNTERS			(const xmlChar*)"counters"
 #define XML_CROSS_SECTION		(const xmlChar*)"cross_section"
+#define XML_CSV					(const xmlChar*)"csv"
 #define XML_DAM 		 		(const xmlChar*)"dam"
 #define XML_DANGER 		 		(const xmlChar*)"danger"
 #define XML_DELAY				(const xmlChar*)"delay"
@@ -848,8 +1130,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define XML_DRY					(const xmlChar*)"dry"
 #define XML_DZ					(const xmlChar*)"dz"
 #define XML_EVOLUTION		 	(const xmlChar*)"evolution"
+#define XML_FILE				(const xmlChar*)"file"
 #define XML_FINAL				(const xmlChar*)"final"
 #define XML_FINAL_TIME			(const xmlChar*)"final_time"
+#define XML_FORMAT				(const xmlChar*)"format"
 //#define XML_FRONTAL                           (const xmlChar*)"frontal"
 #define XML_GATE				(const xmlChar*)"gate"
 #define XML_GAUGE		 		(const xmlChar*)"gauge"
@@ -869,21 +1153,30 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define XML_INITIAL_TRANSPORT	(const xmlChar*)"initial"
 #define XML_INLET_FLOW			(const xmlChar*)"inlet"
 #define XML_INNER_FLOW			(const xmlChar*)"boundary"
+#define XML_INTEGRAL			(const xmlChar*)"integral"
+#define XML_INTERPOLATE			(const xmlChar*)"interpolate"
+#define XML_INTERVAL			(const xmlChar*)"interval"
 #define XML_JUNCTION			(const xmlChar*)"junction"
 #define XML_LEVEL  				(const xmlChar*)"level"
+#define XML_LIMITER				(const xmlChar*)"limiter"
 //#define XML_PARALLEL                  (const xmlChar*)"parallel"
 #define XML_M					(const xmlChar*)"m"
 #define XML_MASS				(const xmlChar*)"mass"
 #define XML_MAX_STEADY_TIME		(const xmlChar*)"max_steady_time"
 #define XML_MEASURED_TIME 		(const xmlChar*)"measured_time"
+#define XML_MESH_CACHE			(const xmlChar*)"mesh_cache"
 #define XML_NAME				(const xmlChar*)"name"
 #define XML_OBSERVATION_TIME	(const xmlChar*)"observation_time"
 #define XML_OUTLET_FLOW			(const xmlChar*)"outlet"
+#define XML_OUTPUT				(const xmlChar*)"output"
+#define XML_OUTPUT_MODE			(const xmlChar*)"output_mode"
 #define XML_PARAMETERS			(const xmlChar*)"parameters"
 #define XML_PIPE				(const xmlChar*)"pipe"
 #define XML_PLUMES				(const xmlChar*)"plumes"
 #define XML_POLILYNE			(const xmlChar*)"polilyne"
 #define XML_PROFILE				(const xmlChar*)"profile"
+#define XML_PROFILING			(const xmlChar*)"profiling"
+#define XML_PROPORTIONAL		(const xmlChar*)"proportional"
 #define XML_Q			 		(const xmlChar*)"q"
 #define XML_Q_H 		 		(const xmlChar*)"q_h"
 #define XML_Q_Z 		 		(const xmlChar*)"q_z"
@@ -893,7 +1186,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define XML_QT_HT		 		(const xmlChar*)"qt_ht"
 #define XML_QT_ZT		 		(const xmlChar*)"qt_zt"
 #define XML_QZ  		 		(const xmlChar*)"qz"
+#define XML_RESAMPLE_INTERVAL	(const xmlChar*)"resample_interval"
 #define XML_ROUGHNESS			(const xmlChar*)"roughness"
+#define XML_SAMPLES				(const xmlChar*)"samples"
+#define XML_SAVE_SOLUTION		(const xmlChar*)"save_solution"
 #define XML_SECTION	 			(const xmlChar*)"section"
 #define XML_SECTION_WIDTH_MIN	(const xmlChar*)"section_width_min"
 //#define XML_SECTION_POINT             (const xmlChar*)"section_point"
@@ -902,16 +1198,23 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define XML_SOLUBILITY			(const xmlChar*)"solubility"
 #define XML_SOLUTION			(const xmlChar*)"solution"
 #define XML_SOLUTION_FILE		(const xmlChar*)"solution_file"
+#define XML_STATUS				(const xmlChar*)"status"
+#define XML_STATUS_INTERVAL		(const xmlChar*)"status_interval"
 #define XML_STEADY				(const xmlChar*)"steady"
 #define XML_STEADY_ERROR		(const xmlChar*)"steady_error"
 #define XML_STRAIGHT			(const xmlChar*)"straight"
+#define XML_STREAMS_FORMAT		(const xmlChar*)"streams_format"
+#define XML_STREAMS_INTERVAL	(const xmlChar*)"streams_interval"
+#define XML_STREAMS_STEP		(const xmlChar*)"streams_step"
 #define XML_SUPERCRITICAL		(const xmlChar*)"supercritical"
 #define XML_SYSTEM	 			(const xmlChar*)"system"
+#define XML_TEXT				(const xmlChar*)"text"
 #define XML_TIME 				(const xmlChar*)"time"
 #define XML_TOLERANCE			(const xmlChar*)"tolerance"
 #define XML_TRANSIENT_SECTION 	(const xmlChar*)"transient_section"
 #define XML_TRANSPORT			(const xmlChar*)"transport"
 #define XML_TYPE				(const xmlChar*)"type"
+#define XML_VARIABLES			(const xmlChar*)"variables"
 #define XML_VELOCITY			(const xmlChar*)"velocity"
 #define XML_WIDTH				(const xmlChar*)"width"
 #define XML_X					(const xmlChar*)"x"
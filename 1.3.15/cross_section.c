@@ -268,3 +268,22 @@ cross_section_get_transient (CrossSection * cs, JBDOUBLE t)
   return _cross_section_get_transient (cs, t);
 }
 #endif
+
+/**
+ * \fn int cross_section_control(CrossSection *cs)
+ * \brief Function to actuate the control of a cross section with the mean of
+ *   the sampled control parameter. Without gains the transient section moves
+ *   one position if the error exceeds the tolerance; with gains the position
+ *   is moved by an incremental proportional-integral law on every evaluation
+ *   and the gate follows it only if the error exceeds the tolerance.
+ * \param cs
+ * \brief CrossSection structure.
+ * \return 1 if the transient section changes, 0 otherwise.
+ */
+#if !INLINE_CROSS_SECTION_CONTROL
+int
+cross_section_control (CrossSection * cs)
+{
+  return _cross_section_control (cs);
+}
+#endif
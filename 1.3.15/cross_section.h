@@ -87,6 +87,9 @@ typedef struct
  * \brief number of current transient section.
  * \var nt
  * \brief number of times that the control parameter has been obtained.
+ * \var samples
+ * \brief number of samples of the control parameter in the time of
+ *   integration.
  * \var x
  * \brief position x-coordinate.
  * \var y
@@ -98,11 +101,21 @@ typedef struct
  * \var time
  * \brief time of integration of control variable.
  * \var tolerance
- * \brief tolerance to control requirements.
+ * \brief tolerance to control requirements (deadband of the gate moves).
  * \var tmax
  * \brief time when the control will actuate.
  * \var pt
  * \brief integrated parameter at the control.
+ * \var proportional
+ * \brief proportional gain of the control (transient sections per unit of
+ *   parameter).
+ * \var integral
+ * \brief integral gain of the control (transient sections per unit of
+ *   parameter and second).
+ * \var position
+ * \brief continuous position of the control in transient sections.
+ * \var error
+ * \brief last error of the control parameter.
  * \var ts
  * \brief transient sections array.
  * \var name
@@ -112,8 +125,9 @@ typedef struct
  * \var section
  * \brief cross section name of the control point.
  */
-  int n, type, control, control_channel, control_section, i, j, nt;
-  JBFLOAT x, y, angle, parameter, time, tolerance, tmax, pt;
+  int n, type, control, control_channel, control_section, i, j, nt, samples;
+  JBFLOAT x, y, angle, parameter, time, tolerance, tmax, pt, proportional,
+    integral, position, error;
   TransientSection *ts;
   char *name, *channel, *section;
 } CrossSection;
@@ -130,9 +144,14 @@ _cross_section_print (CrossSection * cs, FILE * file)
   fprintf (file, "x=" FWF " y=" FWF " angle=" FWF "\n", cs->x, cs->y,
            cs->angle);
   if (cs->type != CROSS_SECTION_TYPE_TIME)
-    fprintf (file,
-             "control=%d parameter=" FWF " time=" FWF " tolerance=" FWF "\n",
-             cs->control, cs->parameter, cs->time, cs->tolerance);
+    {
+      fprintf (file,
+               "control=%d parameter=" FWF " time=" FWF " tolerance=" FWF
+               "\n", cs->control, cs->parameter, cs->time, cs->tolerance);
+      fprintf (file,
+               "samples=%d proportional=" FWF " integral=" FWF "\n",
+               cs->samples, cs->proportional, cs->integral);
+    }
   for (i = 0; i <= cs->n; ++i)
     transient_section_print (cs->ts + i, file);
   fprintf (file, "cross_section_print: end\n");
@@ -616,11 +635,15 @@ _cross_section_open_xml (CrossSection * cs, xmlNode * node)
           goto exit0;
         }
       cs->time = jb_xml_node_get_float_with_default (node, XML_TIME, &j, 0.);
-      if (j != 1)
+      if (j != 1 || cs->time < 0.)
         {
           cross_section_error (cs, gettext ("Bad integration time"));
           goto exit0;
         }
+      // a null time controlled at every time step in previous versions, but
+      // the controls are now sampled at discrete times
+      if (cs->time == 0.)
+        cs->time = CONTROL_TIME;
       cs->tolerance =
         jb_xml_node_get_float_with_default (node, XML_TOLERANCE, &j, 0.);
       if (j != 1)
@@ -628,6 +651,30 @@ _cross_section_open_xml (CrossSection * cs, xmlNode * node)
           cross_section_error (cs, gettext ("Bad tolerance"));
           goto exit0;
         }
+      cs->samples = 1;
+      if (xmlHasProp (node, XML_SAMPLES))
+        {
+          cs->samples = jb_xml_node_get_int (node, XML_SAMPLES, &j);
+          if (j != 1 || cs->samples < 1)
+            {
+              cross_section_error (cs, gettext ("Bad samples number"));
+              goto exit0;
+            }
+        }
+      cs->proportional =
+        jb_xml_node_get_float_with_default (node, XML_PROPORTIONAL, &j, 0.);
+      if (j != 1)
+        {
+          cross_section_error (cs, gettext ("Bad proportional gain"));
+          goto exit0;
+        }
+      cs->integral =
+        jb_xml_node_get_float_with_default (node, XML_INTEGRAL, &j, 0.);
+      if (j != 1)
+        {
+          cross_section_error (cs, gettext ("Bad integral gain"));
+          goto exit0;
+        }
     }
 
   for (j = 0, node = node->children; node; ++j, node = node->next)
@@ -683,6 +730,7 @@ static inline void
 _cross_section_save_xml (CrossSection * cs, xmlNode * node)
 {
   int i;
+  char buffer[32];
   xmlNode *child;
   const xmlChar *str[] = { XML_DISCHARGE, XML_DEPTH, XML_LEVEL };
 
@@ -703,6 +751,15 @@ _cross_section_save_xml (CrossSection * cs, xmlNode * node)
       jb_xml_node_set_float_with_default (node, XML_TIME, cs->time, 0.);
       jb_xml_node_set_float_with_default
         (node, XML_TOLERANCE, cs->tolerance, 0.);
+      if (cs->samples != 1)
+        {
+          snprintf (buffer, 32, "%d", cs->samples);
+          xmlSetProp (node, XML_SAMPLES, (const xmlChar *) buffer);
+        }
+      jb_xml_node_set_float_with_default
+        (node, XML_PROPORTIONAL, cs->proportional, 0.);
+      jb_xml_node_set_float_with_default
+        (node, XML_INTEGRAL, cs->integral, 0.);
       if (cs->parameter != 0.)
         switch (cs->type)
           {
@@ -736,7 +793,6 @@ static inline TransientSection *
 _cross_section_get_transient (CrossSection * cs, JBDOUBLE t)
 {
   register int i;
-  register JBDOUBLE k;
 #if DEBUG_CROSS_SECTION_GET_TRANSIENT
   fprintf (stderr, "cross_section_get_transient: start\n");
 #endif
@@ -746,38 +802,9 @@ _cross_section_get_transient (CrossSection * cs, JBDOUBLE t)
         (t, &cs->ts->t, sizeof (TransientSection), cs->n);
       if (i < 0)
         i = 0;
-#if DEBUG_CROSS_SECTION_GET_TRANSIENT
-      fprintf (stderr, "CSGT i=%d\n", i);
-#endif
     }
   else
-    {
-      if (t >= cs->tmax)
-        {
-          cs->tmax = t + cs->time;
-          k = cs->pt / cs->nt - cs->parameter;
-#if DEBUG_CROSS_SECTION_GET_TRANSIENT
-          fprintf (stderr, "CSGT j=%d\n", cs->j);
-#endif
-          if (k > cs->tolerance)
-            {
-              if (cs->j < cs->n)
-                ++cs->j;
-            }
-          else if (-k > cs->tolerance)
-            {
-              if (cs->j > 0)
-                --cs->j;
-            }
-#if DEBUG_CROSS_SECTION_GET_TRANSIENT
-          fprintf (stderr, "CSGT j=%d pt=" FWF " p=" FWF " tol=" FWF "\n",
-                   cs->j, cs->pt / cs->nt, cs->parameter, cs->tolerance);
-#endif
-          cs->nt = 0;
-          cs->pt = 0.;
-        }
-      i = cs->j;
-    }
+    i = cs->j;
 #if DEBUG_CROSS_SECTION_GET_TRANSIENT
   fprintf (stderr, "CSGT i=%d\n", i);
   transient_section_print (cs->ts + i, stderr);
@@ -792,4 +819,57 @@ _cross_section_get_transient (CrossSection * cs, JBDOUBLE t)
 TransientSection *cross_section_get_transient (CrossSection *, JBDOUBLE);
 #endif
 
+static inline int
+_cross_section_control (CrossSection * cs)
+{
+  register int j;
+  register JBDOUBLE k;
+#if DEBUG_CROSS_SECTION_CONTROL
+  fprintf (stderr, "cross_section_control: start\n");
+  fprintf (stderr, "CSC j=%d pt=" FWF " p=" FWF " tol=" FWF "\n",
+           cs->j, cs->pt / cs->nt, cs->parameter, cs->tolerance);
+#endif
+  j = cs->j;
+  k = cs->pt / cs->nt - cs->parameter;
+  if (cs->proportional == 0. && cs->integral == 0.)
+    {
+      if (k > cs->tolerance)
+        {
+          if (j < cs->n)
+            ++j;
+        }
+      else if (-k > cs->tolerance)
+        {
+          if (j > 0)
+            --j;
+        }
+    }
+  else
+    {
+      cs->position += cs->proportional * (k - cs->error)
+        + cs->integral * k * cs->time;
+      cs->position = fmax (0., fmin (cs->position, cs->n));
+      cs->error = k;
+      // deadband: errors within the tolerance do not move the gate
+      if (fabs (k) > cs->tolerance)
+        j = (int) rint (cs->position);
+    }
+  cs->nt = 0;
+  cs->pt = 0.;
+#if DEBUG_CROSS_SECTION_CONTROL
+  fprintf (stderr, "CSC j=%d position=" FWF "\n", j, cs->position);
+  fprintf (stderr, "cross_section_control: end\n");
+#endif
+  if (j == cs->j)
+    return 0;
+  cs->j = j;
+  return 1;
+}
+
+#if INLINE_CROSS_SECTION_CONTROL
+#define cross_section_control _cross_section_control
+#else
+int cross_section_control (CrossSection *);
+#endif
+
 #endif
@@ -0,0 +1,219 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file event_queue.c
+ * \brief Source file to define the queue of the discrete time events.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "event_queue.h"
+
+/**
+ * \fn void event_queue_init_empty(EventQueue *eq)
+ * \brief Function to init an empty events queue.
+ * \param eq
+ * \brief events queue.
+ */
+#if !INLINE_EVENT_QUEUE_INIT_EMPTY
+void
+event_queue_init_empty (EventQueue * eq)
+{
+  _event_queue_init_empty (eq);
+}
+#endif
+
+/**
+ * \fn void event_queue_delete(EventQueue *eq)
+ * \brief Function to free the memory used by an events queue.
+ * \param eq
+ * \brief events queue.
+ */
+#if !INLINE_EVENT_QUEUE_DELETE
+void
+event_queue_delete (EventQueue * eq)
+{
+  _event_queue_delete (eq);
+}
+#endif
+
+/**
+ * \fn int event_queue_push(EventQueue *eq, JBDOUBLE t, int type, \
+ *   int channel, int index, void *data)
+ * \brief Function to add an event to an events queue.
+ * \param eq
+ * \brief events queue.
+ * \param t
+ * \brief time of the event.
+ * \param type
+ * \brief type of the event.
+ * \param channel
+ * \brief channel number or -1.
+ * \param index
+ * \brief output number or -1.
+ * \param data
+ * \brief pointer to the data of the event.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_PUSH
+int
+event_queue_push (EventQueue * eq, JBDOUBLE t, int type, int channel,
+                  int index, void *data)
+{
+  return _event_queue_push (eq, t, type, channel, index, data);
+}
+#endif
+
+/**
+ * \fn void event_queue_pop(EventQueue *eq)
+ * \brief Function to remove the first event of a not empty events queue.
+ * \param eq
+ * \brief events queue.
+ */
+#if !INLINE_EVENT_QUEUE_POP
+void
+event_queue_pop (EventQueue * eq)
+{
+  _event_queue_pop (eq);
+}
+#endif
+
+/**
+ * \fn int event_queue_section_changes(EventQueue *eq, SectionChanges *sc, \
+ *   int channel)
+ * \brief Function to add the next transient section change of a cross section
+ *   to an events queue.
+ * \param eq
+ * \brief events queue.
+ * \param sc
+ * \brief section changes.
+ * \param channel
+ * \brief channel number.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_SECTION_CHANGES
+int
+event_queue_section_changes (EventQueue * eq, SectionChanges * sc,
+                             int channel)
+{
+  return _event_queue_section_changes (eq, sc, channel);
+}
+#endif
+
+/**
+ * \fn int event_queue_section_gauge(EventQueue *eq, SectionGauge *sg, \
+ *   int channel)
+ * \brief Function to add the next sample time of a section gauge to an
+ *   events queue.
+ * \param eq
+ * \brief events queue.
+ * \param sg
+ * \brief section gauge.
+ * \param channel
+ * \brief channel number.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_SECTION_GAUGE
+int
+event_queue_section_gauge (EventQueue * eq, SectionGauge * sg, int channel)
+{
+  return _event_queue_section_gauge (eq, sg, channel);
+}
+#endif
+
+/**
+ * \fn int event_queue_open(EventQueue *eq, System *s)
+ * \brief Function to fill an events queue with the next section changes and
+ *   section gauge samples of a system, starting the controls not started and
+ *   setting the sections of the actual times and control positions.
+ * \param eq
+ * \brief events queue.
+ * \param s
+ * \brief system of channels.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_OPEN
+int
+event_queue_open (EventQueue * eq, System * s)
+{
+  return _event_queue_open (eq, s);
+}
+#endif
+
+/**
+ * \fn int event_queue_open_outputs(EventQueue *eq, System *s)
+ * \brief Function to fill an events queue with the next output times of a
+ *   system.
+ * \param eq
+ * \brief events queue.
+ * \param s
+ * \brief system of channels.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_OPEN_OUTPUTS
+int
+event_queue_open_outputs (EventQueue * eq, System * s)
+{
+  return _event_queue_open_outputs (eq, s);
+}
+#endif
+
+/**
+ * \fn int event_queue_step(EventQueue *eq)
+ * \brief Function to dispatch the past section changes and section gauge
+ *   samples of an events queue scheduling the next ones. The sections of the
+ *   past section changes are changed at once and the sections of the actuated
+ *   controls after evaluating all the controls.
+ * \param eq
+ * \brief events queue.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_EVENT_QUEUE_STEP
+int
+event_queue_step (EventQueue * eq)
+{
+  return _event_queue_step (eq);
+}
+#endif
+
+/**
+ * \fn void event_queue_tmax(EventQueue *eq)
+ * \brief Function to limit the next time by the first event of an events
+ *   queue.
+ * \param eq
+ * \brief events queue.
+ */
+#if !INLINE_EVENT_QUEUE_TMAX
+void
+event_queue_tmax (EventQueue * eq)
+{
+  _event_queue_tmax (eq);
+}
+#endif
@@ -0,0 +1,375 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file event_queue.h
+ * \brief Header file to define the queue of the discrete time events.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef EVENT_QUEUE__H
+#define EVENT_QUEUE__H 1
+
+#include "parameters.h"
+#include "limiter.h"
+
+/**
+ * \struct TimeEvent
+ * \brief Structure to define a future discrete time event of the simulation.
+ */
+typedef struct
+{
+/**
+ * \var t
+ * \brief time of the event.
+ * \var type
+ * \brief type of the event as the type of the time step size limit.
+ * \var channel
+ * \brief channel number or -1.
+ * \var index
+ * \brief output number or -1.
+ * \var data
+ * \brief pointer to the section changes or to the section gauge or NULL.
+ */
+  JBDOUBLE t;
+  int type, channel, index;
+  void *data;
+} TimeEvent;
+
+/**
+ * \struct EventQueue
+ * \brief Structure to define a binary min-heap of the future discrete time
+ *   events bounding the time steps.
+ */
+typedef struct
+{
+/**
+ * \var event
+ * \brief array of events ordered as a heap with the first event in the first
+ *   position.
+ * \var n
+ * \brief number of events.
+ * \var nmax
+ * \brief allocated number of events.
+ */
+  TimeEvent *event;
+  int n, nmax;
+} EventQueue;
+
+extern EventQueue event_queue[1];
+
+static inline void
+_event_queue_init_empty (EventQueue * eq)
+{
+  eq->event = NULL;
+  eq->n = eq->nmax = 0;
+}
+
+#if INLINE_EVENT_QUEUE_INIT_EMPTY
+#define event_queue_init_empty _event_queue_init_empty
+#else
+void event_queue_init_empty (EventQueue *);
+#endif
+
+static inline void
+_event_queue_delete (EventQueue * eq)
+{
+  g_free (eq->event);
+  event_queue_init_empty (eq);
+}
+
+#if INLINE_EVENT_QUEUE_DELETE
+#define event_queue_delete _event_queue_delete
+#else
+void event_queue_delete (EventQueue *);
+#endif
+
+static inline int
+_event_queue_push (EventQueue * eq, JBDOUBLE t, int type, int channel,
+                   int index, void *data)
+{
+  int i, j;
+  TimeEvent *event;
+#if DEBUG_EVENT_QUEUE_PUSH
+  fprintf (stderr, "event_queue_push: start\n");
+  fprintf (stderr, "EQP t=" FWL " type=%d channel=%d index=%d n=%d\n",
+           t, type, channel, index, eq->n);
+#endif
+  if (eq->n == eq->nmax)
+    {
+      j = eq->nmax ? 2 * eq->nmax : 16;
+      event = (TimeEvent *) g_try_realloc (eq->event, j * sizeof (TimeEvent));
+      if (!event)
+        {
+          jbw_show_error2 (gettext ("Events queue"),
+                           gettext ("Not enough memory"));
+#if DEBUG_EVENT_QUEUE_PUSH
+          fprintf (stderr, "event_queue_push: end\n");
+#endif
+          return 0;
+        }
+      eq->event = event;
+      eq->nmax = j;
+    }
+  event = eq->event;
+  for (i = eq->n++; i > 0; i = j)
+    {
+      j = (i - 1) / 2;
+      if (event[j].t <= t)
+        break;
+      event[i] = event[j];
+    }
+  event[i].t = t;
+  event[i].type = type;
+  event[i].channel = channel;
+  event[i].index = index;
+  event[i].data = data;
+#if DEBUG_EVENT_QUEUE_PUSH
+  fprintf (stderr, "event_queue_push: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_EVENT_QUEUE_PUSH
+#define event_queue_push _event_queue_push
+#else
+int event_queue_push (EventQueue *, JBDOUBLE, int, int, int, void *);
+#endif
+
+static inline void
+_event_queue_pop (EventQueue * eq)
+{
+  int i, j;
+  TimeEvent *event, *last;
+  event = eq->event;
+  last = event + --eq->n;
+  for (i = 0; (j = 2 * i + 1) < eq->n; i = j)
+    {
+      if (j + 1 < eq->n && event[j + 1].t < event[j].t)
+        ++j;
+      if (last->t <= event[j].t)
+        break;
+      event[i] = event[j];
+    }
+  if (eq->n)
+    event[i] = *last;
+}
+
+#if INLINE_EVENT_QUEUE_POP
+#define event_queue_pop _event_queue_pop
+#else
+void event_queue_pop (EventQueue *);
+#endif
+
+static inline int
+_event_queue_section_changes (EventQueue * eq, SectionChanges * sc,
+                              int channel)
+{
+  JBDOUBLE ts;
+  ts = section_changes_next (sc);
+  if (ts < INFINITY)
+    return event_queue_push (eq, ts, LIMITER_TYPE_SECTION_CHANGES, channel, -1,
+                             sc);
+  return 1;
+}
+
+#if INLINE_EVENT_QUEUE_SECTION_CHANGES
+#define event_queue_section_changes _event_queue_section_changes
+#else
+int event_queue_section_changes (EventQueue *, SectionChanges *, int);
+#endif
+
+static inline int
+_event_queue_section_gauge (EventQueue * eq, SectionGauge * sg, int channel)
+{
+  if (sg->cs->tmax > t)
+    return event_queue_push (eq, sg->cs->tmax, LIMITER_TYPE_SECTION_GAUGE,
+                             channel, -1, sg);
+  return 1;
+}
+
+#if INLINE_EVENT_QUEUE_SECTION_GAUGE
+#define event_queue_section_gauge _event_queue_section_gauge
+#else
+int event_queue_section_gauge (EventQueue *, SectionGauge *, int);
+#endif
+
+static inline int
+_event_queue_open (EventQueue * eq, System * s)
+{
+  int i;
+  GSList *list;
+  Channel *channel;
+  SectionGauge *sg;
+#if DEBUG_EVENT_QUEUE_OPEN
+  fprintf (stderr, "event_queue_open: start\n");
+#endif
+  eq->n = 0;
+  for (i = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+    {
+      for (list = channel->list_section_changes; list; list = list->next)
+        if (!change_sections (p, ((SectionChanges *) list->data)->sv, t)
+            || !event_queue_section_changes
+            (eq, (SectionChanges *) list->data, i))
+          goto exit0;
+      for (list = channel->list_section_gauge; list; list = list->next)
+        {
+          sg = (SectionGauge *) list->data;
+          if (sg->cs->tmax < t)
+            {
+              sg->cs->tmax = t + sg->cs->time / sg->cs->samples;
+              sg->cs->nt = 0;
+              sg->cs->pt = 0.;
+            }
+          if (!change_sections (p, sg->sv, t)
+              || !event_queue_section_gauge (eq, sg, i))
+            goto exit0;
+        }
+    }
+#if DEBUG_EVENT_QUEUE_OPEN
+  fprintf (stderr, "EQO n=%d\n", eq->n);
+  fprintf (stderr, "event_queue_open: end\n");
+#endif
+  return 1;
+
+exit0:
+  event_queue_delete (eq);
+#if DEBUG_EVENT_QUEUE_OPEN
+  fprintf (stderr, "event_queue_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_EVENT_QUEUE_OPEN
+#define event_queue_open _event_queue_open
+#else
+int event_queue_open (EventQueue *, System *);
+#endif
+
+static inline int
+_event_queue_open_outputs (EventQueue * eq, System * s)
+{
+  int i;
+#if DEBUG_EVENT_QUEUE_OPEN_OUTPUTS
+  fprintf (stderr, "event_queue_open_outputs: start\n");
+#endif
+  eq->n = 0;
+  for (i = 0; i <= s->nout; ++i)
+    if (!event_queue_push
+        (eq, s->output[i].t, LIMITER_TYPE_OUTPUT, -1, i, s->output + i))
+      {
+        event_queue_delete (eq);
+#if DEBUG_EVENT_QUEUE_OPEN_OUTPUTS
+        fprintf (stderr, "event_queue_open_outputs: end\n");
+#endif
+        return 0;
+      }
+#if DEBUG_EVENT_QUEUE_OPEN_OUTPUTS
+  fprintf (stderr, "event_queue_open_outputs: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_EVENT_QUEUE_OPEN_OUTPUTS
+#define event_queue_open_outputs _event_queue_open_outputs
+#else
+int event_queue_open_outputs (EventQueue *, System *);
+#endif
+
+static inline int
+_event_queue_step (EventQueue * eq)
+{
+  int k;
+  TimeEvent event[1];
+  GSList *list, *actuated = NULL;
+#if DEBUG_EVENT_QUEUE_STEP
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "event_queue_step: start\n");
+#endif
+  k = 1;
+  while (k && eq->n && t >= eq->event->t)
+    {
+      *event = *eq->event;
+      event_queue_pop (eq);
+#if DEBUG_EVENT_QUEUE_STEP
+      if (t >= DEBUG_TIME)
+        fprintf (stderr, "EQS t=" FWL " type=%d channel=%d\n",
+                 event->t, event->type, event->channel);
+#endif
+      // rescheduling an event after popping it never enlarges the heap
+      if (event->type == LIMITER_TYPE_SECTION_CHANGES)
+        {
+          k = change_sections (p, ((SectionChanges *) event->data)->sv, t);
+          event_queue_section_changes
+            (eq, (SectionChanges *) event->data, event->channel);
+        }
+      else
+        {
+          if (section_gauge_sample ((SectionGauge *) event->data, p))
+            actuated = g_slist_prepend (actuated, event->data);
+          event_queue_section_gauge
+            (eq, (SectionGauge *) event->data, event->channel);
+        }
+    }
+  // the sections are changed once all the controls have been evaluated
+  for (list = actuated; k && list; list = list->next)
+    k = change_sections (p, ((SectionGauge *) list->data)->sv, t);
+  g_slist_free (actuated);
+#if DEBUG_EVENT_QUEUE_STEP
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "event_queue_step: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_EVENT_QUEUE_STEP
+#define event_queue_step _event_queue_step
+#else
+int event_queue_step (EventQueue *);
+#endif
+
+static inline void
+_event_queue_tmax (EventQueue * eq)
+{
+  if (eq->n && eq->event->t < tmax)
+    {
+      limiter_set
+        (limiter, eq->event->type, eq->event->channel, eq->event->index);
+      tmax = eq->event->t;
+    }
+}
+
+#if INLINE_EVENT_QUEUE_TMAX
+#define event_queue_tmax _event_queue_tmax
+#else
+void event_queue_tmax (EventQueue *);
+#endif
+
+#endif
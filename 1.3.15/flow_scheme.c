@@ -85,19 +85,35 @@ boundary_flow_tmax (BoundaryFlow * bf)
 }
 #endif
 
-#if !INLINE_SYSTEM_PARAMETERS2_PARALLEL
+#if !INLINE_SYSTEM_SERIES_WINDOW
 void
+system_series_window ()
+{
+  _system_series_window ();
+}
+#endif
+
+#if !INLINE_SYSTEM_RESAMPLE
+int
+system_resample (JBDOUBLE h)
+{
+  return _system_resample (h);
+}
+#endif
+
+#if !INLINE_SYSTEM_PARAMETERS2_PARALLEL
+int
 system_parameters2_parallel ()
 {
-  _system_parameters2_parallel ();
+  return _system_parameters2_parallel ();
 }
 #endif
 
 #if !INLINE_SYSTEM_PARAMETERS2_SIMPLE
-void
+int
 system_parameters2_simple ()
 {
-  _system_parameters2_simple ();
+  return _system_parameters2_simple ();
 }
 #endif
 
@@ -295,6 +311,14 @@ junction_flow_scheme (Junction * junction)
 }
 #endif
 
+#if !INLINE_SYSTEM_MASS_BOUNDARIES
+void
+system_mass_boundaries ()
+{
+  _system_mass_boundaries ();
+}
+#endif
+
 #if !INLINE_SYSTEM_SIMULATE_STEP_PARALLEL
 void
 system_simulate_step_parallel ()
@@ -41,6 +41,7 @@ Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved
 #define FLOW_SCHEME__H 1
 
 #include "parameters.h"
+#include "event_queue.h"
 #include "transport_scheme.h"
 
 extern JBDOUBLE tmax;
@@ -54,7 +55,7 @@ extern void (*diffusion_parameters_implicit) (Parameters *);
 extern void (*flow_parameters) (Parameters *);
 extern void (*part_decomposition) (int);
 extern void (*system_parameters) ();
-extern void (*system_parameters2) ();
+extern int (*system_parameters2) ();
 extern void (*system_decomposition) ();
 extern void (*system_simulate_step) ();
 extern void (*system_simulate_step2) ();
@@ -321,6 +322,7 @@ _part_parameters2 (int thread)
 #if TMAX == TMAX_CELL
   JBDOUBLE k;
 #endif
+  gint64 time0;
   Channel *channel;
   Parameters *pv;
   TransportParameters *tpv;
@@ -328,6 +330,7 @@ _part_parameters2 (int thread)
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_parameters2: start\n");
 #endif
+  time0 = g_get_monotonic_time ();
   i = cell_thread[thread];
   i2 = cell_thread[thread + 1] - 1;
   pv = p + i;
@@ -415,7 +418,8 @@ _part_parameters2 (int thread)
   if (k > dtmax)
     {
       g_mutex_lock (mutex);
-      dtmax = k;
+      if (k > dtmax)
+        dtmax = k;
       g_mutex_unlock (mutex);
     }
 #endif
@@ -437,6 +441,8 @@ _part_parameters2 (int thread)
             break;
           }
     }
+  time0 = g_get_monotonic_time () - time0;
+  profile_thread_add (profile, PROFILE_PHASE_PARAMETERS2, thread, time0);
 #if DEBUG_PART_PARAMETERS2
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_parameters2: end\n");
@@ -596,15 +602,132 @@ void boundary_flow_tmax (BoundaryFlow *);
 #endif
 
 /*
-void system_parameters2_parallel()
+void system_series_window()
 
-Function to obtain the flow parameters in the domain with parallel execution
+Function to move the windows on the external time series files of the boundary
+conditions to hold the time step
 */
 
 static inline void
+_system_series_window ()
+{
+  int i, j, k;
+  Channel *channel;
+  BoundaryFlow *bf;
+  BoundaryTransport *bt;
+#if DEBUG_SYSTEM_SERIES_WINDOW
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "system_series_window: start\n");
+#endif
+  // a window that can not grow keeps its last records
+  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
+    {
+      for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf)
+        if (bf->series->name)
+          boundary_flow_window (bf, t, tmax);
+      for (k = 0; k <= channel->nt; ++k)
+        for (j = 0, bt = channel->ct[k].bt; j <= channel->ct[k].n; ++j, ++bt)
+          if (bt->series->name)
+            boundary_transport_window (bt, t, tmax);
+    }
+#if DEBUG_SYSTEM_SERIES_WINDOW
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "system_series_window: end\n");
+#endif
+}
+
+#if INLINE_SYSTEM_SERIES_WINDOW
+#define system_series_window _system_series_window
+#else
+void system_series_window ();
+#endif
+
+/*
+int system_resample(JBDOUBLE h)
+
+Function to resample the time series of the boundary conditions on uniform time
+grids reporting the maximum interpolation errors
+
+Inputs:
+	h: time interval of the grids
+
+Output:
+	1 on success, 0 on error
+*/
+
+static inline int
+_system_resample (JBDOUBLE h)
+{
+  int i, j, k;
+  JBDOUBLE e;
+  Channel *channel;
+  BoundaryFlow *bf;
+  BoundaryTransport *bt;
+#if DEBUG_SYSTEM_RESAMPLE
+  fprintf (stderr, "system_resample: start\n");
+#endif
+  // the external files are read in windows and can not be resampled
+  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
+    {
+      for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf)
+        if (bf->t && bf->n > 0 && !bf->series->name)
+          {
+            if (!boundary_flow_resample (bf, h, &e))
+              {
+                boundary_flow_error (bf, gettext ("Bad resample interval"));
+                goto exit1;
+              }
+            printf ("Resample channel=%s boundary=%s points=%d grid=%d"
+                    " max_error=" FWL "\n", channel->name, bf->name,
+                    bf->n + 1, bf->grid->n + 1, e);
+          }
+      for (k = 0; k <= channel->nt; ++k)
+        for (j = 0, bt = channel->ct[k].bt; j <= channel->ct[k].n; ++j, ++bt)
+          if (bt->type == BOUNDARY_TRANSPORT_TYPE_Q && bt->n > 0
+              && !bt->series->name)
+            {
+              if (!boundary_transport_resample (bt, h, &e))
+                {
+                  boundary_transport_error
+                    (bt, gettext ("Bad resample interval"));
+                  goto exit1;
+                }
+              printf ("Resample channel=%s boundary=%s points=%d grid=%d"
+                      " max_error=" FWL "\n", channel->name, bt->name,
+                      bt->n + 1, bt->grid->n + 1, e);
+            }
+    }
+#if DEBUG_SYSTEM_RESAMPLE
+  fprintf (stderr, "system_resample: end\n");
+#endif
+  return 1;
+
+exit1:
+  jbw_show_error (message);
+#if DEBUG_SYSTEM_RESAMPLE
+  fprintf (stderr, "system_resample: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SYSTEM_RESAMPLE
+#define system_resample _system_resample
+#else
+int system_resample (JBDOUBLE);
+#endif
+
+/*
+int system_parameters2_parallel()
+
+Function to obtain the flow parameters in the domain with parallel execution
+*/
+
+static inline int
 _system_parameters2_parallel ()
 {
-  int i, j;
+  int i, j, l, k;
+  gint64 time0;
+  JBDOUBLE tlimit;
   GThread *thread[nth];
   Channel *channel;
   BoundaryFlow *bf;
@@ -636,24 +759,31 @@ _system_parameters2_parallel ()
   else
     dtmax = INFINITY;
   dtmax = fmin (dtmax, FRICTION_CFL * fdtmax);
+  limiter_set (limiter, dtmax < FRICTION_CFL * fdtmax ?
+               LIMITER_TYPE_CELL : LIMITER_TYPE_FRICTION, -1, -1);
   tmax = t + dtmax;
 #if DEBUG_SYSTEM_PARAMETERS2_PARALLEL
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SP2P tmax=" FWL " dtmax=" FWL "\n", tmax, dtmax);
 #endif
-  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
-    for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf)
-      boundary_flow_tmax (bf);
+  system_series_window ();
+  for (i = l = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
+    for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf, ++l)
+      {
+        tlimit = dtmax;
+        boundary_flow_tmax (bf);
+        limiter_update (limiter, tlimit, dtmax, LIMITER_TYPE_BOUNDARY, i, l);
+      }
   tmax = t + dtmax;
 #if DEBUG_SYSTEM_PARAMETERS2_PARALLEL
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SP2P tmax=" FWL " dtmax=" FWL "\n", tmax, dtmax);
 #endif
-  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
-    {
-      list_section_changes_tmax (channel->list_section_changes);
-      list_section_gauge_tmax (channel->list_section_gauge);
-    }
+  time0 = g_get_monotonic_time ();
+  k = event_queue_step (event_queue);
+  event_queue_tmax (event_queue);
+  profile_add
+    (profile, PROFILE_PHASE_SECTIONS, g_get_monotonic_time () - time0);
   dtmax = tmax - t;
 #if DEBUG_SYSTEM_PARAMETERS2_PARALLEL
   if (t >= DEBUG_TIME)
@@ -665,24 +795,27 @@ _system_parameters2_parallel ()
       fprintf (stderr, "system_parameters2_parallel: end\n");
     }
 #endif
+  return k;
 }
 
 #if INLINE_SYSTEM_PARAMETERS2_PARALLEL
 #define system_parameters2_parallel _system_parameters2_parallel
 #else
-void system_parameters2_parallel ();
+int system_parameters2_parallel ();
 #endif
 
 /*
-void system_parameters2_simple()
+int system_parameters2_simple()
 
 Function to obtain the flow parameters in the domain without parallel execution
 */
 
-static inline void
+static inline int
 _system_parameters2_simple ()
 {
-  int i, j;
+  int i, j, l, k;
+  gint64 time0;
+  JBDOUBLE tlimit;
   Channel *channel;
   BoundaryFlow *bf;
 #if DEBUG_SYSTEM_PARAMETERS2_SIMPLE
@@ -697,24 +830,31 @@ _system_parameters2_simple ()
   else
     dtmax = INFINITY;
   dtmax = fmin (dtmax, FRICTION_CFL * fdtmax);
+  limiter_set (limiter, dtmax < FRICTION_CFL * fdtmax ?
+               LIMITER_TYPE_CELL : LIMITER_TYPE_FRICTION, -1, -1);
   tmax = t + dtmax;
 #if DEBUG_SYSTEM_PARAMETERS2_SIMPLE
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SP2S tmax=" FWL " dtmax=" FWL "\n", tmax, dtmax);
 #endif
-  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
-    for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf)
-      boundary_flow_tmax (bf);
+  system_series_window ();
+  for (i = l = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
+    for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf, ++l)
+      {
+        tlimit = dtmax;
+        boundary_flow_tmax (bf);
+        limiter_update (limiter, tlimit, dtmax, LIMITER_TYPE_BOUNDARY, i, l);
+      }
   tmax = t + dtmax;
 #if DEBUG_SYSTEM_PARAMETERS2_SIMPLE
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SP2S tmax=" FWL " dtmax=" FWL "\n", tmax, dtmax);
 #endif
-  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
-    {
-      list_section_changes_tmax (channel->list_section_changes);
-      list_section_gauge_tmax (channel->list_section_gauge);
-    }
+  time0 = g_get_monotonic_time ();
+  k = event_queue_step (event_queue);
+  event_queue_tmax (event_queue);
+  profile_add
+    (profile, PROFILE_PHASE_SECTIONS, g_get_monotonic_time () - time0);
   dtmax = tmax - t;
 #if DEBUG_SYSTEM_PARAMETERS2_SIMPLE
   if (t >= DEBUG_TIME)
@@ -726,12 +866,13 @@ _system_parameters2_simple ()
       fprintf (stderr, "system_parameters2_simple: end\n");
     }
 #endif
+  return k;
 }
 
 #if INLINE_SYSTEM_PARAMETERS2_SIMPLE
 #define system_parameters2_simple _system_parameters2_simple
 #else
-void system_parameters2_simple ();
+int system_parameters2_simple ();
 #endif
 
 /*
@@ -1398,7 +1539,7 @@ static inline void _flow_inner_boundary (BoundaryFlow * bf)
     fprintf (stderr, "FIB Qm=" FWL " t=" FWL " tmax=" FWL " dt=" FWL "\n",
              k, t, tmax, dt);
 #endif
-  m->inner += k;
+  bf->mass += k;
   bf->contribution = k / dt;
   k /= dt;
   if (pv->uc == 0.)
@@ -1425,7 +1566,7 @@ exit_1:
     {
       fprintf (stderr, "FIB inner=" FWL " dQp=" FWF " dQm=" FWF "\nla "
                FWF " lb=" FWF " c=" FWF "\n",
-               m->inner, (pv - 1)->dQp, pv->dQm, pv->la, pv->lb, pv->uc);
+               bf->mass, (pv - 1)->dQp, pv->dQm, pv->la, pv->lb, pv->uc);
       fprintf (stderr, "flow_inner_boundary: end\n");
     }
 #endif
@@ -1702,7 +1843,7 @@ static inline void _flow_inlet_explicit (BoundaryFlow * bf, Parameters * p)
       k2 = 0.5 * (p->Q + k) * dt;
     }
 
-  m->inlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   p->iA += k2 - p->Q * dt;
   k4 = p->A + p->iA / p->dx;
@@ -1712,7 +1853,7 @@ static inline void _flow_inlet_explicit (BoundaryFlow * bf, Parameters * p)
       k = 0.5 * (p->Q + p->iQ / p->dx) * dt;
       p->iQ = -p->dx * p->Q;
       p->iA -= k;
-      m->inlet -= k;
+      bf->mass -= k;
       bf->contribution -= k / dt;
     }
   else if (k > k2)
@@ -1721,7 +1862,7 @@ static inline void _flow_inlet_explicit (BoundaryFlow * bf, Parameters * p)
       p->iQ += k * p->dx;
       k *= 0.5 * dt;
       p->iA += k;
-      m->inlet += k;
+      bf->mass += k;
       bf->contribution += k / dt;
     }
   goto inlet_end;
@@ -1731,7 +1872,7 @@ inlet_fix:
   if (t >= DEBUG_TIME)
     fprintf (stderr, "FIE k=" FWL " k2=" FWL " k3=" FWL "\n", k, k2, k3);
 #endif
-  m->inlet += k;
+  bf->mass += k;
   bf->contribution = k / dt;
   p->iA += k - p->Q * dt;
   p->iQ = (k3 / k2 * (p->A + p->iA / p->dx) - p->Q) * p->dx;
@@ -1756,14 +1897,14 @@ area_subcritical:
     fprintf (stderr, "FIE iQ=" FWF " k2=" FWL " k3=" FWL "\n", p->iQ, k2, k3);
 #endif
   bf->contribution = p->Q + 0.5 * p->iQ / p->dx;
-  m->inlet += bf->contribution * dt;
+  bf->mass += bf->contribution * dt;
   goto inlet_end;
 #elif BOUNDARY_FLOW == BOUNDARY_FLOW_WAVE
   k = (k - p->A) * p->dx;
   p->iQ += (k - p->iA) * p->la;
   p->iA = k;
   bf->contribution = p->Q + 0.5 * p->iQ / p->dx;
-  m->inlet += bf->contribution * dt;
+  bf->mass += bf->contribution * dt;
   goto inlet_end;
 #elif BOUNDARY_FLOW == BOUNDARY_FLOW_LOCAL
   p->iA = (k - p->A) * p->dx;
@@ -1771,7 +1912,7 @@ area_subcritical:
   p->iQ = p->dx * (q->iQ / q->dx + jbm_fdbl (q->Q - p->Q) +
                    (p->iA + p->dx * q->iA / q->dx) / dt);
   bf->contribution = p->Q + 0.5 * p->iQ / p->dx;
-  m->inlet += bf->contribution * dt;
+  bf->mass += bf->contribution * dt;
   goto inlet_end;
 #else
 #if DEBUG_FLOW_INLET_EXPLICIT
@@ -1790,7 +1931,7 @@ area_subcritical:
 #endif
   if (k3 >= p->Q + k4)
     {
-      m->inlet += k2 + p->Q * dt;
+      bf->mass += k2 + p->Q * dt;
       bf->contribution = k2 / dt + p->Q;
       p->iA = k;
       p->iQ = k4 * p->dx;
@@ -1803,7 +1944,7 @@ area_subcritical:
 discharge_subcritical:
 #if BOUNDARY_FLOW == BOUNDARY_FLOW_EXTRAPOLATE
   p->iQ = (k - p->Q) * p->dx;
-  m->inlet += k2;
+  bf->mass += k2;
   q = p + 1;
   k2 = jbm_fdbl (q->Q + q->iQ / q->dx);
   k3 = jbm_fdbl (q->A + q->iA / q->dx);
@@ -1820,7 +1961,7 @@ discharge_subcritical:
   k = (k - p->Q) * p->dx;
   p->iA += (k - p->iQ) / p->la;
   p->iQ = k;
-  m->inlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   goto inlet_end;
 #elif BOUNDARY_FLOW == BOUNDARY_FLOW_LOCAL
@@ -1831,7 +1972,7 @@ discharge_subcritical:
   k3 = q->iQ / q->dx;
   p->iA = fmax ((k4 - p->A) * p->dx,
                 dt * (jbm_fdbl (p->Q - q->Q) + k - k3) - q->iA * p->dx / q->dx);
-  m->inlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   goto inlet_end;
 #else
@@ -1840,7 +1981,7 @@ discharge_subcritical:
     fprintf (stderr, "FIE k=" FWL " k2=" FWL "\n", k, k2);
 #endif
   p->iQ = (k - p->Q) * p->dx;
-  m->inlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   k2 -= p->Q * dt;
   p->iA += k2;
@@ -1856,7 +1997,7 @@ inlet_end:
   if (t >= DEBUG_TIME)
     {
       fprintf (stderr, "FIE iA=" FWF " iQ=" FWF "\n", p->iA, p->iQ);
-      fprintf (stderr, "FIE Input:=" FWL "\n", m->inlet);
+      fprintf (stderr, "FIE Input:=" FWL "\n", bf->mass);
       fprintf (stderr, "flow_inlet_explicit: end\n");
     }
 #endif
@@ -1939,7 +2080,7 @@ static inline void _flow_outlet_explicit (BoundaryFlow * bf, Parameters * p)
       k2 = -0.5 * (p->Q + k) * dt;
     }
 
-  m->outlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   p->iA += k2 + p->Q * dt;
   k4 = p->A + p->iA / p->dx;
@@ -1965,7 +2106,7 @@ static inline void _flow_outlet_explicit (BoundaryFlow * bf, Parameters * p)
       k = 0.5 * (p->Q + p->iQ / p->dx) * dt;
       p->iQ = -p->dx * p->Q;
       p->iA += k;
-      m->outlet += k;
+      bf->mass += k;
       bf->contribution += k / dt;
     }
   else if (k < k2)
@@ -1978,7 +2119,7 @@ static inline void _flow_outlet_explicit (BoundaryFlow * bf, Parameters * p)
       p->iQ += k * p->dx;
       k *= 0.5 * dt;
       p->iA -= k;
-      m->outlet -= k;
+      bf->mass -= k;
       bf->contribution -= k / dt;
     }
 #if DEBUG_FLOW_OUTLET_EXPLICIT
@@ -1992,7 +2133,7 @@ outlet_fix:
   if (t >= DEBUG_TIME)
     fprintf (stderr, "FOE k=" FWL " k2=" FWL " k3=" FWL "\n", k, k2, k3);
 #endif
-  m->outlet += k;
+  bf->mass += k;
   bf->contribution = k / dt;
   p->iA += k + p->Q * dt;
   p->iQ = (k3 / k2 * (p->A + p->iA / p->dx) - p->Q) * p->dx;
@@ -2018,7 +2159,7 @@ area_subcritical:
 #endif
   if (k3 <= p->Q + k4)
     {
-      m->outlet -= k2 + p->Q * dt;
+      bf->mass -= k2 + p->Q * dt;
       bf->contribution = -k2 / dt - p->Q;
       p->iA = k;
       p->iQ = k4 * p->dx;
@@ -2033,7 +2174,7 @@ discharge_subcritical:
     fprintf (stderr, "FOE k=" FWL " k2=" FWL "\n", k, k2);
 #endif
   p->iQ = (k - p->Q) * p->dx;
-  m->outlet += k2;
+  bf->mass += k2;
   bf->contribution = k2 / dt;
   k2 += p->Q * dt;
   p->iA += k2;
@@ -2048,7 +2189,7 @@ outlet_end:
   if (t >= DEBUG_TIME)
     {
       fprintf (stderr, "FOE iA=" FWF " iQ=" FWF "\n", p->iA, p->iQ);
-      fprintf (stderr, "FOE Output:=" FWF "\n", m->outlet);
+      fprintf (stderr, "FOE Output:=" FWF "\n", bf->mass);
       fprintf (stderr, "flow_outlet_explicit: end\n");
     }
 #endif
@@ -2064,6 +2205,7 @@ void flow_outlet_explicit (BoundaryFlow *, Parameters * p);
 static inline void _part_decomposition_explicit (int thread)
 {
   int i, i2, j, k, l;
+  gint64 time0;
   ChannelTransport *ct;
   Channel *channel;
   Parameters *pv;
@@ -2073,6 +2215,7 @@ static inline void _part_decomposition_explicit (int thread)
   if (t >= DEBUG_TIME)
       fprintf (stderr, "part_decomposition_explicit: start\n");
 #endif
+  time0 = g_get_monotonic_time ();
     i = cell_thread[thread];
     i2 = cell_thread[thread + 1] - 1;
   if (sys->nt >= 0)
@@ -2140,7 +2283,7 @@ static inline void _part_decomposition_explicit (int thread)
                 continue;
               if (l > i2)
                 break;
-              transport_boundary (tpv, p, m + k, ct->bt + j);
+              transport_boundary (tpv, p, ct->bt + j);
             }
         }
 #if DEBUG_PART_DECOMPOSITION_EXPLICIT
@@ -2211,6 +2354,8 @@ static inline void _part_decomposition_explicit (int thread)
   for (pv = p + i, j = i2; --j >= i; ++pv)
     flow_friction_explicit (pv);
 #endif
+  time0 = g_get_monotonic_time () - time0;
+  profile_thread_add (profile, PROFILE_PHASE_DECOMPOSITION, thread, time0);
 #if DEBUG_PART_DECOMPOSITION_EXPLICIT
   if (t >= DEBUG_TIME)
     {
@@ -2417,12 +2562,14 @@ void flow_implicit_friction (Parameters * p, JBDOUBLE);
 static inline void _part_simulate_step (int thread)
 {
   int i, i2, j;
+  gint64 time0;
   Channel *channel;
   Parameters *pv;
 #if DEBUG_PART_SIMULATE_STEP
   if (t >= DEBUG_TIME)
       fprintf (stderr, "part_simulate_step: start\n");
 #endif
+  time0 = g_get_monotonic_time ();
     i = cell_thread[thread];
     i2 = cell_thread[thread + 1] - 1;
 #if DEBUG_PART_SIMULATE_STEP
@@ -2481,6 +2628,8 @@ static inline void _part_simulate_step (int thread)
                  "\n", j, pv->Av, pv->A, pv->Qv, pv->Q, pv->iQ);
 #endif
     }
+  time0 = g_get_monotonic_time () - time0;
+  profile_thread_add (profile, PROFILE_PHASE_SIMULATE_STEP, thread, time0);
 #if DEBUG_PART_SIMULATE_STEP
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_simulate_step: end\n");
@@ -2645,9 +2794,57 @@ static inline void _junction_flow_scheme (Junction * junction)
 void junction_flow_scheme (Junction *);
 #endif
 
+static inline void _system_mass_boundaries ()
+{
+  int i, j, k;
+  Channel *channel;
+  BoundaryFlow *bf;
+  BoundaryTransport *bt;
+#if DEBUG_SYSTEM_MASS_BOUNDARIES
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "system_mass_boundaries: start\n");
+#endif
+  // the boundary mass increments are summed in a fixed order to get the same
+  // mass balance with any number of threads
+  for (i = 0, channel = sys->channel; i <= sys->n; ++i, ++channel)
+    {
+      for (j = 0, bf = channel->bf; j <= channel->n; ++j, ++bf)
+        {
+          if (bf->position < 0)
+            m->inlet += bf->mass;
+          else if (bf->position > 0)
+            m->outlet += bf->mass;
+          else
+            m->inner += bf->mass;
+          bf->mass = 0.;
+        }
+      for (k = 0; k <= channel->nt; ++k)
+        for (j = 0, bt = channel->ct[k].bt; j <= channel->ct[k].n; ++j, ++bt)
+          {
+            m[k].inner += bt->mass;
+            bt->mass = 0.;
+          }
+    }
+#if DEBUG_SYSTEM_MASS_BOUNDARIES
+  if (t >= DEBUG_TIME)
+    {
+      fprintf (stderr, "SMB inlet=" FWL " inner=" FWL " outlet=" FWL "\n",
+               m->inlet, m->inner, m->outlet);
+      fprintf (stderr, "system_mass_boundaries: end\n");
+    }
+#endif
+}
+
+#if INLINE_SYSTEM_MASS_BOUNDARIES
+#define system_mass_boundaries _system_mass_boundaries
+#else
+void system_mass_boundaries ();
+#endif
+
 static inline void _system_simulate_step_parallel ()
 {
   int i;
+  gint64 time0;
   GThread *thread[nth];
 #if DEBUG_SYSTEM_SIMULATE_STEP_PARALLEL
   if (t >= DEBUG_TIME)
@@ -2664,8 +2861,12 @@ static inline void _system_simulate_step_parallel ()
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SSSP njunctions=%d\n", njunctions);
 #endif
+  time0 = g_get_monotonic_time ();
   for (i = 0; i <= njunctions; ++i)
     junction_flow_scheme (junction + i);
+  profile_add
+    (profile, PROFILE_PHASE_JUNCTIONS, g_get_monotonic_time () - time0);
+  system_mass_boundaries ();
 #if DEBUG_SYSTEM_SIMULATE_STEP_PARALLEL
   if (t >= DEBUG_TIME)
     {
@@ -2685,6 +2886,7 @@ void system_simulate_step_parallel ();
 static inline void _system_simulate_step_simple ()
 {
   int i;
+  gint64 time0;
 #if DEBUG_SYSTEM_SIMULATE_STEP_SIMPLE
   if (t >= DEBUG_TIME)
     fprintf (stderr, "system_simulate_step_simple: start\n");
@@ -2696,8 +2898,12 @@ static inline void _system_simulate_step_simple ()
   if (t >= DEBUG_TIME)
     fprintf (stderr, "SSSS njunctions=%d\n", njunctions);
 #endif
+  time0 = g_get_monotonic_time ();
   for (i = 0; i <= njunctions; ++i)
     junction_flow_scheme (junction + i);
+  profile_add
+    (profile, PROFILE_PHASE_JUNCTIONS, g_get_monotonic_time () - time0);
+  system_mass_boundaries ();
 #if DEBUG_SYSTEM_SIMULATE_STEP_SIMPLE
   if (t >= DEBUG_TIME)
     {
@@ -2717,6 +2923,7 @@ void system_simulate_step_simple ();
 static inline void _part_simulate_step2 (int thread)
 {
   int i, i2, j;
+  gint64 time0;
   JBDOUBLE k, k2;
   Channel *channel;
   Parameters *pv;
@@ -2724,6 +2931,7 @@ static inline void _part_simulate_step2 (int thread)
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_simulate_step2: start\n");
 #endif
+  time0 = g_get_monotonic_time ();
   i = cell_thread[thread];
   i2 = cell_thread[thread + 1] - 1;
 #if DEBUG_PART_SIMULATE_STEP2
@@ -2738,11 +2946,13 @@ static inline void _part_simulate_step2 (int thread)
   k = fo * dt2;
   pv = p + i;
   channel = pv->channel;
+  // the last cell of a subdomain inside a channel and the first cell of the
+  // next subdomain are updated in a fixed order after the threads join
   if (i != channel->i)
     {
       k2 = k * pv->gm * pv->dzb;
-      pv->iQ -= k2 * pv->iA;
       (pv + 1)->iQ -= k2 * (pv + 1)->iA;
+      goto shared;
     }
   do
     {
@@ -2755,6 +2965,7 @@ static inline void _part_simulate_step2 (int thread)
       if (t >= DEBUG_TIME)
         fprintf (stderr, "PSS2 i=%d Q=" FWF " iQ=" FWF "\n", i, pv->Q, pv->iQ);
 #endif
+shared:
       ++i;
       ++pv;
 #if DEBUG_PART_SIMULATE_STEP2
@@ -2788,15 +2999,6 @@ static inline void _part_simulate_step2 (int thread)
           pv->iQ -= k2 * pv->iA;
           pv->Q += pv->iQ / pv->dx;
           flow_implicit_friction (pv, k);
-          ++pv;
-          k2 = k * pv->gm * pv->dzb;
-          pv->iQ -= k2 * pv->iA;
-          pv->Q += pv->iQ / pv->dx;
-          flow_implicit_friction (pv, k);
-          ++pv;
-          g_mutex_lock (mutex);
-          pv->iQ -= k2 * pv->iA;
-          g_mutex_unlock (mutex);
           break;
         }
 #if DEBUG_PART_SIMULATE_STEP2
@@ -2809,6 +3011,8 @@ static inline void _part_simulate_step2 (int thread)
       ++channel;
     }
   while (1);
+  time0 = g_get_monotonic_time () - time0;
+  profile_thread_add (profile, PROFILE_PHASE_SIMULATE_STEP2, thread, time0);
 #if DEBUG_PART_SIMULATE_STEP2
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_simulate_step2: end\n");
@@ -2844,6 +3048,7 @@ void part_simulate_step2_exit (int);
 static inline void _system_simulate_step2_parallel ()
 {
   int i, j;
+  JBDOUBLE k, k2;
   GThread *thread[nth];
   Parameters *pv;
   Channel *channel;
@@ -2857,6 +3062,30 @@ static inline void _system_simulate_step2_parallel ()
       (NULL, (void (*)) part_simulate_step2_exit, (void *) (size_t) i);
   for (i = 0; i < nth; ++i)
     g_thread_join (thread[i]);
+  k = fo * dt2;
+  for (i = 0; ++i < nth;)
+    {
+      j = cell_thread[i];
+      pv = p + j;
+      if (j != pv->channel->i)
+        {
+          --pv;
+          k2 = k * pv->gm * pv->dzb;
+          pv->iQ -= k2 * pv->iA;
+          pv->Q += pv->iQ / pv->dx;
+          flow_implicit_friction (pv, k);
+          ++pv;
+          pv->iQ -= k2 * pv->iA;
+          k2 = k * pv->gm * pv->dzb;
+          pv->iQ -= k2 * pv->iA;
+          pv->Q += pv->iQ / pv->dx;
+#if DEBUG_SYSTEM_SIMULATE_STEP2_PARALLEL
+          if (t >= DEBUG_TIME)
+            fprintf (stderr, "SSS2P j=%d Q=" FWF " iQ=" FWF "\n",
+                     j, pv->Q, pv->iQ);
+#endif
+        }
+    }
   for (i = 0; ++i <= nth;)
     {
       j = cell_thread[i - 1];
@@ -82,6 +82,15 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * \brief boolean defining if the initial conditions are calculated.
  * \var simulated
  * \brief booleand defining if a simulation was finised.
+ * \var restarting
+ * \brief boolean defining if the simulations have to be restarted from their
+ *   checkpoints.
+ * \var resuming
+ * \brief boolean defining if the actual simulation is resumed from its
+ *   checkpoint.
+ * \var calibrating
+ * \brief boolean defining if the controlled cross sections are calibrated
+ *   instead of actuated.
  * \var type_animation
  * \brief type of solution display: 0 at the end of the simulation, 1 at every
  *   interval of solution saves and 2 at every time step.
@@ -92,6 +101,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * \brief boolean defining if the program is opening a system of channels.
  * \var nstep
  * \brief number of time points with saved results.
+ * \var limiter
+ * \brief counters of the time step size limits.
+ * \var limiter_type_name
+ * \brief names of the types of time step size limits.
  * \var flow_steady_error_max
  * \brief maximum flow error considered to obtain steady initial conditions
  *   convergence.
@@ -107,17 +120,28 @@ JBFLOAT fcfl, fo;
 int channel_overflow;
 int started = 0;
 int simulated = 0;
+int restarting = 0;
+int resuming = 0;
+int calibrating = 0;
 int type_animation = 1;
 int animating = 0;
 int opening = 0;
 int nstep = 0;
+Limiter limiter[1];
+EventQueue event_queue[1];
+const char *limiter_type_name[LIMITER_TYPES] = { "cell", "friction",
+  "boundary", "section_changes", "section_gauge", "observation", "output"
+};
+const char *memory_type_name[MEMORY_TYPES] = { "parameters", "sections",
+  "friction", "transport", "variables", "junctions", "mass", "limiter"
+};
 
 JBFLOAT flow_steady_error_max;
 
 void (*flow_parameters) (Parameters *);
 void (*part_decomposition) (int);
 void (*system_parameters) ();
-void (*system_parameters2) ();
+int (*system_parameters2) ();
 void (*system_decomposition) ();
 void (*system_simulate_step) ();
 void (*system_simulate_step2) ();
@@ -533,6 +557,8 @@ simulation_open (char *file_name)
         return 0;
       printf ("Simulating\n");
       simulate ();
+      printf ("Cells=%d steps=%ld\n",
+              n + 1, (long) profile->calls[PROFILE_PHASE_DECOMPOSITION]);
       printf ("Mass=" FWL "\n", flow_mass (p, n));
       for (i = 0; i <= sys->channel->nt; ++i)
         printf ("Solute=%d mass=" FWL "\n",
@@ -669,6 +695,14 @@ main (int argn, char **argc)
     case 2:
       buffer = argc[1];
       break;
+    case 3:
+      if (!strcmp (argc[1], "-restart"))
+        {
+          restarting = 1;
+          buffer = argc[2];
+          break;
+        }
+      goto usage;
     case 4:
       if (!strcmp (argc[1], "-np") && sscanf (argc[2], "%d", &nthreads) == 1 &&
           nthreads > 0)
@@ -676,13 +710,32 @@ main (int argn, char **argc)
           buffer = argc[3];
           break;
         }
+      if (!strcmp (argc[1], "-convert"))
+        {
+          if (!stream_convert (argc[2], argc[3]))
+            return 6;
+          return 0;
+        }
+      goto usage;
+    case 5:
+      if (!strcmp (argc[1], "-np") && sscanf (argc[2], "%d", &nthreads) == 1 &&
+          nthreads > 0 && !strcmp (argc[3], "-restart"))
+        {
+          restarting = 1;
+          buffer = argc[4];
+          break;
+        }
     default:
+    usage:
       jbw_show_error2 (gettext ("Usage is"),
                        gettext
-                       ("swigs [-np number_of_processors] simulation_file"));
+                       ("swigs [-np number_of_processors] [-restart] "
+                        "simulation_file\n"
+                        "swigs -convert binary_stream_file ascii_file"));
       return 1;
     }
-  simulation_open (buffer);
+  if (!simulation_open (buffer))
+    return 7;
 #endif
   return 0;
 }
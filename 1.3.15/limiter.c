@@ -0,0 +1,242 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file limiter.c
+ * \brief Source file to define the attribution of the time step size limits.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "limiter.h"
+
+/**
+ * \fn int limiter_open(Limiter *lm, System *s, int nc)
+ * \brief Function to open the counters of the time step size limits.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param s
+ * \brief system of channels.
+ * \param nc
+ * \brief highest cell number.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_LIMITER_OPEN
+int
+limiter_open (Limiter * lm, System * s, int nc)
+{
+  return _limiter_open (lm, s, nc);
+}
+#endif
+
+/**
+ * \fn void limiter_set(Limiter *lm, int type, int channel, int index)
+ * \brief Function to set the limit of the actual time step.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param type
+ * \brief type of the limit.
+ * \param channel
+ * \brief channel number or -1.
+ * \param index
+ * \brief boundary condition or output number or -1.
+ */
+#if !INLINE_LIMITER_SET
+void
+limiter_set (Limiter * lm, int type, int channel, int index)
+{
+  _limiter_set (lm, type, channel, index);
+}
+#endif
+
+/**
+ * \fn void limiter_update(Limiter *lm, JBDOUBLE t0, JBDOUBLE t1, int type, \
+ *   int channel, int index)
+ * \brief Function to set the limit of the actual time step if a limit reduces
+ *   the time step size.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param t0
+ * \brief time step size or final time before the limit.
+ * \param t1
+ * \brief time step size or final time after the limit.
+ * \param type
+ * \brief type of the limit.
+ * \param channel
+ * \brief channel number or -1.
+ * \param index
+ * \brief boundary condition or output number or -1.
+ */
+#if !INLINE_LIMITER_UPDATE
+void
+limiter_update (Limiter * lm, JBDOUBLE t0, JBDOUBLE t1, int type,
+                int channel, int index)
+{
+  _limiter_update (lm, t0, t1, type, channel, index);
+}
+#endif
+
+/**
+ * \fn int limiter_cell(Parameters *pv, int nc)
+ * \brief Function to find the cell with the most restrictive CFL condition.
+ * \param pv
+ * \brief array of flow parameters.
+ * \param nc
+ * \brief highest cell number.
+ * \return cell number.
+ */
+#if !INLINE_LIMITER_CELL
+int
+limiter_cell (Parameters * pv, int nc)
+{
+  return _limiter_cell (pv, nc);
+}
+#endif
+
+/**
+ * \fn int limiter_friction(Parameters *pv, int nc)
+ * \brief Function to find the cell with the most restrictive friction
+ *   stability condition.
+ * \param pv
+ * \brief array of flow parameters.
+ * \param nc
+ * \brief highest cell number.
+ * \return cell number.
+ */
+#if !INLINE_LIMITER_FRICTION
+int
+limiter_friction (Parameters * pv, int nc)
+{
+  return _limiter_friction (pv, nc);
+}
+#endif
+
+/**
+ * \fn void limiter_step(Limiter *lm, Parameters *pv, int nc)
+ * \brief Function to count the limit of the actual time step.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param pv
+ * \brief array of flow parameters.
+ * \param nc
+ * \brief highest cell number.
+ */
+#if !INLINE_LIMITER_STEP
+void
+limiter_step (Limiter * lm, Parameters * pv, int nc)
+{
+  _limiter_step (lm, pv, nc);
+}
+#endif
+
+/**
+ * \fn int limiter_rank(Limiter *lm, LimiterEvent **event)
+ * \brief Function to build the array of time step size limits ranked by the
+ *   number of limited time steps.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param event
+ * \brief pointer to the array of limits. It has to be freed with g_free.
+ * \return number of limits, -1 on error.
+ */
+#if !INLINE_LIMITER_RANK
+int
+limiter_rank (Limiter * lm, LimiterEvent ** event)
+{
+  return _limiter_rank (lm, event);
+}
+#endif
+
+/**
+ * \fn void limiter_event_print(LimiterEvent *e, int nsteps, FILE *file)
+ * \brief Function to print a time step size limit.
+ * \param e
+ * \brief time step size limit.
+ * \param nsteps
+ * \brief total number of time steps.
+ * \param file
+ * \brief file.
+ */
+#if !INLINE_LIMITER_EVENT_PRINT
+void
+limiter_event_print (LimiterEvent * e, int nsteps, FILE * file)
+{
+  _limiter_event_print (e, nsteps, file);
+}
+#endif
+
+/**
+ * \fn void limiter_print(Limiter *lm, FILE *file, int nmax)
+ * \brief Function to print the ranked report of the time step size limits.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param file
+ * \brief file.
+ * \param nmax
+ * \brief maximum number of printed limits, all if negative.
+ */
+#if !INLINE_LIMITER_PRINT
+void
+limiter_print (Limiter * lm, FILE * file, int nmax)
+{
+  _limiter_print (lm, file, nmax);
+}
+#endif
+
+/**
+ * \fn int limiter_save(Limiter *lm, char *path)
+ * \brief Function to save the full ranked report of the time step size
+ *   limits.
+ * \param lm
+ * \brief counters of the time step size limits.
+ * \param path
+ * \brief file path.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_LIMITER_SAVE
+int
+limiter_save (Limiter * lm, char *path)
+{
+  return _limiter_save (lm, path);
+}
+#endif
+
+/**
+ * \fn void limiter_close(Limiter *lm)
+ * \brief Function to free the counters of the time step size limits.
+ * \param lm
+ * \brief counters of the time step size limits.
+ */
+#if !INLINE_LIMITER_CLOSE
+void
+limiter_close (Limiter * lm)
+{
+  _limiter_close (lm);
+}
+#endif
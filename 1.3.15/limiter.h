@@ -0,0 +1,525 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**
+ * \file limiter.h
+ * \brief Header file to define the attribution of the time step size limits.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef LIMITER__H
+#define LIMITER__H 1
+
+#include "mesh.h"
+
+/**
+ * \enum LimiterType
+ * \brief Enumeration to define the types of time step size limits.
+ * \var LIMITER_TYPE_CELL
+ * \brief CFL condition of the wave velocities in a cell.
+ * \var LIMITER_TYPE_FRICTION
+ * \brief stability of the friction in a cell.
+ * \var LIMITER_TYPE_BOUNDARY
+ * \brief flow boundary condition.
+ * \var LIMITER_TYPE_SECTION_CHANGES
+ * \brief transient section change in a channel.
+ * \var LIMITER_TYPE_SECTION_GAUGE
+ * \brief section gauge of a channel.
+ * \var LIMITER_TYPE_OBSERVATION
+ * \brief solution save or final time.
+ * \var LIMITER_TYPE_OUTPUT
+ * \brief output time.
+ * \var LIMITER_TYPES
+ * \brief number of types of time step size limits.
+ */
+enum LimiterType
+{
+  LIMITER_TYPE_CELL = 0,
+  LIMITER_TYPE_FRICTION = 1,
+  LIMITER_TYPE_BOUNDARY = 2,
+  LIMITER_TYPE_SECTION_CHANGES = 3,
+  LIMITER_TYPE_SECTION_GAUGE = 4,
+  LIMITER_TYPE_OBSERVATION = 5,
+  LIMITER_TYPE_OUTPUT = 6,
+  LIMITER_TYPES = 7
+};
+
+/**
+ * \def LIMITER_PRINT_LINES
+ * \brief Macro to define the maximum number of limits printed at the end of
+ *   a simulation.
+ */
+#define LIMITER_PRINT_LINES 20
+
+/**
+ * \struct LimiterEvent
+ * \brief Structure to define a time step size limit in the ranked report.
+ */
+typedef struct
+{
+/**
+ * \var steps
+ * \brief number of time steps limited.
+ * \var type
+ * \brief type of the limit.
+ * \var channel
+ * \brief channel number or -1.
+ * \var index
+ * \brief cell, boundary or output number in the channel or in the system or
+ *   -1.
+ */
+  int steps, type, channel, index;
+} LimiterEvent;
+
+/**
+ * \struct Limiter
+ * \brief Structure to count the time steps limited by every cell, boundary
+ *   condition, section change, section gauge or output.
+ */
+typedef struct
+{
+/**
+ * \var cell
+ * \brief array of time steps limited by the wave velocities in every cell.
+ *   NULL if the limits are not counted.
+ * \var friction
+ * \brief array of time steps limited by the friction in every cell.
+ * \var boundary
+ * \brief array of time steps limited by every flow boundary condition.
+ * \var changes
+ * \brief array of time steps limited by the section changes of every channel.
+ * \var gauge
+ * \brief array of time steps limited by the section gauges of every channel.
+ * \var output
+ * \brief array of time steps limited by every output.
+ * \var nsteps
+ * \brief number of counted time steps.
+ * \var observation
+ * \brief number of time steps limited by the solution saves or the final
+ *   time.
+ * \var type
+ * \brief type of the limit of the actual time step.
+ * \var channel
+ * \brief channel number of the limit of the actual time step.
+ * \var index
+ * \brief boundary condition or output number of the limit of the actual time
+ *   step.
+ * \var ncells
+ * \brief number of cells.
+ * \var nboundaries
+ * \brief number of flow boundary conditions.
+ * \var nchannels
+ * \brief number of channels.
+ * \var noutputs
+ * \brief number of outputs.
+ */
+  int *cell, *friction, *boundary, *changes, *gauge, *output;
+  int nsteps, observation, type, channel, index, ncells, nboundaries,
+    nchannels, noutputs;
+} Limiter;
+
+extern Limiter limiter[1];
+extern const char *limiter_type_name[LIMITER_TYPES];
+
+static inline int
+_limiter_open (Limiter * lm, System * s, int nc)
+{
+  int i, j;
+#if DEBUG_LIMITER_OPEN
+  fprintf (stderr, "limiter_open: start\n");
+#endif
+  lm->ncells = nc + 1;
+  lm->nchannels = s->n + 1;
+  lm->noutputs = s->nout + 1;
+  for (i = j = 0; i <= s->n; ++i)
+    j += s->channel[i].n + 1;
+  lm->nboundaries = j;
+  j = 2 * (lm->ncells + lm->nchannels) + lm->nboundaries + lm->noutputs;
+  lm->cell = (int *) g_try_malloc (j * sizeof (int));
+  if (!lm->cell)
+    {
+      jbw_show_error2 (gettext ("Time step limits"),
+                       gettext ("Not enough memory"));
+#if DEBUG_LIMITER_OPEN
+      fprintf (stderr, "limiter_open: end\n");
+#endif
+      return 0;
+    }
+  memset (lm->cell, 0, j * sizeof (int));
+  lm->friction = lm->cell + lm->ncells;
+  lm->boundary = lm->friction + lm->ncells;
+  lm->changes = lm->boundary + lm->nboundaries;
+  lm->gauge = lm->changes + lm->nchannels;
+  lm->output = lm->gauge + lm->nchannels;
+  lm->nsteps = lm->observation = 0;
+  lm->type = LIMITER_TYPE_CELL;
+  lm->channel = lm->index = -1;
+#if DEBUG_LIMITER_OPEN
+  fprintf (stderr, "LO ncells=%d nboundaries=%d nchannels=%d noutputs=%d\n",
+           lm->ncells, lm->nboundaries, lm->nchannels, lm->noutputs);
+  fprintf (stderr, "limiter_open: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_LIMITER_OPEN
+#define limiter_open _limiter_open
+#else
+int limiter_open (Limiter *, System *, int);
+#endif
+
+static inline void
+_limiter_set (Limiter * lm, int type, int channel, int index)
+{
+  lm->type = type;
+  lm->channel = channel;
+  lm->index = index;
+}
+
+#if INLINE_LIMITER_SET
+#define limiter_set _limiter_set
+#else
+void limiter_set (Limiter *, int, int, int);
+#endif
+
+static inline void
+_limiter_update (Limiter * lm, JBDOUBLE t0, JBDOUBLE t1, int type,
+                 int channel, int index)
+{
+  if (t1 < t0)
+    limiter_set (lm, type, channel, index);
+}
+
+#if INLINE_LIMITER_UPDATE
+#define limiter_update _limiter_update
+#else
+void limiter_update (Limiter *, JBDOUBLE, JBDOUBLE, int, int, int);
+#endif
+
+static inline int
+_limiter_cell (Parameters * pv, int nc)
+{
+  int i, imax;
+  JBDOUBLE k, kmax;
+  for (i = imax = 0, kmax = -INFINITY; i <= nc; ++i)
+    {
+#if TMAX == TMAX_POINT
+      k = pv[i].lmax / pv[i].dx;
+#else
+      if (i == pv[i].channel->i2)
+        continue;
+      k = fmax (pv[i].lmax, pv[i + 1].lmax) / pv[i].ix;
+#endif
+      if (k > kmax)
+        {
+          kmax = k;
+          imax = i;
+        }
+    }
+  return imax;
+}
+
+#if INLINE_LIMITER_CELL
+#define limiter_cell _limiter_cell
+#else
+int limiter_cell (Parameters *, int);
+#endif
+
+static inline int
+_limiter_friction (Parameters * pv, int nc)
+{
+  int i, imin;
+  for (i = imin = 0; ++i <= nc;)
+    if (pv[i].dt < pv[imin].dt)
+      imin = i;
+  return imin;
+}
+
+#if INLINE_LIMITER_FRICTION
+#define limiter_friction _limiter_friction
+#else
+int limiter_friction (Parameters *, int);
+#endif
+
+static inline void
+_limiter_step (Limiter * lm, Parameters * pv, int nc)
+{
+  if (!lm->cell)
+    return;
+  ++lm->nsteps;
+  switch (lm->type)
+    {
+    case LIMITER_TYPE_CELL:
+      ++lm->cell[limiter_cell (pv, nc)];
+      break;
+    case LIMITER_TYPE_FRICTION:
+      ++lm->friction[limiter_friction (pv, nc)];
+      break;
+    case LIMITER_TYPE_BOUNDARY:
+      ++lm->boundary[lm->index];
+      break;
+    case LIMITER_TYPE_SECTION_CHANGES:
+      ++lm->changes[lm->channel];
+      break;
+    case LIMITER_TYPE_SECTION_GAUGE:
+      ++lm->gauge[lm->channel];
+      break;
+    case LIMITER_TYPE_OBSERVATION:
+      ++lm->observation;
+      break;
+    default:
+      ++lm->output[lm->index];
+    }
+}
+
+#if INLINE_LIMITER_STEP
+#define limiter_step _limiter_step
+#else
+void limiter_step (Limiter *, Parameters *, int);
+#endif
+
+static inline int
+limiter_event_compare (const void *a, const void *b)
+{
+  register const LimiterEvent *ea = (const LimiterEvent *) a,
+    *eb = (const LimiterEvent *) b;
+  if (ea->steps != eb->steps)
+    return eb->steps - ea->steps;
+  if (ea->type != eb->type)
+    return ea->type - eb->type;
+  if (ea->channel != eb->channel)
+    return ea->channel - eb->channel;
+  return ea->index - eb->index;
+}
+
+static inline int
+_limiter_rank (Limiter * lm, LimiterEvent ** event)
+{
+  int i, j, k, l, ne;
+  LimiterEvent *e;
+  ne = (lm->observation > 0);
+  for (i = 0; i < lm->ncells; ++i)
+    ne += (lm->cell[i] > 0) + (lm->friction[i] > 0);
+  for (i = 0; i < lm->nboundaries; ++i)
+    ne += (lm->boundary[i] > 0);
+  for (i = 0; i < lm->nchannels; ++i)
+    ne += (lm->changes[i] > 0) + (lm->gauge[i] > 0);
+  for (i = 0; i < lm->noutputs; ++i)
+    ne += (lm->output[i] > 0);
+  *event = e = (LimiterEvent *) g_try_malloc ((ne + 1) * sizeof (LimiterEvent));
+  if (!e)
+    {
+      jbw_show_error2 (gettext ("Time step limits"),
+                       gettext ("Not enough memory"));
+      return -1;
+    }
+  for (i = 0; i < lm->ncells; ++i)
+    {
+      j = p[i].channel - sys->channel;
+      if (lm->cell[i] > 0)
+        {
+          e->steps = lm->cell[i];
+          e->type = LIMITER_TYPE_CELL;
+          e->channel = j;
+          e++->index = i - p[i].channel->i;
+        }
+      if (lm->friction[i] > 0)
+        {
+          e->steps = lm->friction[i];
+          e->type = LIMITER_TYPE_FRICTION;
+          e->channel = j;
+          e++->index = i - p[i].channel->i;
+        }
+    }
+  for (i = k = 0; i < lm->nchannels; ++i)
+    for (l = 0; l <= sys->channel[i].n; ++l, ++k)
+      if (lm->boundary[k] > 0)
+        {
+          e->steps = lm->boundary[k];
+          e->type = LIMITER_TYPE_BOUNDARY;
+          e->channel = i;
+          e++->index = l;
+        }
+  for (i = 0; i < lm->nchannels; ++i)
+    {
+      if (lm->changes[i] > 0)
+        {
+          e->steps = lm->changes[i];
+          e->type = LIMITER_TYPE_SECTION_CHANGES;
+          e->channel = i;
+          e++->index = -1;
+        }
+      if (lm->gauge[i] > 0)
+        {
+          e->steps = lm->gauge[i];
+          e->type = LIMITER_TYPE_SECTION_GAUGE;
+          e->channel = i;
+          e++->index = -1;
+        }
+    }
+  if (lm->observation > 0)
+    {
+      e->steps = lm->observation;
+      e->type = LIMITER_TYPE_OBSERVATION;
+      e->channel = -1;
+      e++->index = -1;
+    }
+  for (i = 0; i < lm->noutputs; ++i)
+    if (lm->output[i] > 0)
+      {
+        e->steps = lm->output[i];
+        e->type = LIMITER_TYPE_OUTPUT;
+        e->channel = -1;
+        e++->index = i;
+      }
+  qsort (*event, ne, sizeof (LimiterEvent), limiter_event_compare);
+  return ne;
+}
+
+#if INLINE_LIMITER_RANK
+#define limiter_rank _limiter_rank
+#else
+int limiter_rank (Limiter *, LimiterEvent **);
+#endif
+
+static inline void
+_limiter_event_print (LimiterEvent * e, int nsteps, FILE * file)
+{
+  Channel *channel;
+  fprintf (file, "%7.2f%% %10d %s", 100. * e->steps / nsteps, e->steps,
+           limiter_type_name[e->type]);
+  if (e->channel >= 0)
+    {
+      channel = sys->channel + e->channel;
+      if (e->type == LIMITER_TYPE_BOUNDARY)
+        fprintf (file, " %d (%s)", e->index, channel->bf[e->index].name);
+      else if (e->index >= 0)
+        fprintf (file, " %d", e->index);
+      fprintf (file, " channel %s", channel->name);
+    }
+  else if (e->type == LIMITER_TYPE_OUTPUT)
+    fprintf (file, " %s", sys->output[e->index].name);
+  fprintf (file, "\n");
+}
+
+#if INLINE_LIMITER_EVENT_PRINT
+#define limiter_event_print _limiter_event_print
+#else
+void limiter_event_print (LimiterEvent *, int, FILE *);
+#endif
+
+static inline void
+_limiter_print (Limiter * lm, FILE * file, int nmax)
+{
+  int i, ne, steps[LIMITER_TYPES];
+  LimiterEvent *event;
+#if DEBUG_LIMITER_PRINT
+  fprintf (stderr, "limiter_print: start\n");
+#endif
+  if (!lm->cell || lm->nsteps <= 0)
+    goto exit0;
+  ne = limiter_rank (lm, &event);
+  if (ne < 0)
+    goto exit0;
+  fprintf (file, "Time step limits steps=%d\n", lm->nsteps);
+  memset (steps, 0, LIMITER_TYPES * sizeof (int));
+  for (i = 0; i < ne; ++i)
+    steps[event[i].type] += event[i].steps;
+  for (i = 0; i < LIMITER_TYPES; ++i)
+    if (steps[i] > 0)
+      fprintf (file, "%-16s %10d %7.2f%%\n", limiter_type_name[i], steps[i],
+               100. * steps[i] / lm->nsteps);
+  if (nmax < 0 || nmax > ne)
+    nmax = ne;
+  for (i = 0; i < nmax; ++i)
+    limiter_event_print (event + i, lm->nsteps, file);
+  g_free (event);
+exit0:
+#if DEBUG_LIMITER_PRINT
+  fprintf (stderr, "limiter_print: end\n");
+#endif
+  return;
+}
+
+#if INLINE_LIMITER_PRINT
+#define limiter_print _limiter_print
+#else
+void limiter_print (Limiter *, FILE *, int);
+#endif
+
+static inline int
+_limiter_save (Limiter * lm, char *path)
+{
+  FILE *file;
+#if DEBUG_LIMITER_SAVE
+  fprintf (stderr, "limiter_save: start\n");
+#endif
+  file = g_fopen (path, "w");
+  if (!file)
+    {
+      jbw_show_error2 (path, gettext ("Unable to open the file"));
+#if DEBUG_LIMITER_SAVE
+      fprintf (stderr, "limiter_save: end\n");
+#endif
+      return 0;
+    }
+  limiter_print (lm, file, -1);
+  fclose (file);
+#if DEBUG_LIMITER_SAVE
+  fprintf (stderr, "limiter_save: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_LIMITER_SAVE
+#define limiter_save _limiter_save
+#else
+int limiter_save (Limiter *, char *);
+#endif
+
+static inline void
+_limiter_close (Limiter * lm)
+{
+#if DEBUG_LIMITER_CLOSE
+  fprintf (stderr, "limiter_close: start\n");
+#endif
+  jb_free_null ((void **) &lm->cell);
+#if DEBUG_LIMITER_CLOSE
+  fprintf (stderr, "limiter_close: end\n");
+#endif
+}
+
+#if INLINE_LIMITER_CLOSE
+#define limiter_close _limiter_close
+#else
+void limiter_close (Limiter *);
+#endif
+
+#endif
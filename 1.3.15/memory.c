@@ -0,0 +1,113 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file memory.c
+ * \brief Source file to define the accounting of the memory used by the
+ *   simulation subsystems.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "memory.h"
+
+/**
+ * \fn void memory_open(Memory *mem)
+ * \brief Function to reset the memory accounting.
+ * \param mem
+ * \brief memory accounting.
+ */
+#if !INLINE_MEMORY_OPEN
+void
+memory_open (Memory * mem)
+{
+  _memory_open (mem);
+}
+#endif
+
+/**
+ * \fn void memory_account(Memory *mem, System *s, Parameters *pv, int nc, \
+ *   Junction *jn, int nj, int vs, Limiter *lm)
+ * \brief Function to account the memory used by every subsystem and to update
+ *   the peak.
+ * \param mem
+ * \brief memory accounting.
+ * \param s
+ * \brief system of channels.
+ * \param pv
+ * \brief array of flow parameters.
+ * \param nc
+ * \brief highest cell number.
+ * \param jn
+ * \brief array of junctions.
+ * \param nj
+ * \brief highest junction number.
+ * \param vs
+ * \brief size in bytes of the saved variables of a cell.
+ * \param lm
+ * \brief counters of the time step size limits.
+ */
+#if !INLINE_MEMORY_ACCOUNT
+void
+memory_account (Memory * mem, System * s, Parameters * pv, int nc,
+                Junction * jn, int nj, int vs, Limiter * lm)
+{
+  _memory_account (mem, s, pv, nc, jn, nj, vs, lm);
+}
+#endif
+
+/**
+ * \fn void memory_rss(Memory *mem)
+ * \brief Function to read the peak resident memory of the process.
+ * \param mem
+ * \brief memory accounting.
+ */
+#if !INLINE_MEMORY_RSS
+void
+memory_rss (Memory * mem)
+{
+  _memory_rss (mem);
+}
+#endif
+
+/**
+ * \fn void memory_print(Memory *mem, FILE *file)
+ * \brief Function to print the peak memory of every subsystem, the bytes per
+ *   cell and the linear model of the bytes per cell.
+ * \param mem
+ * \brief memory accounting.
+ * \param file
+ * \brief file.
+ */
+#if !INLINE_MEMORY_PRINT
+void
+memory_print (Memory * mem, FILE * file)
+{
+  _memory_print (mem, file);
+}
+#endif
@@ -0,0 +1,281 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file memory.h
+ * \brief Header file to define the accounting of the memory used by the
+ *   simulation subsystems.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef MEMORY__H
+#define MEMORY__H 1
+
+#include "limiter.h"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+/**
+ * \enum MemoryType
+ * \brief Enumeration to define the subsystems of the accounted memory.
+ * \var MEMORY_TYPE_PARAMETERS
+ * \brief flow parameters of the mesh cells.
+ * \var MEMORY_TYPE_SECTIONS
+ * \brief section parameters arrays of the mesh cells (shared arrays counted
+ * once).
+ * \var MEMORY_TYPE_FRICTION
+ * \brief friction parameters arrays of the mesh cells (shared arrays counted
+ * once).
+ * \var MEMORY_TYPE_TRANSPORT
+ * \brief transport parameters of the solutes in the mesh cells.
+ * \var MEMORY_TYPE_VARIABLES
+ * \brief buffers of the variables saved in the solution file.
+ * \var MEMORY_TYPE_JUNCTIONS
+ * \brief junctions.
+ * \var MEMORY_TYPE_MASS
+ * \brief mass balances.
+ * \var MEMORY_TYPE_LIMITER
+ * \brief counters of the time step size limits.
+ * \var MEMORY_TYPES
+ * \brief number of subsystems of the accounted memory.
+ */
+enum MemoryType
+{
+  MEMORY_TYPE_PARAMETERS = 0,
+  MEMORY_TYPE_SECTIONS = 1,
+  MEMORY_TYPE_FRICTION = 2,
+  MEMORY_TYPE_TRANSPORT = 3,
+  MEMORY_TYPE_VARIABLES = 4,
+  MEMORY_TYPE_JUNCTIONS = 5,
+  MEMORY_TYPE_MASS = 6,
+  MEMORY_TYPE_LIMITER = 7,
+  MEMORY_TYPES = 8
+};
+
+/**
+ * \struct Memory
+ * \brief Structure to account the memory used by the simulation subsystems.
+ */
+typedef struct
+{
+/**
+ * \var bytes
+ * \brief array of bytes used by every subsystem in the last account.
+ * \var peak
+ * \brief array of bytes used by every subsystem at the peak of the total.
+ * \var total
+ * \brief total bytes in the last account.
+ * \var peak_total
+ * \brief peak of the total bytes.
+ * \var rss
+ * \brief peak resident memory of the process in bytes or 0 if it is not
+ *   available.
+ * \var ncells
+ * \brief number of cells.
+ * \var nsolutes
+ * \brief number of solutes.
+ * \var nlevels
+ * \brief total number of section levels at the peak.
+ * \var maxlevels
+ * \brief maximum number of levels of a section at the peak.
+ */
+  size_t bytes[MEMORY_TYPES], peak[MEMORY_TYPES], total, peak_total, rss;
+  int ncells, nsolutes;
+  long int nlevels;
+  int maxlevels;
+} Memory;
+
+extern const char *memory_type_name[MEMORY_TYPES];
+
+static inline void
+_memory_open (Memory * mem)
+{
+#if DEBUG_MEMORY_OPEN
+  fprintf (stderr, "memory_open: start\n");
+#endif
+  memset (mem, 0, sizeof (Memory));
+#if DEBUG_MEMORY_OPEN
+  fprintf (stderr, "memory_open: end\n");
+#endif
+}
+
+#if INLINE_MEMORY_OPEN
+#define memory_open _memory_open
+#else
+void memory_open (Memory *);
+#endif
+
+static inline void
+_memory_account (Memory * mem, System * s, Parameters * pv, int nc,
+                 Junction * jn, int nj, int vs, Limiter * lm)
+{
+  int i, j, maxlevels;
+  long int nlevels;
+  size_t *b;
+#if DEBUG_MEMORY_ACCOUNT
+  fprintf (stderr, "memory_account: start\n");
+#endif
+  b = mem->bytes;
+  mem->ncells = nc + 1;
+  mem->nsolutes = s->nt + 1;
+  b[MEMORY_TYPE_PARAMETERS] = mem->ncells * sizeof (Parameters);
+  b[MEMORY_TYPE_SECTIONS] = b[MEMORY_TYPE_FRICTION] = 0;
+  for (i = maxlevels = 0, nlevels = 0; i <= nc; ++i)
+    {
+      j = pv[i].s->n + 1;
+      nlevels += j;
+      if (j > maxlevels)
+        maxlevels = j;
+      b[MEMORY_TYPE_SECTIONS] += j * sizeof (SectionParameters)
+        / (pv[i].s->rsp ? *pv[i].s->rsp : 1);
+      b[MEMORY_TYPE_FRICTION] += (pv[i].s->nf + 1)
+        * sizeof (FrictionParameters) / (pv[i].s->rfp ? *pv[i].s->rfp : 1);
+    }
+  b[MEMORY_TYPE_TRANSPORT] =
+    mem->nsolutes * mem->ncells * sizeof (TransportParameters);
+  b[MEMORY_TYPE_VARIABLES] = mem->ncells * vs;
+  b[MEMORY_TYPE_JUNCTIONS] = (nj + 1) * sizeof (Junction);
+  for (i = 0; i <= nj; ++i, ++jn)
+    {
+      j = jn->nparameters + 1;
+      b[MEMORY_TYPE_JUNCTIONS] += j * (sizeof (Parameters *)
+                                       + sizeof (TransportParameters *)
+                                       + sizeof (JBFLOAT))
+        + (jn->ninlets + jn->noutlets + 2) * sizeof (Channel *)
+        + (mem->nsolutes + 1) * sizeof (JBFLOAT);
+      if (jn->volume)
+        for (j = 0; j <= jn->nparameters; ++j)
+          b[MEMORY_TYPE_JUNCTIONS] +=
+            (jn->parameter[j]->s->n + 1) * sizeof (JunctionVolume);
+    }
+  b[MEMORY_TYPE_MASS] = (mem->nsolutes + 1) * sizeof (Mass);
+  b[MEMORY_TYPE_LIMITER] = lm->cell ? (2 * (lm->ncells + lm->nchannels)
+                                       + lm->nboundaries + lm->noutputs)
+    * sizeof (int) : 0;
+  for (i = 0, mem->total = 0; i < MEMORY_TYPES; ++i)
+    mem->total += b[i];
+  if (mem->total > mem->peak_total)
+    {
+      mem->peak_total = mem->total;
+      memcpy (mem->peak, b, MEMORY_TYPES * sizeof (size_t));
+      mem->nlevels = nlevels;
+      mem->maxlevels = maxlevels;
+    }
+#if DEBUG_MEMORY_ACCOUNT
+  fprintf (stderr, "MA total=%lu peak=%lu\n",
+           (unsigned long) mem->total, (unsigned long) mem->peak_total);
+  fprintf (stderr, "memory_account: end\n");
+#endif
+}
+
+#if INLINE_MEMORY_ACCOUNT
+#define memory_account _memory_account
+#else
+void memory_account (Memory *, System *, Parameters *, int, Junction *, int,
+                     int, Limiter *);
+#endif
+
+static inline void
+_memory_rss (Memory * mem)
+{
+#ifdef __linux__
+  struct rusage usage[1];
+#endif
+#if DEBUG_MEMORY_RSS
+  fprintf (stderr, "memory_rss: start\n");
+#endif
+  mem->rss = 0;
+#ifdef __linux__
+  if (!getrusage (RUSAGE_SELF, usage))
+    mem->rss = 1024 * (size_t) usage->ru_maxrss;
+#endif
+#if DEBUG_MEMORY_RSS
+  fprintf (stderr, "MR rss=%lu\n", (unsigned long) mem->rss);
+  fprintf (stderr, "memory_rss: end\n");
+#endif
+}
+
+#if INLINE_MEMORY_RSS
+#define memory_rss _memory_rss
+#else
+void memory_rss (Memory *);
+#endif
+
+static inline void
+_memory_print (Memory * mem, FILE * file)
+{
+  int i;
+  double cell, solute;
+#if DEBUG_MEMORY_PRINT
+  fprintf (stderr, "memory_print: start\n");
+#endif
+  fprintf (file, "Memory cells=%d solutes=%d peak=%lu rss_peak=%lu\n",
+           mem->ncells, mem->nsolutes, (unsigned long) mem->peak_total,
+           (unsigned long) mem->rss);
+  if (!mem->ncells)
+    goto exit0;
+  fprintf (file, "%-16s %14s %12s %9s\n",
+           "subsystem", "bytes", "bytes/cell", "fraction");
+  for (i = 0; i < MEMORY_TYPES; ++i)
+    fprintf (file, "%-16s %14lu %12.1f %8.2f%%\n", memory_type_name[i],
+             (unsigned long) mem->peak[i], (double) mem->peak[i] / mem->ncells,
+             mem->peak_total ? 100. * mem->peak[i] / mem->peak_total : 0.);
+  if (mem->rss > mem->peak_total)
+    fprintf (file, "%-16s %14lu %12.1f %8.2f%%\n", "unaccounted",
+             (unsigned long) (mem->rss - mem->peak_total),
+             (double) (mem->rss - mem->peak_total) / mem->ncells,
+             100. * (mem->rss - mem->peak_total) / mem->rss);
+
+  // Linear model of the bytes per cell: the flow terms depend on the mean
+  // number of section levels, every solute adds a fixed size per cell
+  solute = sizeof (TransportParameters) + sizeof (JBFLOAT);
+  cell = (double) (mem->peak_total - mem->peak[MEMORY_TYPE_JUNCTIONS]
+                   - mem->peak[MEMORY_TYPE_MASS]) / mem->ncells
+    - mem->nsolutes * solute;
+  fprintf (file, "Memory model bytes/cell=%.1f+%.1f*solutes "
+           "section_levels mean=%.1f max=%d\n", cell, solute,
+           (double) mem->nlevels / mem->ncells, mem->maxlevels);
+  fprintf (file, "Memory estimate 1e6 cells=%.0f\n",
+           1e6 * (cell + mem->nsolutes * solute));
+
+exit0:
+#if DEBUG_MEMORY_PRINT
+  fprintf (stderr, "memory_print: end\n");
+#endif
+}
+
+#if INLINE_MEMORY_PRINT
+#define memory_print _memory_print
+#else
+void memory_print (Memory *, FILE *);
+#endif
+
+#endif
@@ -135,6 +135,70 @@ initial_variables_open (Parameters * p, TransportParameters * tp,
 }
 #endif
 
+#if !INLINE_MESH_CACHE_KEY_ADD
+void
+mesh_cache_key_add (GChecksum * checksum, JBDOUBLE x)
+{
+  _mesh_cache_key_add (checksum, x);
+}
+#endif
+
+#if !INLINE_MESH_CACHE_KEY
+void
+mesh_cache_key (char *key, System * s, Parameters * p, int n)
+{
+  _mesh_cache_key (key, s, p, n);
+}
+#endif
+
+#if !INLINE_MESH_CACHE_CLOSE
+void
+mesh_cache_close (MeshCache * mc)
+{
+  _mesh_cache_close (mc);
+}
+#endif
+
+#if !INLINE_MESH_CACHE_OPEN
+int
+mesh_cache_open (MeshCache * mc, char *path, char *key, int n)
+{
+  return _mesh_cache_open (mc, path, key, n);
+}
+#endif
+
+#if !INLINE_MESH_CACHE_SECTION
+int
+mesh_cache_section (MeshCache * mc, Section * s, int i, SectionArena * arena)
+{
+  return _mesh_cache_section (mc, s, i, arena);
+}
+#endif
+
+#if !INLINE_MESH_CACHE_SAVE
+int
+mesh_cache_save (char *path, char *key, Parameters * p, int n)
+{
+  return _mesh_cache_save (path, key, p, n);
+}
+#endif
+
+#if !INLINE_MESH_PACK_SECTIONS
+int
+mesh_pack_sections (Parameters * p, int n, SectionArena * arena)
+{
+  return _mesh_pack_sections (p, n, arena);
+}
+#endif
+
+#if !INLINE_MESH_THREAD_ARENAS_DELETE
+void
+mesh_thread_arenas_delete ()
+{
+  _mesh_thread_arenas_delete ();
+}
+#endif
+
 #if !INLINE_PART_OPEN
 int
 part_open (int thread)
@@ -175,6 +239,14 @@ system_list ()
 }
 #endif
 
+#if !INLINE_MESH_PARTITION
+void
+mesh_partition (Parameters * p, int n)
+{
+  _mesh_partition (p, n);
+}
+#endif
+
 #if !INLINE_JUNCTION_PRINT
 void
 junction_print (Junction * junction, FILE * file)
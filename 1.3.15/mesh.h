@@ -39,6 +39,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "system.h"
 #include "channel_segment.h"
 #include "section_changes.h"
+#include "profile.h"
 
 /**
  * \def N_OF_VARIABLES
@@ -116,6 +117,61 @@ typedef struct
   JunctionVolume *volume;
 } Junction;
 
+/**
+ * \def MESH_CACHE_LABEL
+ * \brief Macro to define the label identifying the binary mesh cache files.
+ * \def MESH_CACHE_KEY_SIZE
+ * \brief Macro to define the size of the key identifying the mesh geometry.
+ */
+#define MESH_CACHE_LABEL "SWIGSMSH"
+#define MESH_CACHE_KEY_SIZE 64
+
+/**
+ * \struct MeshCacheHeader
+ * \brief Structure to define the header of a binary mesh cache file. It is
+ *   followed by the (n + 1) guint64 offsets of the cell sections and by the
+ *   sections, each one saved as its scalar fields followed by the section
+ *   parameters and the friction parameters arrays.
+ */
+typedef struct
+{
+/**
+ * \var label
+ * \brief MESH_CACHE_LABEL identifier.
+ * \var key
+ * \brief key of the mesh geometry.
+ * \var n
+ * \brief number of mesh cells.
+ * \var size_section
+ * \brief size in bytes of the scalar fields of a section.
+ * \var size_sp
+ * \brief size in bytes of a section parameters struct.
+ * \var size_fp
+ * \brief size in bytes of a friction parameters struct.
+ */
+  char label[8], key[MESH_CACHE_KEY_SIZE];
+  int n, size_section, size_sp, size_fp;
+} MeshCacheHeader;
+
+/**
+ * \struct MeshCache
+ * \brief Structure to define a binary mesh cache file mapped in memory.
+ */
+typedef struct
+{
+/**
+ * \var file
+ * \brief mapped file.
+ * \var data
+ * \brief mapped data.
+ * \var size
+ * \brief size in bytes of the mapped data.
+ */
+  GMappedFile *file;
+  char *data;
+  gsize size;
+} MeshCache;
+
 extern int nth, nthreads, *cell_thread;
 extern int n_open_sections;
 extern int n, njunctions, vsize;
@@ -126,6 +182,8 @@ extern Junction *junction;
 extern Variables v[1];
 extern Mass *m;
 extern GSList **list_channels;
+extern MeshCache mesh_cache[1];
+extern SectionArena mesh_arena[1], *thread_arena;
 
 #if JBW==JBW_GTK
 extern int n_open_sections;
@@ -623,6 +681,404 @@ void initial_variables_open (Parameters *, TransportParameters *, InitialFlow *,
                              ChannelTransport *, int, int *, int);
 #endif
 
+static inline void
+_mesh_cache_key_add (GChecksum * checksum, JBDOUBLE x)
+{
+  double y;
+  y = (double) x;
+  g_checksum_update (checksum, (const guchar *) &y, sizeof (double));
+}
+
+#if INLINE_MESH_CACHE_KEY_ADD
+#define mesh_cache_key_add _mesh_cache_key_add
+#else
+void mesh_cache_key_add (GChecksum *, JBDOUBLE);
+#endif
+
+static inline void
+_mesh_cache_key (char *key, System * s, Parameters * p, int n)
+{
+  int i, j, k, l;
+  char buffer[JB_BUFFER_SIZE];
+  GChecksum *checksum;
+  Channel *channel;
+  ChannelGeometry *cg;
+  CrossSection *cs;
+  TransientSection *ts;
+  SectionPoint2 *sp;
+#if DEBUG_MESH_CACHE_KEY
+  fprintf (stderr, "mesh_cache_key: start\n");
+#endif
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  snprintf (buffer, JB_BUFFER_SIZE, "%s %d %d %d %d %d %d %d %d",
+            MESH_CACHE_LABEL, (int) sizeof (JBFLOAT),
+            (int) sizeof (Section), (int) sizeof (SectionParameters),
+            (int) sizeof (FrictionParameters), MODEL_FRICTION,
+            MODEL_FRICTION_STRESS, MESH_BOUNDARY, n);
+  g_checksum_update (checksum, (const guchar *) buffer, strlen (buffer));
+  mesh_cache_key_add (checksum, friction_b);
+  mesh_cache_key_add (checksum, JBM_G);
+  mesh_cache_key_add (checksum, s->granulometric_coefficient);
+  mesh_cache_key_add (checksum, s->section_width_min);
+  for (i = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+    {
+      cg = channel->cg;
+      for (j = 0, cs = cg->cs; j <= cg->n; ++j, ++cs)
+        {
+          mesh_cache_key_add (checksum, cg->x[j]);
+          mesh_cache_key_add (checksum, cs->n);
+          mesh_cache_key_add (checksum, cs->type);
+          mesh_cache_key_add (checksum, cs->control);
+          mesh_cache_key_add (checksum, cs->control_channel);
+          mesh_cache_key_add (checksum, cs->control_section);
+          mesh_cache_key_add (checksum, cs->parameter);
+          mesh_cache_key_add (checksum, cs->time);
+          mesh_cache_key_add (checksum, cs->tolerance);
+          mesh_cache_key_add (checksum, cs->proportional);
+          mesh_cache_key_add (checksum, cs->integral);
+          for (k = 0, ts = cs->ts; k <= cs->n; ++k, ++ts)
+            {
+              mesh_cache_key_add (checksum, ts->n);
+              mesh_cache_key_add (checksum, ts->type);
+              mesh_cache_key_add (checksum, ts->t);
+              mesh_cache_key_add (checksum, ts->u);
+              mesh_cache_key_add (checksum, ts->contraction);
+              mesh_cache_key_add (checksum, ts->hmax);
+              mesh_cache_key_add (checksum, ts->dz);
+              mesh_cache_key_add (checksum, ts->zmin);
+              for (l = 0, sp = ts->sp; l <= ts->n; ++l, ++sp)
+                {
+                  mesh_cache_key_add (checksum, sp->y);
+                  mesh_cache_key_add (checksum, sp->z);
+                  mesh_cache_key_add (checksum, sp->r);
+                  mesh_cache_key_add (checksum, sp->t);
+                }
+            }
+        }
+    }
+  for (i = 0; i <= n; ++i, ++p)
+    {
+      mesh_cache_key_add (checksum, p->x);
+      mesh_cache_key_add (checksum, p->nchannel);
+      mesh_cache_key_add (checksum, p->nsegment);
+    }
+  memcpy (key, g_checksum_get_string (checksum), MESH_CACHE_KEY_SIZE);
+  g_checksum_free (checksum);
+#if DEBUG_MESH_CACHE_KEY
+  fprintf (stderr, "MCK key=%.64s\n", key);
+  fprintf (stderr, "mesh_cache_key: end\n");
+#endif
+}
+
+#if INLINE_MESH_CACHE_KEY
+#define mesh_cache_key _mesh_cache_key
+#else
+void mesh_cache_key (char *, System *, Parameters *, int);
+#endif
+
+static inline void
+_mesh_cache_close (MeshCache * mc)
+{
+#if DEBUG_MESH_CACHE_CLOSE
+  fprintf (stderr, "mesh_cache_close: start\n");
+#endif
+  if (mc->file)
+    g_mapped_file_unref (mc->file);
+  mc->file = NULL;
+  mc->data = NULL;
+  mc->size = 0;
+#if DEBUG_MESH_CACHE_CLOSE
+  fprintf (stderr, "mesh_cache_close: end\n");
+#endif
+}
+
+#if INLINE_MESH_CACHE_CLOSE
+#define mesh_cache_close _mesh_cache_close
+#else
+void mesh_cache_close (MeshCache *);
+#endif
+
+static inline int
+_mesh_cache_open (MeshCache * mc, char *path, char *key, int n)
+{
+  int i;
+  guint64 offset, size;
+  MeshCacheHeader header[1];
+  Section s[1];
+#if DEBUG_MESH_CACHE_OPEN
+  fprintf (stderr, "mesh_cache_open: start\n");
+#endif
+  mc->data = NULL;
+  mc->size = 0;
+  mc->file = g_mapped_file_new (path, FALSE, NULL);
+  if (!mc->file)
+    goto exit1;
+  mc->data = g_mapped_file_get_contents (mc->file);
+  mc->size = g_mapped_file_get_length (mc->file);
+  size = sizeof (MeshCacheHeader) + (n + 1) * sizeof (guint64);
+  if (mc->size < size)
+    goto exit0;
+  memcpy (header, mc->data, sizeof (MeshCacheHeader));
+  if (memcmp (header->label, MESH_CACHE_LABEL, 8)
+      || memcmp (header->key, key, MESH_CACHE_KEY_SIZE)
+      || header->n != n
+      || header->size_section != (size_t) & s->sp - (size_t) s
+      || header->size_sp != sizeof (SectionParameters)
+      || header->size_fp != sizeof (FrictionParameters))
+    goto exit0;
+  for (i = 0; i <= n; ++i)
+    {
+      memcpy (&offset, mc->data + sizeof (MeshCacheHeader)
+              + i * sizeof (guint64), sizeof (guint64));
+      if (offset < size || offset + header->size_section > mc->size)
+        goto exit0;
+      memcpy (s, mc->data + offset, header->size_section);
+      if (s->n < 0 || s->nf < 0
+          || offset + header->size_section
+          + (s->n + 1) * sizeof (SectionParameters)
+          + (s->nf + 1) * sizeof (FrictionParameters) > mc->size)
+        goto exit0;
+    }
+#if DEBUG_MESH_CACHE_OPEN
+  fprintf (stderr, "MCO %s loaded\n", path);
+  fprintf (stderr, "mesh_cache_open: end\n");
+#endif
+  return 1;
+
+exit0:
+  mesh_cache_close (mc);
+exit1:
+#if DEBUG_MESH_CACHE_OPEN
+  fprintf (stderr, "MCO %s not valid\n", path);
+  fprintf (stderr, "mesh_cache_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_MESH_CACHE_OPEN
+#define mesh_cache_open _mesh_cache_open
+#else
+int mesh_cache_open (MeshCache *, char *, char *, int);
+#endif
+
+static inline int
+_mesh_cache_section (MeshCache * mc, Section * s, int i, SectionArena * arena)
+{
+  int n, nf;
+  size_t size;
+  guint64 offset;
+  char *data;
+#if DEBUG_MESH_CACHE_SECTION
+  fprintf (stderr, "mesh_cache_section: start\n");
+#endif
+  memcpy (&offset, mc->data + sizeof (MeshCacheHeader) + i * sizeof (guint64),
+          sizeof (guint64));
+  data = mc->data + offset;
+  size = (size_t) & s->sp - (size_t) s;
+  memcpy (s, data, size);
+  n = s->n;
+  nf = s->nf;
+  if (!section_create (s, n, nf, arena))
+    {
+#if DEBUG_MESH_CACHE_SECTION
+      fprintf (stderr, "mesh_cache_section: end\n");
+#endif
+      return 0;
+    }
+  data += size;
+  size = (n + 1) * sizeof (SectionParameters);
+  memcpy (s->sp, data, size);
+  memcpy (s->fp, data + size, (nf + 1) * sizeof (FrictionParameters));
+#if DEBUG_MESH_CACHE_SECTION
+  fprintf (stderr, "MCS i=%d n=%d nf=%d\n", i, n, nf);
+  fprintf (stderr, "mesh_cache_section: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_MESH_CACHE_SECTION
+#define mesh_cache_section _mesh_cache_section
+#else
+int mesh_cache_section (MeshCache *, Section *, int, SectionArena *);
+#endif
+
+static inline int
+_mesh_cache_save (char *path, char *key, Parameters * p, int n)
+{
+  int i, k;
+  char *name;
+  guint64 *offset;
+  FILE *file;
+  MeshCacheHeader header[1];
+  Section *s;
+#if DEBUG_MESH_CACHE_SAVE
+  fprintf (stderr, "mesh_cache_save: start\n");
+#endif
+  k = 0;
+  offset = (guint64 *) g_try_malloc ((n + 1) * sizeof (guint64));
+  if (!offset)
+    goto exit2;
+  memset (header, 0, sizeof (MeshCacheHeader));
+  memcpy (header->label, MESH_CACHE_LABEL, 8);
+  memcpy (header->key, key, MESH_CACHE_KEY_SIZE);
+  header->n = n;
+  header->size_section = (size_t) & p->s->sp - (size_t) p->s;
+  header->size_sp = sizeof (SectionParameters);
+  header->size_fp = sizeof (FrictionParameters);
+  offset[0] = sizeof (MeshCacheHeader) + (n + 1) * sizeof (guint64);
+  for (i = 0; i < n; ++i)
+    {
+      s = p[i].s;
+      offset[i + 1] = offset[i] + header->size_section
+        + (s->n + 1) * sizeof (SectionParameters)
+        + (s->nf + 1) * sizeof (FrictionParameters);
+    }
+  name = g_strconcat (path, ".tmp", NULL);
+  file = g_fopen (name, "wb");
+  if (!file)
+    goto exit1;
+  fwrite (header, sizeof (MeshCacheHeader), 1, file);
+  fwrite (offset, sizeof (guint64), n + 1, file);
+  for (i = 0; i <= n; ++i)
+    {
+      s = p[i].s;
+      fwrite (s, header->size_section, 1, file);
+      fwrite (s->sp, sizeof (SectionParameters), s->n + 1, file);
+      fwrite (s->fp, sizeof (FrictionParameters), s->nf + 1, file);
+    }
+  k = !ferror (file);
+  if (fclose (file))
+    k = 0;
+  if (k && g_rename (name, path))
+    k = 0;
+  if (!k)
+    g_remove (name);
+
+exit1:
+  g_free (name);
+  g_free (offset);
+
+exit2:
+  if (!k)
+    jbw_show_warning (gettext ("Unable to save the mesh cache"));
+#if DEBUG_MESH_CACHE_SAVE
+  fprintf (stderr, "mesh_cache_save: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_MESH_CACHE_SAVE
+#define mesh_cache_save _mesh_cache_save
+#else
+int mesh_cache_save (char *, char *, Parameters *, int);
+#endif
+
+static inline int
+_mesh_pack_sections (Parameters * p, int n, SectionArena * arena)
+{
+  int i, k;
+  size_t size;
+  void *data;
+  GHashTable *tsp, *tfp;
+  Section *s, *s2;
+#if DEBUG_MESH_PACK_SECTIONS
+  fprintf (stderr, "mesh_pack_sections: start\n");
+#endif
+  tsp = g_hash_table_new (section_hash_parameters, section_equal_parameters);
+  tfp = g_hash_table_new (section_hash_friction, section_equal_friction);
+  for (i = 0, k = 1; i <= n; ++i)
+    {
+      s = p[i].s;
+      s2 = (Section *) g_hash_table_lookup (tsp, s);
+      if (s2)
+        {
+          if (!section_share (s, s2, 0))
+            goto exit2;
+        }
+      else
+        {
+          size = (s->n + 1) * sizeof (SectionParameters);
+          data = section_arena_alloc (arena, size);
+          if (!data)
+            goto exit1;
+          memcpy (data, s->sp, size);
+          section_release ((void **) &s->sp, &s->rsp,
+                           s->storage & SECTION_STORAGE_ARENA_PARAMETERS);
+          s->sp = (SectionParameters *) data;
+          s->storage |= SECTION_STORAGE_ARENA_PARAMETERS;
+          g_hash_table_add (tsp, s);
+        }
+      s2 = (Section *) g_hash_table_lookup (tfp, s);
+      if (s2)
+        {
+          if (!section_share (s, s2, 1))
+            goto exit2;
+        }
+      else
+        {
+          size = (s->nf + 1) * sizeof (FrictionParameters);
+          data = section_arena_alloc (arena, size);
+          if (!data)
+            goto exit1;
+          memcpy (data, s->fp, size);
+          section_release ((void **) &s->fp, &s->rfp,
+                           s->storage & SECTION_STORAGE_ARENA_FRICTION);
+          s->fp = (FrictionParameters *) data;
+          s->storage |= SECTION_STORAGE_ARENA_FRICTION;
+          g_hash_table_add (tfp, s);
+        }
+    }
+#if DEBUG_MESH_PACK_SECTIONS
+  fprintf (stderr, "MPS sections=%d parameters=%u friction=%u\n", n + 1,
+           g_hash_table_size (tsp), g_hash_table_size (tfp));
+#endif
+  goto exit0;
+
+exit1:
+  jbw_show_error2 (gettext ("Section"), gettext ("Not enough memory"));
+
+exit2:
+  k = 0;
+
+exit0:
+  g_hash_table_destroy (tfp);
+  g_hash_table_destroy (tsp);
+#if DEBUG_MESH_PACK_SECTIONS
+  fprintf (stderr, "mesh_pack_sections: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_MESH_PACK_SECTIONS
+#define mesh_pack_sections _mesh_pack_sections
+#else
+int mesh_pack_sections (Parameters *, int, SectionArena *);
+#endif
+
+static inline void
+_mesh_thread_arenas_delete ()
+{
+  int i;
+#if DEBUG_MESH_THREAD_ARENAS_DELETE
+  fprintf (stderr, "mesh_thread_arenas_delete: start\n");
+#endif
+  if (thread_arena)
+    {
+      for (i = 0; i < nth; ++i)
+        section_arena_delete (thread_arena + i);
+      jb_free_null ((void **) &thread_arena);
+    }
+#if DEBUG_MESH_THREAD_ARENAS_DELETE
+  fprintf (stderr, "mesh_thread_arenas_delete: end\n");
+#endif
+}
+
+#if INLINE_MESH_THREAD_ARENAS_DELETE
+#define mesh_thread_arenas_delete _mesh_thread_arenas_delete
+#else
+void mesh_thread_arenas_delete ();
+#endif
+
 static inline int
 _part_open (int thread)
 {
@@ -646,7 +1102,11 @@ _part_open (int thread)
   fprintf (stderr, "PO channel=%d\n", p[i].nchannel);
 #endif
   for (j = i, pv = p + i; j < i2; ++j, ++pv)
-    pv->s->sp = NULL, pv->s->fp = NULL;
+    {
+      pv->s->sp = NULL, pv->s->fp = NULL;
+      pv->s->rsp = pv->s->rfp = NULL;
+      pv->s->storage = 0;
+    }
   pv = p + i;
   channel = pv->channel;
 #if DEBUG_PART_OPEN
@@ -673,7 +1133,8 @@ _part_open (int thread)
 #if DEBUG_PART_OPEN
   fprintf (stderr, "PO opening channel segment\n");
 #endif
-  if (!channel_segment_open (seg, cs1->ts, cs2->ts, x[0], x[1]))
+  if (!mesh_cache->file
+      && !channel_segment_open (seg, cs1->ts, cs2->ts, x[0], x[1]))
     goto exit2;
 
   ifc = channel->ifc;
@@ -696,7 +1157,8 @@ _part_open (int thread)
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO deleting channel segment\n");
 #endif
-          channel_segment_delete (seg);
+          if (!mesh_cache->file)
+            channel_segment_delete (seg);
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO locating channel segment\n");
 #endif
@@ -720,18 +1182,27 @@ _part_open (int thread)
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO opening channel segment\n");
 #endif
-          if (!channel_segment_open (seg, cs1->ts, cs2->ts, x[0], x[1]))
+          if (!mesh_cache->file
+              && !channel_segment_open (seg, cs1->ts, cs2->ts, x[0], x[1]))
             goto exit2;
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO copying section\n");
 #endif
         }
-      if (j == cs1->i)
+      if (mesh_cache->file)
+        {
+#if DEBUG_PART_OPEN
+          fprintf (stderr, "PO loading cached section\n");
+#endif
+          if (!mesh_cache_section (mesh_cache, pv->s, j, thread_arena + thread))
+            goto exit1;
+        }
+      else if (j == cs1->i)
         {
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO copying section\n");
 #endif
-          if (!section_copy (pv->s, seg->s1))
+          if (!section_copy (pv->s, seg->s1, thread_arena + thread))
             goto exit1;
         }
       else if (j == cs2->i)
@@ -739,7 +1210,7 @@ _part_open (int thread)
 #if DEBUG_PART_OPEN
           fprintf (stderr, "PO copying section\n");
 #endif
-          if (!section_copy (pv->s, seg->s2))
+          if (!section_copy (pv->s, seg->s2, thread_arena + thread))
             goto exit1;
         }
       else
@@ -749,7 +1220,8 @@ _part_open (int thread)
           fprintf (stderr, "PO x1=" FWF " x2=" FWF "\n", seg->x1, seg->x2);
           fprintf (stderr, "PO x=" FWL "\n", pv->x);
 #endif
-          if (!channel_segment_open_section (seg, pv->s, pv->x))
+          if (!channel_segment_open_section
+              (seg, pv->s, pv->x, thread_arena + thread))
             goto exit1;
         }
       pv->channel = channel;
@@ -818,7 +1290,8 @@ _part_open (int thread)
 #if DEBUG_PART_OPEN
   fprintf (stderr, "PO destroying channel segment p=%ld\n", (size_t) p);
 #endif
-  channel_segment_delete (seg);
+  if (!mesh_cache->file)
+    channel_segment_delete (seg);
   pv = p + i;
   channel = pv->channel;
   for (j = i, --i2; j < i2; ++j, ++pv)
@@ -849,7 +1322,8 @@ exit1:
 #if DEBUG_PART_OPEN
   fprintf (stderr, "PO destroying channel segment\n");
 #endif
-  channel_segment_delete (seg);
+  if (!mesh_cache->file)
+    channel_segment_delete (seg);
 exit2:
 #if DEBUG_PART_OPEN
   fprintf (stderr, "part_open: end\n");
@@ -998,6 +1472,53 @@ exit_list:
 void system_list ();
 #endif
 
+static inline void
+_mesh_partition (Parameters * p, int n)
+{
+  int i, j, k;
+  char buffer[JB_BUFFER_SIZE];
+  Channel *channel;
+#if DEBUG_MESH_PARTITION
+  fprintf (stderr, "mesh_partition: start\n");
+#endif
+  // the subdomains start at the first cell of a channel or at an inner cell
+  // with two upstream and two downstream cells in the channel, so that the
+  // shared cells are updated as in the serial scheme, and have 3 cells at least
+  for (i = j = 1; i < nth; ++i)
+    {
+      k = cell_thread[i];
+      channel = p[k].channel;
+      if (k < channel->i + 3)
+        k = channel->i;
+      else if (k > channel->i2 - 2)
+        k = channel->i2 + 1;
+#if DEBUG_MESH_PARTITION
+      fprintf (stderr, "MP i=%d cell=%d k=%d\n", i, cell_thread[i], k);
+#endif
+      if (k >= cell_thread[j - 1] + 3 && k <= n - 2)
+        cell_thread[j++] = k;
+    }
+  cell_thread[j] = n + 1;
+  if (j < nth)
+    {
+      snprintf (buffer, JB_BUFFER_SIZE,
+                gettext ("Threads reduced from %d to %d to fit the channels"),
+                nth, j);
+      jbw_show_warning (buffer);
+    }
+  nth = j;
+#if DEBUG_MESH_PARTITION
+  fprintf (stderr, "MP nthreads=%d\n", nth);
+  fprintf (stderr, "mesh_partition: end\n");
+#endif
+}
+
+#if INLINE_MESH_PARTITION
+#define mesh_partition _mesh_partition
+#else
+void mesh_partition (Parameters *, int);
+#endif
+
 static inline void
 _junction_print (Junction * junction, FILE * file)
 {
@@ -1653,16 +2174,17 @@ _mesh_delete (System * system, Parameters ** p,
         section_delete ((*p)[i].s);
       jb_free_null ((void **) p);
     }
+  section_arena_delete (mesh_arena);
   jb_free_null ((void **) tp);
   jb_free_null ((void **) &v->x);
   if (*junction)
     junctions_delete (junction, njunctions);
   jb_free_null ((void **) m);
-  for (i = 0, channel = system->channel; i <= system->n; ++i)
+  for (i = 0, channel = system->channel; i <= system->n; ++i, ++channel)
     {
       jb_slist_free (&channel->list_section_changes);
       jb_slist_free (&channel->list_section_gauge);
-      jb_slist_free (&channel->list_variable_segments);
+      list_variable_segments_delete (&channel->list_variable_segments);
     }
   *n = *njunctions = -1;
 #if DEBUG_MESH_DELETE
@@ -1683,7 +2205,7 @@ static inline int _mesh_open
 {
   int i, j, k, l;
   register JBDOUBLE r, dx;
-  char *me;
+  char *me, key[MESH_CACHE_KEY_SIZE];
   JBFLOAT *x, *li;
   GThread *thread[nth];
   CrossSection *cs;
@@ -1880,6 +2402,17 @@ static inline int _mesh_open
         {
           bf->i = cs[bf->pos].i;
           bf->i2 = cs[bf->pos2].i;
+          bf->mass = 0.;
+          series_cursor_reset (bf->cursor);
+          series_cursor_reset (bf->cursor + 1);
+          if (bf->series->name
+              && (!series_file_open (bf->series, system->directory)
+                  || !boundary_flow_window (bf, system->initial_time,
+                                            system->initial_time)))
+            {
+              me = gettext ("Bad boundary file");
+              goto error3;
+            }
 #if DEBUG_MESH_OPEN
           fprintf (stderr, "MO channel=%d pos=%d pos2=%d i=%d i2=%d\n",
                    i, bf->pos, bf->pos2, bf->i, bf->i2);
@@ -1920,6 +2453,16 @@ static inline int _mesh_open
           {
             bt->i = cs[bt->pos].i;
             bt->i2 = cs[bt->pos2].i;
+            bt->mass = 0.;
+            series_cursor_reset (bt->cursor);
+            if (bt->series->name
+                && (!series_file_open (bt->series, system->directory)
+                    || !boundary_transport_window (bt, system->initial_time,
+                                                   system->initial_time)))
+              {
+                me = gettext ("Bad boundary file");
+                goto error3;
+              }
             for (l = bt->i, bt->length = (*p)[l].dx; ++l <= bt->i2;)
               bt->length += (*p)[l].dx;
 #if DEBUG_MESH_OPEN
@@ -1942,6 +2485,10 @@ static inline int _mesh_open
 #endif
       if (!list_variable_segments_open (&channel->list_variable_segments, cg))
         goto error2;
+      list_section_gauge_link
+        (channel->list_section_gauge, channel->list_variable_segments);
+      list_section_changes_link
+        (channel->list_section_changes, channel->list_variable_segments);
     }
 
   if (!variables_create (v, *n, vsize, system->channel->nt))
@@ -1981,6 +2528,15 @@ static inline int _mesh_open
         goto error3;
     }
 
+  if (system->mesh_cache_path)
+    {
+#if DEBUG_MESH_OPEN
+      fprintf (stderr, "MO opening mesh cache\n");
+#endif
+      mesh_cache_key (key, system, *p, *n);
+      mesh_cache_open (mesh_cache, system->mesh_cache_path, key, *n);
+    }
+
 #if DEBUG_MESH_OPEN
   fprintf (stderr, "MO opening sections and variables\n");
 #endif
@@ -1990,6 +2546,17 @@ static inline int _mesh_open
     goto error3;
   for (i = nth + 1; --i >= 0;)
     cell_thread[i] = i * (*n + 1) / nth;
+  thread_arena = (SectionArena *) g_try_malloc (nth * sizeof (SectionArena));
+  if (!thread_arena)
+    goto error3;
+  for (i = 0; i < nth; ++i)
+    section_arena_init_empty (thread_arena + i);
+  if (!mesh_cache->file)
+    {
+      section_memo_open ();
+      section_pair_memo_open ();
+    }
+  mesh_partition (*p, *n);
 #if DEBUG_MESH_OPEN
   fprintf (stderr, "MO nthreads=%d\n", nth);
   for (i = 0; i <= nth; ++i)
@@ -2041,6 +2608,21 @@ static inline int _mesh_open
         }
     }
 
+  section_pair_memo_close ();
+  section_memo_close ();
+  if (!mesh_pack_sections (*p, *n, mesh_arena))
+    goto error2;
+  mesh_thread_arenas_delete ();
+  if (mesh_cache->file)
+    mesh_cache_close (mesh_cache);
+  else if (system->mesh_cache_path)
+    {
+#if DEBUG_MESH_OPEN
+      fprintf (stderr, "MO saving mesh cache\n");
+#endif
+      mesh_cache_save (system->mesh_cache_path, key, *p, *n);
+    }
+
 #if DEBUG_MESH_OPEN
   fprintf (stderr, "MO system list\n");
 #endif
@@ -2075,10 +2657,14 @@ error3:
   jbw_show_error2 (gettext ("Mesh"), me);
 
 error2:
+  mesh_cache_close (mesh_cache);
 #if DEBUG_MESH_OPEN
   fprintf (stderr, "MO deleting mesh\n");
 #endif
+  section_pair_memo_close ();
+  section_memo_close ();
   mesh_delete (system, p, tp, v, junction, m, n, njunctions);
+  mesh_thread_arenas_delete ();
 #if DEBUG_MESH_OPEN
   fprintf (stderr, "mesh_open: end\n");
 #endif
@@ -0,0 +1,189 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file output.c
+ * \brief Source file to define selective output structures and functions.
+ * \authors Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa.
+ */
+#include "output.h"
+
+/**
+ * \fn void output_print(Output *o, FILE *file)
+ * \brief Function to print an Output structure in a file.
+ * \param o
+ * \brief Output structure.
+ * \param file
+ * \brief file.
+ */
+#if !INLINE_OUTPUT_PRINT
+void
+output_print (Output * o, FILE * file)
+{
+  _output_print (o, file);
+}
+#endif
+
+/**
+ * \fn void output_error(Output *o, char *m)
+ * \brief Function to write an error message opening an Output structure.
+ * \param o
+ * \brief Output structure.
+ * \param m
+ * \brief error message.
+ */
+#if !INLINE_OUTPUT_ERROR
+void
+output_error (Output * o, char *m)
+{
+  _output_error (o, m);
+}
+#endif
+
+/**
+ * \fn void output_delete(Output *o)
+ * \brief Function to delete an Output structure.
+ * \param o
+ * \brief Output structure.
+ */
+#if !INLINE_OUTPUT_DELETE
+void
+output_delete (Output * o)
+{
+  _output_delete (o);
+}
+#endif
+
+/**
+ * \fn void output_init_empty(Output *o)
+ * \brief Function to init an empty Output structure.
+ * \param o
+ * \brief Output structure.
+ */
+#if !INLINE_OUTPUT_INIT_EMPTY
+void
+output_init_empty (Output * o)
+{
+  _output_init_empty (o);
+}
+#endif
+
+/**
+ * \fn int output_copy(Output *o, Output *o_copy)
+ * \brief Function to copy two Output structures.
+ * \param o
+ * \brief Output structure copy.
+ * \param o_copy
+ * \brief Output structure copied.
+ * \return 0 on error, 1 on success.
+ */
+#if !INLINE_OUTPUT_COPY
+int
+output_copy (Output * o, Output * o_copy)
+{
+  return _output_copy (o, o_copy);
+}
+#endif
+
+/**
+ * \fn int output_variable(char *name, Transport *transport, int nt)
+ * \brief Function to get the number of a variable from its name.
+ * \param name
+ * \brief variable name.
+ * \param transport
+ * \brief array of transported solutes.
+ * \param nt
+ * \brief number of transported solutes.
+ * \return variable number on success, -1 on error.
+ */
+#if !INLINE_OUTPUT_VARIABLE
+int
+output_variable (char *name, Transport * transport, int nt)
+{
+  return _output_variable (name, transport, nt);
+}
+#endif
+
+/**
+ * \fn const char *output_variable_name(int variable, Transport *transport)
+ * \brief Function to get the name of a variable from its number.
+ * \param variable
+ * \brief variable number.
+ * \param transport
+ * \brief array of transported solutes.
+ * \return variable name.
+ */
+#if !INLINE_OUTPUT_VARIABLE_NAME
+const char *
+output_variable_name (int variable, Transport * transport)
+{
+  return _output_variable_name (variable, transport);
+}
+#endif
+
+/**
+ * \fn int output_open_xml(Output *o, xmlNode *node, Transport *transport, \
+ *   int nt)
+ * \brief Function to open an Output structure on a XML node.
+ * \param o
+ * \brief Output structure.
+ * \param node
+ * \brief XML node.
+ * \param transport
+ * \brief array of transported solutes.
+ * \param nt
+ * \brief number of transported solutes.
+ * \return 0 on error, 1 on success.
+ */
+#if !INLINE_OUTPUT_OPEN_XML
+int
+output_open_xml (Output * o, xmlNode * node, Transport * transport, int nt)
+{
+  return _output_open_xml (o, node, transport, nt);
+}
+#endif
+
+/**
+ * \fn void output_save_xml(Output *o, xmlNode *node, Transport *transport)
+ * \brief Function to save an Output structure on a XML node.
+ * \param o
+ * \brief Output structure.
+ * \param node
+ * \brief XML node.
+ * \param transport
+ * \brief array of transported solutes.
+ */
+#if !INLINE_OUTPUT_SAVE_XML
+void
+output_save_xml (Output * o, xmlNode * node, Transport * transport)
+{
+  _output_save_xml (o, node, transport);
+}
+#endif
@@ -0,0 +1,531 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file output.h
+ * \brief Header file to define selective output structures and functions.
+ * \authors Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa.
+ */
+#ifndef OUTPUT__H
+#define OUTPUT__H 1
+
+#include "transport.h"
+
+/**
+ * \enum OutputVariable
+ * \brief Enumeration to define the variables saved in a selective output.
+ * \var OUTPUT_VARIABLE_X
+ * \brief position.
+ * \var OUTPUT_VARIABLE_Q
+ * \brief discharge.
+ * \var OUTPUT_VARIABLE_ZS
+ * \brief surface level.
+ * \var OUTPUT_VARIABLE_A
+ * \brief wetted cross sectional area.
+ * \var OUTPUT_VARIABLE_B
+ * \brief surface width.
+ * \var OUTPUT_VARIABLE_ZB
+ * \brief bottom level.
+ * \var OUTPUT_VARIABLE_ZMAX
+ * \brief maximum level of the cross section.
+ * \var OUTPUT_VARIABLE_BETA
+ * \brief Coriolis coefficient.
+ * \var OUTPUT_VARIABLE_SOLUTE
+ * \brief concentration of the first solute, the next solutes follow.
+ */
+enum OutputVariable
+{
+  OUTPUT_VARIABLE_X = 0,
+  OUTPUT_VARIABLE_Q = 1,
+  OUTPUT_VARIABLE_ZS = 2,
+  OUTPUT_VARIABLE_A = 3,
+  OUTPUT_VARIABLE_B = 4,
+  OUTPUT_VARIABLE_ZB = 5,
+  OUTPUT_VARIABLE_ZMAX = 6,
+  OUTPUT_VARIABLE_BETA = 7,
+  OUTPUT_VARIABLE_SOLUTE = 8
+};
+
+/**
+ * \struct Output
+ * \brief Structure to define a selective output of some variables in some
+ *   mesh cells of a channel.
+ *
+ * The binary output file starts with the number of variables, the number of
+ *   mesh cells and the array of variable numbers (int). Then, for every saved
+ *   time, a JBDOUBLE with the time is followed by the JBFLOAT values of every
+ *   variable in the mesh cells.
+ */
+typedef struct
+{
+/**
+ * \var interval
+ * \brief time interval to save the variables (0 to use the measured interval).
+ * \var t
+ * \brief next time to save the variables.
+ * \var nvariables
+ * \brief number of saved variables.
+ * \var variable
+ * \brief array of saved variable numbers.
+ * \var ichannel
+ * \brief channel number.
+ * \var pos
+ * \brief initial cross section number.
+ * \var pos2
+ * \brief final cross section number.
+ * \var i
+ * \brief initial mesh cell.
+ * \var i2
+ * \brief final mesh cell.
+ * \var data
+ * \brief array to build a record.
+ * \var file
+ * \brief output file.
+ * \var name
+ * \brief output file name.
+ * \var channel
+ * \brief channel name.
+ * \var section
+ * \brief initial cross section name (NULL for the channel inlet).
+ * \var section2
+ * \brief final cross section name (NULL for the channel outlet).
+ */
+  JBDOUBLE interval, t;
+  int nvariables, *variable, ichannel, pos, pos2, i, i2;
+  JBFLOAT *data;
+  FILE *file;
+  char *name, *channel, *section, *section2;
+} Output;
+
+static inline void
+_output_print (Output * o, FILE * file)
+{
+  int i;
+  fprintf (file, "output_print: start\n");
+  fprintf (file, "OP name=%s channel=%s\n", o->name, o->channel);
+  if (o->section)
+    fprintf (file, "OP section=%s\n", o->section);
+  if (o->section2)
+    fprintf (file, "OP section2=%s\n", o->section2);
+  fprintf (file, "OP interval=" FWL " nvariables=%d\n",
+           o->interval, o->nvariables);
+  for (i = 0; i < o->nvariables; ++i)
+    fprintf (file, "OP variable%d=%d\n", i, o->variable[i]);
+  fprintf (file, "output_print: end\n");
+}
+
+#if INLINE_OUTPUT_PRINT
+#define output_print _output_print
+#else
+void output_print (Output *, FILE *);
+#endif
+
+static inline void
+_output_error (Output * o, char *m)
+{
+  char *buffer;
+#if DEBUG_OUTPUT_ERROR
+  fprintf (stderr, "output_error: start\n");
+#endif
+  buffer = message;
+  message = g_strconcat (gettext ("Output"), ": ", o->name, "\n", m, NULL);
+  g_free (buffer);
+#if DEBUG_OUTPUT_ERROR
+  fprintf (stderr, "output_error: end\n");
+#endif
+}
+
+#if INLINE_OUTPUT_ERROR
+#define output_error _output_error
+#else
+void output_error (Output *, char *);
+#endif
+
+static inline void
+_output_delete (Output * o)
+{
+#if DEBUG_OUTPUT_DELETE
+  fprintf (stderr, "output_delete: start\n");
+#endif
+  jb_free_null ((void **) &o->variable);
+  jb_free_null ((void **) &o->name);
+  jb_free_null ((void **) &o->channel);
+  jb_free_null ((void **) &o->section);
+  jb_free_null ((void **) &o->section2);
+#if DEBUG_OUTPUT_DELETE
+  fprintf (stderr, "output_delete: end\n");
+#endif
+}
+
+#if INLINE_OUTPUT_DELETE
+#define output_delete _output_delete
+#else
+void output_delete (Output *);
+#endif
+
+static inline void
+_output_init_empty (Output * o)
+{
+#if DEBUG_OUTPUT_INIT_EMPTY
+  fprintf (stderr, "output_init_empty: start\n");
+#endif
+  o->nvariables = 0;
+  o->variable = NULL;
+  o->data = NULL;
+  o->file = NULL;
+  o->name = o->channel = o->section = o->section2 = NULL;
+#if DEBUG_OUTPUT_INIT_EMPTY
+  fprintf (stderr, "output_init_empty: end\n");
+#endif
+}
+
+#if INLINE_OUTPUT_INIT_EMPTY
+#define output_init_empty _output_init_empty
+#else
+void output_init_empty (Output *);
+#endif
+
+static inline int
+_output_copy (Output * o, Output * o_copy)
+{
+#if DEBUG_OUTPUT_COPY
+  fprintf (stderr, "output_copy: start\n");
+  output_print (o_copy, stderr);
+#endif
+
+  if (o == o_copy)
+    goto exit0;
+
+  output_init_empty (o);
+  o->name = jb_strdup (o_copy->name);
+  o->channel = jb_strdup (o_copy->channel);
+  if (!o->name || !o->channel)
+    goto exit1;
+  if (o_copy->section)
+    {
+      o->section = jb_strdup (o_copy->section);
+      if (!o->section)
+        goto exit1;
+    }
+  if (o_copy->section2)
+    {
+      o->section2 = jb_strdup (o_copy->section2);
+      if (!o->section2)
+        goto exit1;
+    }
+  o->variable = (int *) g_try_malloc (o_copy->nvariables * sizeof (int));
+  if (!o->variable)
+    goto exit1;
+  memcpy (o->variable, o_copy->variable, o_copy->nvariables * sizeof (int));
+  o->nvariables = o_copy->nvariables;
+  o->interval = o_copy->interval;
+  o->ichannel = o_copy->ichannel;
+  o->pos = o_copy->pos;
+  o->pos2 = o_copy->pos2;
+
+exit0:
+#if DEBUG_OUTPUT_COPY
+  output_print (o, stderr);
+  fprintf (stderr, "output_copy: end\n");
+#endif
+  return 1;
+
+exit1:
+  output_delete (o);
+  message = g_strconcat (gettext ("Output"), ": ", o_copy->name, "\n",
+                         gettext ("Not enough memory"), NULL);
+#if DEBUG_OUTPUT_COPY
+  fprintf (stderr, "output_copy: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_OUTPUT_COPY
+#define output_copy _output_copy
+#else
+int output_copy (Output *, Output *);
+#endif
+
+static inline int
+_output_variable (char *name, Transport * transport, int nt)
+{
+  int i;
+#if DEBUG_OUTPUT_VARIABLE
+  fprintf (stderr, "output_variable: start\n");
+  fprintf (stderr, "OV name=%s\n", name);
+#endif
+  if (!strcmp (name, "x"))
+    i = OUTPUT_VARIABLE_X;
+  else if (!strcmp (name, "Q"))
+    i = OUTPUT_VARIABLE_Q;
+  else if (!strcmp (name, "zs"))
+    i = OUTPUT_VARIABLE_ZS;
+  else if (!strcmp (name, "A"))
+    i = OUTPUT_VARIABLE_A;
+  else if (!strcmp (name, "B"))
+    i = OUTPUT_VARIABLE_B;
+  else if (!strcmp (name, "zb"))
+    i = OUTPUT_VARIABLE_ZB;
+  else if (!strcmp (name, "zmax"))
+    i = OUTPUT_VARIABLE_ZMAX;
+  else if (!strcmp (name, "beta"))
+    i = OUTPUT_VARIABLE_BETA;
+  else
+    {
+      for (i = 0; i <= nt; ++i)
+        if (!strcmp (name, transport[i].name))
+          break;
+      if (i > nt)
+        i = -1;
+      else
+        i += OUTPUT_VARIABLE_SOLUTE;
+    }
+#if DEBUG_OUTPUT_VARIABLE
+  fprintf (stderr, "OV variable=%d\n", i);
+  fprintf (stderr, "output_variable: end\n");
+#endif
+  return i;
+}
+
+#if INLINE_OUTPUT_VARIABLE
+#define output_variable _output_variable
+#else
+int output_variable (char *, Transport *, int);
+#endif
+
+static inline const char *
+_output_variable_name (int variable, Transport * transport)
+{
+  const char *name;
+#if DEBUG_OUTPUT_VARIABLE_NAME
+  fprintf (stderr, "output_variable_name: start\n");
+#endif
+  switch (variable)
+    {
+    case OUTPUT_VARIABLE_X:
+      name = "x";
+      break;
+    case OUTPUT_VARIABLE_Q:
+      name = "Q";
+      break;
+    case OUTPUT_VARIABLE_ZS:
+      name = "zs";
+      break;
+    case OUTPUT_VARIABLE_A:
+      name = "A";
+      break;
+    case OUTPUT_VARIABLE_B:
+      name = "B";
+      break;
+    case OUTPUT_VARIABLE_ZB:
+      name = "zb";
+      break;
+    case OUTPUT_VARIABLE_ZMAX:
+      name = "zmax";
+      break;
+    case OUTPUT_VARIABLE_BETA:
+      name = "beta";
+      break;
+    default:
+      name = transport[variable - OUTPUT_VARIABLE_SOLUTE].name;
+    }
+#if DEBUG_OUTPUT_VARIABLE_NAME
+  fprintf (stderr, "OVN name=%s\n", name);
+  fprintf (stderr, "output_variable_name: end\n");
+#endif
+  return name;
+}
+
+#if INLINE_OUTPUT_VARIABLE_NAME
+#define output_variable_name _output_variable_name
+#else
+const char *output_variable_name (int, Transport *);
+#endif
+
+static inline int
+_output_open_xml (Output * o, xmlNode * node, Transport * transport, int nt)
+{
+  int i, j;
+  char *buffer, *token, *saveptr;
+#if DEBUG_OUTPUT_OPEN_XML
+  fprintf (stderr, "output_open_xml: start\n");
+#endif
+
+  output_init_empty (o);
+
+  if (!xmlHasProp (node, XML_NAME))
+    {
+      message = g_strconcat (gettext ("Output"), "\n",
+                             gettext ("Not name"), NULL);
+      goto exit1;
+    }
+  buffer = (char *) xmlGetProp (node, XML_NAME);
+  o->name = jb_strdup (buffer);
+  xmlFree (buffer);
+  if (!o->name)
+    {
+      message = g_strconcat (gettext ("Output"), "\n",
+                             gettext ("Not enough memory"), NULL);
+      goto exit1;
+    }
+  if (!xmlHasProp (node, XML_CHANNEL))
+    {
+      output_error (o, gettext ("Bad channel"));
+      goto exit1;
+    }
+  buffer = (char *) xmlGetProp (node, XML_CHANNEL);
+  o->channel = jb_strdup (buffer);
+  xmlFree (buffer);
+  if (!o->channel)
+    {
+      output_error (o, gettext ("Not enough memory"));
+      goto exit1;
+    }
+  if (xmlHasProp (node, XML_INITIAL))
+    {
+      buffer = (char *) xmlGetProp (node, XML_INITIAL);
+      o->section = jb_strdup (buffer);
+      xmlFree (buffer);
+      if (!o->section)
+        {
+          output_error (o, gettext ("Not enough memory"));
+          goto exit1;
+        }
+    }
+  if (xmlHasProp (node, XML_FINAL))
+    {
+      buffer = (char *) xmlGetProp (node, XML_FINAL);
+      o->section2 = jb_strdup (buffer);
+      xmlFree (buffer);
+      if (!o->section2)
+        {
+          output_error (o, gettext ("Not enough memory"));
+          goto exit1;
+        }
+    }
+  o->interval
+    = jb_xml_node_get_float_with_default (node, XML_INTERVAL, &j, 0.);
+  if (!j || o->interval < 0.)
+    {
+      output_error (o, gettext ("Bad interval"));
+      goto exit1;
+    }
+  if (!xmlHasProp (node, XML_VARIABLES))
+    {
+      output_error (o, gettext ("Bad variables"));
+      goto exit1;
+    }
+  buffer = (char *) xmlGetProp (node, XML_VARIABLES);
+  for (token = strtok_r (buffer, " ", &saveptr); token;
+       token = strtok_r (NULL, " ", &saveptr))
+    {
+      i = output_variable (token, transport, nt);
+      if (i < 0)
+        {
+          xmlFree (buffer);
+          output_error (o, gettext ("Bad variables"));
+          goto exit1;
+        }
+      j = o->nvariables + 1;
+      o->variable = (int *) jb_try_realloc (o->variable, j * sizeof (int));
+      if (!o->variable)
+        {
+          xmlFree (buffer);
+          output_error (o, gettext ("Not enough memory"));
+          goto exit1;
+        }
+      o->variable[o->nvariables] = i;
+      o->nvariables = j;
+    }
+  xmlFree (buffer);
+  if (!o->nvariables)
+    {
+      output_error (o, gettext ("Bad variables"));
+      goto exit1;
+    }
+#if DEBUG_OUTPUT_OPEN_XML
+  output_print (o, stderr);
+  fprintf (stderr, "output_open_xml: end\n");
+#endif
+  return 1;
+
+exit1:
+  output_delete (o);
+#if DEBUG_OUTPUT_OPEN_XML
+  fprintf (stderr, "output_open_xml: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_OUTPUT_OPEN_XML
+#define output_open_xml _output_open_xml
+#else
+int output_open_xml (Output *, xmlNode *, Transport *, int);
+#endif
+
+static inline void
+_output_save_xml (Output * o, xmlNode * node, Transport * transport)
+{
+  int i;
+  char *buffer, *buffer2;
+#if DEBUG_OUTPUT_SAVE_XML
+  fprintf (stderr, "output_save_xml: start\n");
+  output_print (o, stderr);
+#endif
+  xmlSetProp (node, XML_NAME, (const xmlChar *) o->name);
+  xmlSetProp (node, XML_CHANNEL, (const xmlChar *) o->channel);
+  if (o->section)
+    xmlSetProp (node, XML_INITIAL, (const xmlChar *) o->section);
+  if (o->section2)
+    xmlSetProp (node, XML_FINAL, (const xmlChar *) o->section2);
+  jb_xml_node_set_float_with_default (node, XML_INTERVAL, o->interval, 0.);
+  buffer = g_strdup (output_variable_name (o->variable[0], transport));
+  for (i = 1; i < o->nvariables; ++i)
+    {
+      buffer2 = buffer;
+      buffer = g_strconcat (buffer2, " ",
+                            output_variable_name (o->variable[i], transport),
+                            NULL);
+      g_free (buffer2);
+    }
+  xmlSetProp (node, XML_VARIABLES, (const xmlChar *) buffer);
+  g_free (buffer);
+#if DEBUG_OUTPUT_SAVE_XML
+  fprintf (stderr, "output_save_xml: end\n");
+#endif
+}
+
+#if INLINE_OUTPUT_SAVE_XML
+#define output_save_xml _output_save_xml
+#else
+void output_save_xml (Output *, xmlNode *, Transport *);
+#endif
+
+#endif
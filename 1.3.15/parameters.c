@@ -125,19 +125,35 @@ system_dry_correction_simple ()
 }
 #endif
 
+#if !INLINE_CHANGE_SECTIONS_GEOMETRY
+SectionGeometry *
+change_sections_geometry (Parameters * p, SectionVariable * sv,
+                          TransientSection * ts1, TransientSection * ts2)
+{
+  return _change_sections_geometry (p, sv, ts1, ts2);
+}
+#endif
+
+#if !INLINE_CHANGE_SECTIONS_SEGMENT
+int
+change_sections_segment (Parameters * p, SectionVariable * sv, JBDOUBLE t)
+{
+  return _change_sections_segment (p, sv, t);
+}
+#endif
+
 #if !INLINE_CHANGE_SECTIONS
 int
-change_sections (Parameters * p, GSList * list_variable_segments, JBDOUBLE t,
-                 JBDOUBLE tmax, JBFLOAT hmin)
+change_sections (Parameters * p, SectionVariable ** sv, JBDOUBLE t)
 {
-  return _change_sections (p, list_variable_segments, t, tmax, hmin);
+  return _change_sections (p, sv, t);
 }
 #endif
 
-#if !INLINE_LIST_SECTION_GAUGE_STEP
-void
-list_section_gauge_step (GSList * list, Parameters * p)
+#if !INLINE_SECTION_GAUGE_SAMPLE
+int
+section_gauge_sample (SectionGauge * sg, Parameters * p)
 {
-  _list_section_gauge_step (list, p);
+  return _section_gauge_sample (sg, p);
 }
 #endif
@@ -32,7 +32,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "model.h"
 
-extern int channel_overflow;
+extern int channel_overflow, calibrating;
 extern JBDOUBLE dtmax, fdtmax;
 
 static inline void _transport_parameters_saturation
@@ -359,7 +359,8 @@ _flow_dry_correction (Parameters * p)
         fprintf (stderr, "FDC lmax=" FWF " dx=" FWF "\n", p->lmax, p->dx);
 #endif
       g_mutex_lock (mutex);
-      dtmax = k;
+      if (k > dtmax)
+        dtmax = k;
       g_mutex_unlock (mutex);
     }
 #endif
@@ -392,7 +393,8 @@ _flows (Parameters * p)
   if (p->dt < fdtmax)
     {
       g_mutex_lock (mutex);
-      fdtmax = p->dt;
+      if (p->dt < fdtmax)
+        fdtmax = p->dt;
       g_mutex_unlock (mutex);
     }
   p->Ff = c * p->Q;
@@ -414,7 +416,8 @@ _flows (Parameters * p)
         fprintf (stderr, "F lmax=" FWF " dx=" FWF "\n", p->lmax, p->dx);
 #endif
       g_mutex_lock (mutex);
-      dtmax = k;
+      if (k > dtmax)
+        dtmax = k;
       g_mutex_unlock (mutex);
     }
 #endif
@@ -645,123 +648,197 @@ _system_dry_correction_simple ()
 void system_dry_correction_simple ();
 #endif
 
-static inline int
-_change_sections (Parameters * p, GSList * list_variable_segments,
-                  JBDOUBLE t, JBDOUBLE tmax, JBFLOAT hmin)
+static inline SectionGeometry *
+_change_sections_geometry (Parameters * p, SectionVariable * sv,
+                           TransientSection * ts1, TransientSection * ts2)
 {
-  int i, k, k2;
+  int i;
   GSList *list;
-  CrossSection *cs;
-  TransientSection *ts1, *ts2, *tsv1, *tsv2;
   ChannelSegment seg[1];
-  SectionVariable *sv;
-  Parameters *pv;
-#if DEBUG_CHANGE_SECTIONS
-  fprintf (stderr, "Change sections: start\n");
-#endif
-  for (list = list_variable_segments, k2 = 1; list; list = list->next, k2 = k)
-    {
-      sv = (SectionVariable *) list->data;
-      cs = sv->cs;
-      tsv1 = cross_section_get_transient (cs, t);
-      tsv2 = cross_section_get_transient (cs + 1, t);
-      ts1 = cross_section_get_transient (cs, tmax);
-      ts2 = cross_section_get_transient (cs + 1, tmax);
-      if (ts2 == tsv2)
-        k = 1;
-      else
-        k = 0;
-      if (k && k2 && ts1 == tsv1)
-        continue;
-      if (!channel_segment_open (seg, ts1, ts2, sv->x[0], sv->x[1]))
-        goto exit2;
-      i = cs->i;
-#if DEBUG_CHANGE_SECTIONS
-      fprintf (stderr, "CS i1=%d i2=%d\n", i, (cs + 1)->i);
+  SectionGeometry *g;
+#if DEBUG_CHANGE_SECTIONS_GEOMETRY
+  fprintf (stderr, "Change sections geometry: start\n");
 #endif
-      pv = p + i;
-      if (k2)
-        {
-          section_delete (pv->s);
-          if (!section_copy (pv->s, seg->s1))
-            goto exit1;
-          parameters_node (pv);
-        }
-      while (++i < (cs + 1)->i)
-        {
-          ++pv;
-          section_delete (pv->s);
-          if (!channel_segment_open_section (seg, pv->s, pv->x))
-            goto exit1;
-          parameters_node (pv);
-        }
-      if (!k)
-        {
-          ++pv;
-          if (!section_copy (pv->s, seg->s2))
-            goto exit1;
-          parameters_node (pv);
-        }
-      mesh_actualize (p + cs->i, (cs + 1)->i - cs->i);
-      channel_segment_delete (seg);
+  for (list = sv->geometry; list; list = list->next)
+    {
+      g = (SectionGeometry *) list->data;
+      if (g->ts1 == ts1 && g->ts2 == ts2)
+        goto exit0;
     }
-#if DEBUG_CHANGE_SECTIONS
-  fprintf (stderr, "Change sections: end\n");
+  g = (SectionGeometry *) g_try_malloc (sizeof (SectionGeometry));
+  if (!g)
+    goto exit4;
+  g->n = (sv->cs + 1)->i - sv->cs->i;
+  g->s = (Section *) g_try_malloc ((g->n + 1) * sizeof (Section));
+  if (!g->s)
+    {
+      g_free (g);
+      goto exit4;
+    }
+  for (i = 0; i <= g->n; ++i)
+    {
+      g->s[i].sp = NULL, g->s[i].fp = NULL;
+      g->s[i].rsp = g->s[i].rfp = NULL;
+      g->s[i].storage = 0;
+    }
+  g->ts1 = ts1;
+  g->ts2 = ts2;
+  if (!channel_segment_open (seg, ts1, ts2, sv->x[0], sv->x[1]))
+    goto exit2;
+  if (!section_copy (g->s, seg->s1, NULL))
+    goto exit1;
+  for (i = 0; ++i < g->n;)
+    if (!channel_segment_open_section
+        (seg, g->s + i, p[sv->cs->i + i].x, NULL))
+      goto exit1;
+  if (!section_copy (g->s + g->n, seg->s2, NULL))
+    goto exit1;
+  channel_segment_delete (seg);
+  sv->geometry = g_slist_prepend (sv->geometry, g);
+#if DEBUG_CHANGE_SECTIONS_GEOMETRY
+  fprintf (stderr, "CSG i1=%d i2=%d\n", sv->cs->i, (sv->cs + 1)->i);
 #endif
-  return 1;
+
+exit0:
+#if DEBUG_CHANGE_SECTIONS_GEOMETRY
+  fprintf (stderr, "Change sections geometry: end\n");
+#endif
+  return g;
+
+exit4:
+  jbw_show_error2 (gettext ("Section"), gettext ("Not enough memory"));
+  goto exit3;
 
 exit1:
   channel_segment_delete (seg);
 
 exit2:
+  section_geometry_delete (g);
+
+exit3:
+#if DEBUG_CHANGE_SECTIONS_GEOMETRY
+  fprintf (stderr, "Change sections geometry: end\n");
+#endif
+  return NULL;
+}
+
+#if INLINE_CHANGE_SECTIONS_GEOMETRY
+#define change_sections_geometry _change_sections_geometry
+#else
+SectionGeometry *change_sections_geometry
+  (Parameters *, SectionVariable *, TransientSection *, TransientSection *);
+#endif
+
+static inline int
+_change_sections_segment (Parameters * p, SectionVariable * sv, JBDOUBLE t)
+{
+  int i;
+  CrossSection *cs;
+  TransientSection *ts1, *ts2;
+  SectionGeometry *g;
+  Parameters *pv;
+  cs = sv->cs;
+  ts1 = cross_section_get_transient (cs, t);
+  ts2 = cross_section_get_transient (cs + 1, t);
+  if (ts1 == sv->ts1 && ts2 == sv->ts2)
+    return 1;
+  g = change_sections_geometry (p, sv, ts1, ts2);
+  if (!g)
+    return 0;
+#if DEBUG_CHANGE_SECTIONS_SEGMENT
+  fprintf (stderr, "CSS i1=%d i2=%d\n", cs->i, (cs + 1)->i);
+#endif
+  pv = p + cs->i;
+  if (ts1 != sv->ts1)
+    {
+      if (!section_link (pv->s, g->s))
+        return 0;
+      parameters_node (pv);
+    }
+  for (i = 0; ++i < g->n;)
+    {
+      ++pv;
+      if (!section_link (pv->s, g->s + i))
+        return 0;
+      parameters_node (pv);
+    }
+  if (ts2 != sv->ts2)
+    {
+      ++pv;
+      if (!section_link (pv->s, g->s + g->n))
+        return 0;
+      parameters_node (pv);
+    }
+  mesh_actualize (p + cs->i, g->n);
+  sv->ts1 = ts1;
+  sv->ts2 = ts2;
+  return 1;
+}
+
+#if INLINE_CHANGE_SECTIONS_SEGMENT
+#define change_sections_segment _change_sections_segment
+#else
+int change_sections_segment (Parameters *, SectionVariable *, JBDOUBLE);
+#endif
+
+static inline int
+_change_sections (Parameters * p, SectionVariable ** sv, JBDOUBLE t)
+{
+  int k;
+#if DEBUG_CHANGE_SECTIONS
+  fprintf (stderr, "Change sections: start\n");
+#endif
+  k = (!sv[0] || change_sections_segment (p, sv[0], t))
+    && (!sv[1] || change_sections_segment (p, sv[1], t));
 #if DEBUG_CHANGE_SECTIONS
   fprintf (stderr, "Change sections: end\n");
 #endif
-  return 0;
+  return k;
 }
 
 #if INLINE_CHANGE_SECTIONS
 #define change_sections _change_sections
 #else
-int change_sections (Parameters *, GSList *, JBDOUBLE, JBDOUBLE, JBFLOAT);
+int change_sections (Parameters *, SectionVariable **, JBDOUBLE);
 #endif
 
-static inline void
-_list_section_gauge_step (GSList * list, Parameters * p)
+static inline int
+_section_gauge_sample (SectionGauge * sg, Parameters * p)
 {
   register JBDOUBLE x;
-  CrossSection *cs, *csc;
-#if DEBUG_LIST_SECTION_GAUGE_STEP
-  fprintf (stderr, "List section gauge step: start\n");
+  CrossSection *cs;
+#if DEBUG_SECTION_GAUGE_SAMPLE
+  fprintf (stderr, "Section gauge sample: start\n");
 #endif
-  for (; list; list = list->next)
+  cs = sg->cs;
+  p += sg->csc->i;
+  switch (cs->type)
     {
-      cs = ((SectionGauge *) list->data)->cs;
-      csc = ((SectionGauge *) list->data)->csc;
-      p += csc->i;
-      ++cs->nt;
-      switch (cs->type)
-        {
-        case CROSS_SECTION_TYPE_CONTROL_Q:
-          x = p->Q;
-          break;
-        case CROSS_SECTION_TYPE_CONTROL_H:
-          x = p->h;
-          break;
-        default:
-          x = p->zs;
-        }
-      cs->pt += x;
+    case CROSS_SECTION_TYPE_CONTROL_Q:
+      x = p->Q;
+      break;
+    case CROSS_SECTION_TYPE_CONTROL_H:
+      x = p->h;
+      break;
+    default:
+      x = p->zs;
     }
-#if DEBUG_LIST_SECTION_GAUGE_STEP
-  fprintf (stderr, "List section gauge step: end\n");
-#endif
+  cs->pt += x;
+  cs->tmax += cs->time / cs->samples;
+#if DEBUG_SECTION_GAUGE_SAMPLE
+  fprintf (stderr, "SGS x=" FWL " nt=%d tmax=" FWF "\n", x, cs->nt + 1,
+           cs->tmax);
+  fprintf (stderr, "Section gauge sample: end\n");
+#endif
+  if (++cs->nt < cs->samples || calibrating)
+    return 0;
+  return cross_section_control (cs);
 }
 
-#if INLINE_LIST_SECTION_GAUGE_STEP
-#define list_section_gauge_step _list_section_gauge_step
+#if INLINE_SECTION_GAUGE_SAMPLE
+#define section_gauge_sample _section_gauge_sample
 #else
-void list_section_gauge_step (GSList *, Parameters *);
+int section_gauge_sample (SectionGauge *, Parameters *);
 #endif
 
 #endif
@@ -0,0 +1,274 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file profile.c
+ * \brief Source file to define the wall clock profiler of the simulation
+ *   phases.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "profile.h"
+
+/**
+ * \fn int profile_open(Profile *pr, int nthreads)
+ * \brief Function to reset a profile and to start its wall clock.
+ * \param pr
+ * \brief profile.
+ * \param nthreads
+ * \brief number of threads.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_PROFILE_OPEN
+int
+profile_open (Profile * pr, int nthreads)
+{
+  return _profile_open (pr, nthreads);
+}
+#endif
+
+/**
+ * \fn int profile_counter_open(int counter, int inherit)
+ * \brief Function to open a hardware performance counter of the calling
+ *   thread.
+ * \param counter
+ * \brief hardware performance counter type.
+ * \param inherit
+ * \brief 1 to count also the threads created later, 0 otherwise.
+ * \return file descriptor of the counter, -1 on error.
+ */
+#if !INLINE_PROFILE_COUNTER_OPEN
+int
+profile_counter_open (int counter, int inherit)
+{
+  return _profile_counter_open (counter, inherit);
+}
+#endif
+
+/**
+ * \fn void profile_counters_read(int *fd, guint64 *value)
+ * \brief Function to read a set of hardware performance counters.
+ * \param fd
+ * \brief array of file descriptors of the counters.
+ * \param value
+ * \brief array of counter values.
+ */
+#if !INLINE_PROFILE_COUNTERS_READ
+void
+profile_counters_read (int *fd, guint64 * value)
+{
+  _profile_counters_read (fd, value);
+}
+#endif
+
+/**
+ * \fn void profile_counters_close(int *fd)
+ * \brief Function to close a set of hardware performance counters.
+ * \param fd
+ * \brief array of file descriptors of the counters.
+ */
+#if !INLINE_PROFILE_COUNTERS_CLOSE
+void
+profile_counters_close (int *fd)
+{
+  _profile_counters_close (fd);
+}
+#endif
+
+/**
+ * \fn int profile_counters_open(Profile *pr)
+ * \brief Function to start the hardware performance counters of a profile.
+ * \param pr
+ * \brief profile.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_PROFILE_COUNTERS_OPEN
+int
+profile_counters_open (Profile * pr)
+{
+  return _profile_counters_open (pr);
+}
+#endif
+
+/**
+ * \fn void profile_counters_lap(Profile *pr, int phase)
+ * \brief Function to add to a profiled phase the hardware events counted in
+ *   the process from the last read.
+ * \param pr
+ * \brief profile.
+ * \param phase
+ * \brief profiled phase.
+ */
+#if !INLINE_PROFILE_COUNTERS_LAP
+void
+profile_counters_lap (Profile * pr, int phase)
+{
+  _profile_counters_lap (pr, phase);
+}
+#endif
+
+/**
+ * \fn void profile_add(Profile *pr, int phase, gint64 time)
+ * \brief Function to add a call to a profiled phase.
+ * \param pr
+ * \brief profile.
+ * \param phase
+ * \brief profiled phase.
+ * \param time
+ * \brief call time in microseconds.
+ */
+#if !INLINE_PROFILE_ADD
+void
+profile_add (Profile * pr, int phase, gint64 time)
+{
+  _profile_add (pr, phase, time);
+}
+#endif
+
+/**
+ * \fn void profile_lap(Profile *pr, int phase, gint64 *time)
+ * \brief Function to add to a profiled phase the time elapsed from a clock
+ *   time and to actualize the clock time.
+ * \param pr
+ * \brief profile.
+ * \param phase
+ * \brief profiled phase.
+ * \param time
+ * \brief pointer to the clock time in microseconds.
+ */
+#if !INLINE_PROFILE_LAP
+void
+profile_lap (Profile * pr, int phase, gint64 * time)
+{
+  _profile_lap (pr, phase, time);
+}
+#endif
+
+/**
+ * \fn void profile_start(Profile *pr, gint64 *time)
+ * \brief Function to start the clock time and the hardware performance
+ *   counters of a sequence of profiled phases.
+ * \param pr
+ * \brief profile.
+ * \param time
+ * \brief pointer to the clock time in microseconds.
+ */
+#if !INLINE_PROFILE_START
+void
+profile_start (Profile * pr, gint64 * time)
+{
+  _profile_start (pr, time);
+}
+#endif
+
+/**
+ * \fn void profile_thread_add(Profile *pr, int phase, int thread, \
+ *   gint64 time)
+ * \brief Function to add the time of a thread in a profiled phase.
+ * \param pr
+ * \brief profile.
+ * \param phase
+ * \brief profiled phase.
+ * \param thread
+ * \brief thread number.
+ * \param time
+ * \brief thread time in microseconds.
+ */
+#if !INLINE_PROFILE_THREAD_ADD
+void
+profile_thread_add (Profile * pr, int phase, int thread, gint64 time)
+{
+  _profile_thread_add (pr, phase, thread, time);
+}
+#endif
+
+/**
+ * \fn JBDOUBLE profile_imbalance(Profile *pr, int phase)
+ * \brief Function to calculate the ratio between the maximum and the mean
+ *   thread times of a profiled phase.
+ * \param pr
+ * \brief profile.
+ * \param phase
+ * \brief profiled phase.
+ * \return thread imbalance, 0 if the thread times are not measured.
+ */
+#if !INLINE_PROFILE_IMBALANCE
+JBDOUBLE
+profile_imbalance (Profile * pr, int phase)
+{
+  return _profile_imbalance (pr, phase);
+}
+#endif
+
+/**
+ * \fn void profile_print(Profile *pr, FILE *file)
+ * \brief Function to print a summary of a profile.
+ * \param pr
+ * \brief profile.
+ * \param file
+ * \brief file.
+ */
+#if !INLINE_PROFILE_PRINT
+void
+profile_print (Profile * pr, FILE * file)
+{
+  _profile_print (pr, file);
+}
+#endif
+
+/**
+ * \fn int profile_save(Profile *pr, char *path)
+ * \brief Function to save a profile in a JSON file.
+ * \param pr
+ * \brief profile.
+ * \param path
+ * \brief file path.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_PROFILE_SAVE
+int
+profile_save (Profile * pr, char *path)
+{
+  return _profile_save (pr, path);
+}
+#endif
+
+/**
+ * \fn void profile_close(Profile *pr)
+ * \brief Function to free the memory used by a profile.
+ * \param pr
+ * \brief profile.
+ */
+#if !INLINE_PROFILE_CLOSE
+void
+profile_close (Profile * pr)
+{
+  _profile_close (pr);
+}
+#endif
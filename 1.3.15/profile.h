@@ -0,0 +1,560 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file profile.h
+ * \brief Header file to define the wall clock profiler of the simulation
+ *   phases.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef PROFILE__H
+#define PROFILE__H 1
+
+#include "jb/jb_win.h"
+#include "def.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define PROFILE_COUNTERS_AVAILABLE 1
+#else
+#define PROFILE_COUNTERS_AVAILABLE 0
+#endif
+
+/**
+ * \enum ProfilePhase
+ * \brief Enumeration to define the profiled phases of a time step.
+ * \var PROFILE_PHASE_DECOMPOSITION
+ * \brief flux decomposition.
+ * \var PROFILE_PHASE_SIMULATE_STEP
+ * \brief first flow step including the junctions.
+ * \var PROFILE_PHASE_SIMULATE_STEP2
+ * \brief second flow step.
+ * \var PROFILE_PHASE_TRANSPORT_STEP
+ * \brief solute transport step including the junctions.
+ * \var PROFILE_PHASE_PARAMETERS2
+ * \brief flow parameters and time step size including the section changes.
+ * \var PROFILE_PHASE_JUNCTIONS
+ * \brief junction schemes.
+ * \var PROFILE_PHASE_SECTIONS
+ * \brief section changes and section gauges.
+ * \var PROFILE_PHASE_WRITE
+ * \brief writing of the results.
+ * \var PROFILE_PHASES
+ * \brief number of profiled phases.
+ */
+enum ProfilePhase
+{
+  PROFILE_PHASE_DECOMPOSITION = 0,
+  PROFILE_PHASE_SIMULATE_STEP = 1,
+  PROFILE_PHASE_SIMULATE_STEP2 = 2,
+  PROFILE_PHASE_TRANSPORT_STEP = 3,
+  PROFILE_PHASE_PARAMETERS2 = 4,
+  PROFILE_PHASE_JUNCTIONS = 5,
+  PROFILE_PHASE_SECTIONS = 6,
+  PROFILE_PHASE_WRITE = 7,
+  PROFILE_PHASES = 8
+};
+
+/**
+ * \def PROFILE_THREAD_PHASES
+ * \brief Macro to define the number of phases, the first ones, with times
+ *   measured in every thread.
+ * \def PROFILE_BINS
+ * \brief Macro to define the number of bins of the histograms. The bin 0
+ *   counts the calls shorter than 1 microsecond and the bin i > 0 the calls
+ *   lasting from 2^(i-1) to 2^i microseconds.
+ */
+#define PROFILE_THREAD_PHASES 5
+#define PROFILE_BINS 32
+
+/**
+ * \enum ProfileCounter
+ * \brief Enumeration to define the hardware performance counters.
+ * \var PROFILE_COUNTER_CYCLES
+ * \brief CPU cycles.
+ * \var PROFILE_COUNTER_INSTRUCTIONS
+ * \brief retired instructions.
+ * \var PROFILE_COUNTER_LLC_MISSES
+ * \brief last level cache misses.
+ * \var PROFILE_COUNTER_BRANCH_MISSES
+ * \brief mispredicted branches.
+ * \var PROFILE_COUNTERS
+ * \brief number of hardware performance counters.
+ */
+enum ProfileCounter
+{
+  PROFILE_COUNTER_CYCLES = 0,
+  PROFILE_COUNTER_INSTRUCTIONS = 1,
+  PROFILE_COUNTER_LLC_MISSES = 2,
+  PROFILE_COUNTER_BRANCH_MISSES = 3,
+  PROFILE_COUNTERS = 4
+};
+
+/**
+ * \struct Profile
+ * \brief Structure to define a wall clock profile of the simulation phases.
+ */
+typedef struct
+{
+/**
+ * \var time
+ * \brief total times of the phases in microseconds.
+ * \var calls
+ * \brief number of calls of the phases.
+ * \var histogram
+ * \brief histograms of the call times of the phases.
+ * \var thread
+ * \brief total times in microseconds of every thread in the phases.
+ * \var start
+ * \brief start time in microseconds.
+ * \var end
+ * \brief end time in microseconds.
+ * \var counter
+ * \brief hardware performance counters of the phases.
+ * \var counter_last
+ * \brief last read hardware performance counters of the process.
+ * \var nthreads
+ * \brief number of threads.
+ * \var counters
+ * \brief 1 if the hardware performance counters are read, 0 otherwise.
+ * \var counter_fd
+ * \brief file descriptors of the hardware performance counters of the
+ *   process.
+ */
+  gint64 time[PROFILE_PHASES], calls[PROFILE_PHASES],
+    histogram[PROFILE_PHASES][PROFILE_BINS], *thread, start, end;
+  guint64 counter[PROFILE_PHASES][PROFILE_COUNTERS],
+    counter_last[PROFILE_COUNTERS];
+  int nthreads, counters, counter_fd[PROFILE_COUNTERS];
+} Profile;
+
+extern Profile profile[1];
+extern const char *profile_phase_name[PROFILE_PHASES];
+extern const char *profile_counter_name[PROFILE_COUNTERS];
+
+static inline int
+_profile_open (Profile * pr, int nthreads)
+{
+#if DEBUG_PROFILE_OPEN
+  fprintf (stderr, "profile_open: start\n");
+#endif
+  memset (pr->time, 0, PROFILE_PHASES * sizeof (gint64));
+  memset (pr->calls, 0, PROFILE_PHASES * sizeof (gint64));
+  memset (pr->histogram, 0, PROFILE_PHASES * PROFILE_BINS * sizeof (gint64));
+  memset (pr->counter, 0, PROFILE_PHASES * PROFILE_COUNTERS * sizeof (guint64));
+  pr->counters = 0;
+  pr->nthreads = nthreads;
+  pr->thread = (gint64 *)
+    g_try_malloc (nthreads * PROFILE_THREAD_PHASES * sizeof (gint64));
+  if (!pr->thread)
+    {
+      jbw_show_error2 (gettext ("Profile"), gettext ("Not enough memory"));
+#if DEBUG_PROFILE_OPEN
+      fprintf (stderr, "profile_open: end\n");
+#endif
+      return 0;
+    }
+  memset (pr->thread, 0, nthreads * PROFILE_THREAD_PHASES * sizeof (gint64));
+  pr->start = pr->end = g_get_monotonic_time ();
+#if DEBUG_PROFILE_OPEN
+  fprintf (stderr, "PO nthreads=%d\n", nthreads);
+  fprintf (stderr, "profile_open: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_PROFILE_OPEN
+#define profile_open _profile_open
+#else
+int profile_open (Profile *, int);
+#endif
+
+static inline int
+_profile_counter_open (int counter, int inherit)
+{
+#if PROFILE_COUNTERS_AVAILABLE
+  static const guint64 config[PROFILE_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+  };
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof (struct perf_event_attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof (struct perf_event_attr);
+  attr.config = config[counter];
+  attr.inherit = inherit;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int) syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+  return -1;
+#endif
+}
+
+#if INLINE_PROFILE_COUNTER_OPEN
+#define profile_counter_open _profile_counter_open
+#else
+int profile_counter_open (int, int);
+#endif
+
+static inline void
+_profile_counters_read (int *fd, guint64 * value)
+{
+  register int i;
+  for (i = 0; i < PROFILE_COUNTERS; ++i)
+    {
+      value[i] = 0;
+#if PROFILE_COUNTERS_AVAILABLE
+      if (fd[i] >= 0 && read (fd[i], value + i, sizeof (guint64))
+          != sizeof (guint64))
+        value[i] = 0;
+#endif
+    }
+}
+
+#if INLINE_PROFILE_COUNTERS_READ
+#define profile_counters_read _profile_counters_read
+#else
+void profile_counters_read (int *, guint64 *);
+#endif
+
+static inline void
+_profile_counters_close (int *fd)
+{
+  register int i;
+  for (i = 0; i < PROFILE_COUNTERS; ++i)
+    {
+#if PROFILE_COUNTERS_AVAILABLE
+      if (fd[i] >= 0)
+        close (fd[i]);
+#endif
+      fd[i] = -1;
+    }
+}
+
+#if INLINE_PROFILE_COUNTERS_CLOSE
+#define profile_counters_close _profile_counters_close
+#else
+void profile_counters_close (int *);
+#endif
+
+static inline int
+_profile_counters_open (Profile * pr)
+{
+  int i;
+#if DEBUG_PROFILE_COUNTERS_OPEN
+  fprintf (stderr, "profile_counters_open: start\n");
+#endif
+  // the inherited counters add the events of the worker threads when they
+  // are joined, so the phases are counted without per-thread counters
+  for (i = 0; i < PROFILE_COUNTERS; ++i)
+    pr->counter_fd[i] = profile_counter_open (i, 1);
+  for (i = 0; i < PROFILE_COUNTERS; ++i)
+    if (pr->counter_fd[i] < 0)
+      {
+        profile_counters_close (pr->counter_fd);
+        jbw_show_warning
+          (gettext ("Hardware performance counters not available"));
+        goto exit0;
+      }
+  profile_counters_read (pr->counter_fd, pr->counter_last);
+  pr->counters = 1;
+#if DEBUG_PROFILE_COUNTERS_OPEN
+  fprintf (stderr, "profile_counters_open: end\n");
+#endif
+  return 1;
+
+exit0:
+#if DEBUG_PROFILE_COUNTERS_OPEN
+  fprintf (stderr, "profile_counters_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_PROFILE_COUNTERS_OPEN
+#define profile_counters_open _profile_counters_open
+#else
+int profile_counters_open (Profile *);
+#endif
+
+static inline void
+_profile_counters_lap (Profile * pr, int phase)
+{
+  register int i;
+  guint64 value[PROFILE_COUNTERS];
+  profile_counters_read (pr->counter_fd, value);
+  for (i = 0; i < PROFILE_COUNTERS; ++i)
+    {
+      pr->counter[phase][i] += value[i] - pr->counter_last[i];
+      pr->counter_last[i] = value[i];
+    }
+}
+
+#if INLINE_PROFILE_COUNTERS_LAP
+#define profile_counters_lap _profile_counters_lap
+#else
+void profile_counters_lap (Profile *, int);
+#endif
+
+static inline void
+_profile_add (Profile * pr, int phase, gint64 time)
+{
+  register int i;
+  register gint64 k;
+  pr->time[phase] += time;
+  ++pr->calls[phase];
+  for (i = 0, k = time; k > 0 && i < PROFILE_BINS - 1; k >>= 1)
+    ++i;
+  ++pr->histogram[phase][i];
+}
+
+#if INLINE_PROFILE_ADD
+#define profile_add _profile_add
+#else
+void profile_add (Profile *, int, gint64);
+#endif
+
+static inline void
+_profile_lap (Profile * pr, int phase, gint64 * time)
+{
+  register gint64 now;
+  now = g_get_monotonic_time ();
+  profile_add (pr, phase, now - *time);
+  *time = now;
+  if (pr->counters)
+    profile_counters_lap (pr, phase);
+}
+
+#if INLINE_PROFILE_LAP
+#define profile_lap _profile_lap
+#else
+void profile_lap (Profile *, int, gint64 *);
+#endif
+
+static inline void
+_profile_start (Profile * pr, gint64 * time)
+{
+  *time = g_get_monotonic_time ();
+  if (pr->counters)
+    profile_counters_read (pr->counter_fd, pr->counter_last);
+}
+
+#if INLINE_PROFILE_START
+#define profile_start _profile_start
+#else
+void profile_start (Profile *, gint64 *);
+#endif
+
+static inline void
+_profile_thread_add (Profile * pr, int phase, int thread, gint64 time)
+{
+  if (pr->thread)
+    pr->thread[thread * PROFILE_THREAD_PHASES + phase] += time;
+}
+
+#if INLINE_PROFILE_THREAD_ADD
+#define profile_thread_add _profile_thread_add
+#else
+void profile_thread_add (Profile *, int, int, gint64);
+#endif
+
+static inline JBDOUBLE
+_profile_imbalance (Profile * pr, int phase)
+{
+  int i;
+  gint64 k;
+  JBDOUBLE mean, max;
+  if (!pr->thread || phase >= PROFILE_THREAD_PHASES)
+    return 0.;
+  for (i = 0, mean = max = 0.; i < pr->nthreads; ++i)
+    {
+      k = pr->thread[i * PROFILE_THREAD_PHASES + phase];
+      mean += k;
+      max = fmax (max, k);
+    }
+  if (mean <= 0.)
+    return 1.;
+  return max * pr->nthreads / mean;
+}
+
+#if INLINE_PROFILE_IMBALANCE
+#define profile_imbalance _profile_imbalance
+#else
+JBDOUBLE profile_imbalance (Profile *, int);
+#endif
+
+static inline void
+_profile_print (Profile * pr, FILE * file)
+{
+  int i, j, k;
+  guint64 *c;
+  JBDOUBLE wall;
+#if DEBUG_PROFILE_PRINT
+  fprintf (stderr, "profile_print: start\n");
+#endif
+  wall = 1e-6 * (pr->end - pr->start);
+  fprintf (file, "Profile wall_time=%.6Lf threads=%d\n", wall, pr->nthreads);
+  fprintf (file, "%-16s %12s %14s %9s %9s\n",
+           "phase", "calls", "time", "fraction", "imbalance");
+  for (i = 0; i < PROFILE_PHASES; ++i)
+    {
+      fprintf (file, "%-16s %12ld %14.6f %8.2f%%",
+               profile_phase_name[i], (long) pr->calls[i],
+               1e-6 * pr->time[i],
+               wall > 0. ? (double) (100e-6 * pr->time[i] / wall) : 0.);
+      if (i < PROFILE_THREAD_PHASES && pr->thread)
+        fprintf (file, " %9.3Lf", profile_imbalance (pr, i));
+      fprintf (file, "\n");
+    }
+  if (pr->thread && pr->nthreads > 1)
+    for (j = 0; j < pr->nthreads; ++j)
+      {
+        fprintf (file, "thread %d", j);
+        for (i = 0; i < PROFILE_THREAD_PHASES; ++i)
+          fprintf (file, " %s=%.6f", profile_phase_name[i],
+                   1e-6 * pr->thread[j * PROFILE_THREAD_PHASES + i]);
+        fprintf (file, "\n");
+      }
+  if (!pr->counters)
+    goto exit0;
+  fprintf (file, "%-16s", "phase");
+  for (k = 0; k < PROFILE_COUNTERS; ++k)
+    fprintf (file, " %16s", profile_counter_name[k]);
+  fprintf (file, " %6s\n", "IPC");
+  for (i = 0; i < PROFILE_PHASES; ++i)
+    {
+      fprintf (file, "%-16s", profile_phase_name[i]);
+      for (k = 0; k < PROFILE_COUNTERS; ++k)
+        fprintf (file, " %16lu", (unsigned long) pr->counter[i][k]);
+      c = pr->counter[i];
+      fprintf (file, " %6.3f\n", c[PROFILE_COUNTER_CYCLES] ?
+               (double) c[PROFILE_COUNTER_INSTRUCTIONS]
+               / c[PROFILE_COUNTER_CYCLES] : 0.);
+    }
+
+exit0:
+#if DEBUG_PROFILE_PRINT
+  fprintf (stderr, "profile_print: end\n");
+#endif
+}
+
+#if INLINE_PROFILE_PRINT
+#define profile_print _profile_print
+#else
+void profile_print (Profile *, FILE *);
+#endif
+
+static inline int
+_profile_save (Profile * pr, char *path)
+{
+  int i, j, k;
+  guint64 *c;
+  FILE *file;
+#if DEBUG_PROFILE_SAVE
+  fprintf (stderr, "profile_save: start\n");
+#endif
+  file = g_fopen (path, "w");
+  if (!file)
+    {
+      jbw_show_error2 (path, gettext ("Unable to open the file"));
+#if DEBUG_PROFILE_SAVE
+      fprintf (stderr, "profile_save: end\n");
+#endif
+      return 0;
+    }
+  fprintf (file, "{\n  \"wall_time\": %.6f,\n  \"threads\": %d,\n"
+           "  \"phases\": [\n", 1e-6 * (pr->end - pr->start), pr->nthreads);
+  for (i = 0; i < PROFILE_PHASES; ++i)
+    {
+      fprintf (file, "    {\"name\": \"%s\", \"calls\": %ld, \"time\": %.6f",
+               profile_phase_name[i], (long) pr->calls[i], 1e-6 * pr->time[i]);
+      if (i < PROFILE_THREAD_PHASES && pr->thread)
+        {
+          fprintf (file, ", \"imbalance\": %.6Lf, \"threads\": [",
+                   profile_imbalance (pr, i));
+          for (j = 0; j < pr->nthreads; ++j)
+            fprintf (file, "%s%.6f", j ? ", " : "",
+                     1e-6 * pr->thread[j * PROFILE_THREAD_PHASES + i]);
+          fprintf (file, "]");
+        }
+      if (pr->counters)
+        {
+          fprintf (file, ", \"counters\": {");
+          for (k = 0, c = pr->counter[i]; k < PROFILE_COUNTERS; ++k)
+            fprintf (file, "%s\"%s\": %lu", k ? ", " : "",
+                     profile_counter_name[k], (unsigned long) c[k]);
+          fprintf (file, "}");
+        }
+      fprintf (file, ", \"histogram\": [");
+      for (j = 0; j < PROFILE_BINS; ++j)
+        fprintf (file, "%s%ld", j ? ", " : "", (long) pr->histogram[i][j]);
+      fprintf (file, "]}%s\n", i < PROFILE_PHASES - 1 ? "," : "");
+    }
+  fprintf (file, "  ]\n}\n");
+  fclose (file);
+#if DEBUG_PROFILE_SAVE
+  fprintf (stderr, "profile_save: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_PROFILE_SAVE
+#define profile_save _profile_save
+#else
+int profile_save (Profile *, char *);
+#endif
+
+static inline void
+_profile_close (Profile * pr)
+{
+#if DEBUG_PROFILE_CLOSE
+  fprintf (stderr, "profile_close: start\n");
+#endif
+  jb_free_null ((void **) &pr->thread);
+  if (pr->counters)
+    {
+      profile_counters_close (pr->counter_fd);
+      pr->counters = 0;
+    }
+  pr->nthreads = 0;
+#if DEBUG_PROFILE_CLOSE
+  fprintf (stderr, "profile_close: end\n");
+#endif
+}
+
+#if INLINE_PROFILE_CLOSE
+#define profile_close _profile_close
+#else
+void profile_close (Profile *);
+#endif
+
+#endif
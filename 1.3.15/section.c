@@ -173,6 +173,38 @@ section_critical_area (Section * s, JBDOUBLE Q)
 }
 #endif
 
+#if !INLINE_SECTION_ARENA_INIT_EMPTY
+void
+section_arena_init_empty (SectionArena * a)
+{
+  _section_arena_init_empty (a);
+}
+#endif
+
+#if !INLINE_SECTION_ARENA_DELETE
+void
+section_arena_delete (SectionArena * a)
+{
+  _section_arena_delete (a);
+}
+#endif
+
+#if !INLINE_SECTION_ARENA_ALLOC
+void *
+section_arena_alloc (SectionArena * a, size_t size)
+{
+  return _section_arena_alloc (a, size);
+}
+#endif
+
+#if !INLINE_SECTION_RELEASE
+void
+section_release (void **data, int **r, int arena)
+{
+  _section_release (data, r, arena);
+}
+#endif
+
 #if !INLINE_SECTION_DELETE
 void
 section_delete (Section * s)
@@ -183,17 +215,73 @@ section_delete (Section * s)
 
 #if !INLINE_SECTION_CREATE
 int
-section_create (Section * s, int n, int nf)
+section_create (Section * s, int n, int nf, SectionArena * arena)
 {
-  return _section_create (s, n, nf);
+  return _section_create (s, n, nf, arena);
 }
 #endif
 
 #if !INLINE_SECTION_COPY
 int
-section_copy (Section * s, Section * s_copy)
+section_copy (Section * s, Section * s_copy, SectionArena * arena)
+{
+  return _section_copy (s, s_copy, arena);
+}
+#endif
+
+#if !INLINE_SECTION_SHARE
+int
+section_share (Section * s, Section * s_share, int friction)
+{
+  return _section_share (s, s_share, friction);
+}
+#endif
+
+#if !INLINE_SECTION_LINK
+int
+section_link (Section * s, Section * s_link)
+{
+  return _section_link (s, s_link);
+}
+#endif
+
+#if !INLINE_SECTION_HASH_ADD
+guint
+section_hash_add (guint h, JBDOUBLE x)
+{
+  return _section_hash_add (h, x);
+}
+#endif
+
+#if !INLINE_SECTION_HASH_PARAMETERS
+guint
+section_hash_parameters (gconstpointer data)
+{
+  return _section_hash_parameters (data);
+}
+#endif
+
+#if !INLINE_SECTION_EQUAL_PARAMETERS
+gboolean
+section_equal_parameters (gconstpointer data1, gconstpointer data2)
+{
+  return _section_equal_parameters (data1, data2);
+}
+#endif
+
+#if !INLINE_SECTION_HASH_FRICTION
+guint
+section_hash_friction (gconstpointer data)
 {
-  return _section_copy (s, s_copy);
+  return _section_hash_friction (data);
+}
+#endif
+
+#if !INLINE_SECTION_EQUAL_FRICTION
+gboolean
+section_equal_friction (gconstpointer data1, gconstpointer data2)
+{
+  return _section_equal_friction (data1, data2);
 }
 #endif
 
@@ -246,6 +334,14 @@ section_P (TransientSection * cs, SectionParameters * sp, int n, int *ni)
 }
 #endif
 
+#if !INLINE_SECTION_POW6
+JBDOUBLE
+section_pow6 (JBDOUBLE x, int k)
+{
+  return _section_pow6 (x, k);
+}
+#endif
+
 #if !INLINE_SECTION_RHPA
 void
 section_rhpa (FrictionParameters * fp, JBDOUBLE h1, JBDOUBLE h2, JBDOUBLE r1,
@@ -343,6 +439,128 @@ section_open_parameters (Section * s)
 }
 #endif
 
+#if !INLINE_SECTION_MEMO_HASH
+guint
+section_memo_hash (gconstpointer data)
+{
+  return _section_memo_hash (data);
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_EQUAL
+gboolean
+section_memo_equal (gconstpointer data1, gconstpointer data2)
+{
+  return _section_memo_equal (data1, data2);
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_FREE
+void
+section_memo_free (gpointer data)
+{
+  _section_memo_free (data);
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_OPEN
+void
+section_memo_open ()
+{
+  _section_memo_open ();
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_CLOSE
+void
+section_memo_close ()
+{
+  _section_memo_close ();
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_GET
+int
+section_memo_get (Section * s, TransientSection * ts)
+{
+  return _section_memo_get (s, ts);
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_ADD
+void
+section_memo_add (Section * s, TransientSection * ts)
+{
+  _section_memo_add (s, ts);
+}
+#endif
+
+#if !INLINE_SECTION_MEMO_KEY
+TransientSection *
+section_memo_key (TransientSection * ts)
+{
+  return _section_memo_key (ts);
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_HASH
+guint
+section_pair_memo_hash (gconstpointer data)
+{
+  return _section_pair_memo_hash (data);
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_EQUAL
+gboolean
+section_pair_memo_equal (gconstpointer data1, gconstpointer data2)
+{
+  return _section_pair_memo_equal (data1, data2);
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_FREE
+void
+section_pair_memo_free (gpointer data)
+{
+  _section_pair_memo_free (data);
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_OPEN
+void
+section_pair_memo_open ()
+{
+  _section_pair_memo_open ();
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_CLOSE
+void
+section_pair_memo_close ()
+{
+  _section_pair_memo_close ();
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_GET
+int
+section_pair_memo_get (Section * s, TransientSection * ts1,
+                       TransientSection * ts2, JBDOUBLE k)
+{
+  return _section_pair_memo_get (s, ts1, ts2, k);
+}
+#endif
+
+#if !INLINE_SECTION_PAIR_MEMO_ADD
+void
+section_pair_memo_add (Section * s, TransientSection * ts1,
+                       TransientSection * ts2, JBDOUBLE k)
+{
+  _section_pair_memo_add (s, ts1, ts2, k);
+}
+#endif
+
 #if !INLINE_SECTION_OPEN
 int
 section_open (Section * s, TransientSection * ts)
@@ -350,3 +568,385 @@ section_open (Section * s, TransientSection * ts)
   return _section_open (s, ts);
 }
 #endif
+
+#if MAKE_SECTION==1
+
+// Micro-benchmark of the section geometry functions
+
+#define _GNU_SOURCE
+#include <locale.h>
+#include "variables_system.c"
+
+#define SECTION_BENCH_LEVELS 1024
+///< number of levels of every section in a benchmark sequence.
+#define SECTION_BENCH_SEQUENCES 2
+///< number of benchmark sequences (random and coherent).
+#define SECTION_BENCH_FUNCTIONS 6
+///< number of benchmarked geometry functions.
+
+typedef JBDOUBLE (*SectionBenchFunction) (Section *, JBDOUBLE);
+
+static JBDOUBLE
+section_bench_area (Section * s, JBDOUBLE z)
+{
+  return _section_area (s, z);
+}
+
+static JBDOUBLE
+section_bench_level (Section * s, JBDOUBLE A)
+{
+  return _section_level (s, A);
+}
+
+static JBDOUBLE
+section_bench_width (Section * s, JBDOUBLE z)
+{
+  return _section_width (s, z);
+}
+
+static JBDOUBLE
+section_bench_perimeter (Section * s, JBDOUBLE z)
+{
+  return _section_perimeter (s, z);
+}
+
+static JBDOUBLE
+section_bench_beta (Section * s, JBDOUBLE z)
+{
+  return _section_beta (s, z);
+}
+
+static JBDOUBLE
+section_bench_critical_area (Section * s, JBDOUBLE Q)
+{
+  return _section_critical_area (s, Q);
+}
+
+const char *section_bench_name[SECTION_BENCH_FUNCTIONS] = {
+  "section_area", "section_level", "section_width", "section_perimeter",
+  "section_beta", "section_critical_area"
+};
+
+const int section_bench_inline[SECTION_BENCH_FUNCTIONS] = {
+  INLINE_SECTION_AREA, INLINE_SECTION_LEVEL, INLINE_SECTION_WIDTH,
+  INLINE_SECTION_PERIMETER, INLINE_SECTION_BETA, INLINE_SECTION_CRITICAL_AREA
+};
+
+SectionBenchFunction section_bench_function[SECTION_BENCH_FUNCTIONS] = {
+  section_bench_area, section_bench_level, section_bench_width,
+  section_bench_perimeter, section_bench_beta, section_bench_critical_area
+};
+
+const char *section_bench_sequence[SECTION_BENCH_SEQUENCES] = {
+  "random", "coherent"
+};
+
+// Input of every function: levels, areas or discharges
+const int section_bench_input[SECTION_BENCH_FUNCTIONS] = { 0, 1, 0, 0, 0, 2 };
+
+Section *section_bench_section = NULL;
+TransientSection *section_bench_ts = NULL;
+int section_bench_n = 0;
+
+/**
+ * \fn JBDOUBLE section_bench_area_linear(Section *s, JBDOUBLE z)
+ * \brief Function to calculate the area of a section with a linear search of
+ *   the level.
+ * \param s
+ * \brief section.
+ * \param z
+ * \brief level.
+ * \return area.
+ */
+static inline JBDOUBLE
+section_bench_area_linear (Section * s, JBDOUBLE z)
+{
+  int i;
+  JBDOUBLE dz;
+  SectionParameters *sp;
+  if (z <= s->sp->z)
+    return 0.;
+  sp = s->sp + s->n;
+  if (z < sp->z)
+    {
+      for (i = 0; i < s->n - 1 && z >= s->sp[i + 1].z; ++i);
+      sp = s->sp + i;
+      dz = z - sp->z;
+      return sp->A + (sp->B + 0.5 * dz * sp->dBz) * dz;
+    }
+  return sp->A + (z - sp->z) * sp->B;
+}
+
+/**
+ * \fn JBDOUBLE section_bench_area_cursor(Section *s, JBDOUBLE z, int *cursor)
+ * \brief Function to calculate the area of a section searching the level from
+ *   the interval of the previous call.
+ * \param s
+ * \brief section.
+ * \param z
+ * \brief level.
+ * \param cursor
+ * \brief pointer to the interval of the previous call.
+ * \return area.
+ */
+static inline JBDOUBLE
+section_bench_area_cursor (Section * s, JBDOUBLE z, int *cursor)
+{
+  int i;
+  JBDOUBLE dz;
+  SectionParameters *sp;
+  if (z <= s->sp->z)
+    return 0.;
+  sp = s->sp + s->n;
+  if (z < sp->z)
+    {
+      i = *cursor;
+      while (i > 0 && z < s->sp[i].z)
+        --i;
+      while (i < s->n - 1 && z >= s->sp[i + 1].z)
+        ++i;
+      *cursor = i;
+      sp = s->sp + i;
+      dz = z - sp->z;
+      return sp->A + (sp->B + 0.5 * dz * sp->dBz) * dz;
+    }
+  return sp->A + (z - sp->z) * sp->B;
+}
+
+/**
+ * \fn int section_bench_open(xmlNode *node)
+ * \brief Function to open the transient sections of a XML node and its children
+ *   as sections.
+ * \param node
+ * \brief XML node.
+ * \return 1 on success, 0 on error.
+ */
+int
+section_bench_open (xmlNode * node)
+{
+  int n;
+  for (; node; node = node->next)
+    {
+      if (xmlStrcmp (node->name, XML_TRANSIENT_SECTION))
+        {
+          if (!section_bench_open (node->children))
+            return 0;
+          continue;
+        }
+      n = section_bench_n + 1;
+      section_bench_section = (Section *)
+        jb_realloc (section_bench_section, n * sizeof (Section));
+      section_bench_ts = (TransientSection *)
+        jb_realloc (section_bench_ts, n * sizeof (TransientSection));
+      if (!section_bench_section || !section_bench_ts)
+        {
+          jbw_show_error2 (gettext ("Section"), gettext ("Not enough memory"));
+          return 0;
+        }
+      if (!transient_section_open_xml (section_bench_ts + section_bench_n,
+                                       node, 0., 0., 0.))
+        return 0;
+      if (!section_open (section_bench_section + section_bench_n,
+                         section_bench_ts + section_bench_n))
+        return 0;
+      section_bench_n = n;
+    }
+  return 1;
+}
+
+int
+main (int argn, char **argc)
+{
+  int i, j, k, l, q, nlevels, iterations, *cursor;
+  gint64 time0;
+  JBDOUBLE h, x, e, sum, *input, *z, *A, *Q;
+  double ns[3];
+  Section *s, s2[1];
+  xmlDoc *doc;
+  xmlKeepBlanksDefault (0);
+  setlocale (LC_ALL, "");
+  setlocale (LC_NUMERIC, "C");
+  bindtextdomain ("swigs", "po");
+  bind_textdomain_codeset ("swigs", "UTF-8");
+  textdomain ("swigs");
+  iterations = 100;
+  i = 1;
+  if (argn > 3 && !strcmp (argc[1], "-n"))
+    {
+      iterations = atoi (argc[2]);
+      i = 3;
+    }
+  if (argn <= i || iterations < 1)
+    {
+      jbw_show_error2 (gettext ("Usage is"),
+                       "swigs-section [-n iterations] file.xml ...");
+      return 1;
+    }
+  for (; i < argn; ++i)
+    {
+      doc = xmlParseFile (argc[i]);
+      if (!doc)
+        {
+          jbw_show_error2 (argc[i], gettext ("Unable to open the file"));
+          return 2;
+        }
+      j = section_bench_open (xmlDocGetRootElement (doc));
+      xmlFreeDoc (doc);
+      if (!j)
+        return 2;
+    }
+  if (!section_bench_n)
+    {
+      jbw_show_error2 (gettext ("Section"), gettext ("Bad defined"));
+      return 2;
+    }
+
+  // Random and coherent sequences of levels, areas and critical discharges
+  nlevels = section_bench_n * SECTION_BENCH_LEVELS;
+  z = (JBDOUBLE *) g_try_malloc (3 * SECTION_BENCH_SEQUENCES * nlevels
+                                 * sizeof (JBDOUBLE));
+  cursor = (int *) g_try_malloc (section_bench_n * sizeof (int));
+  if (!z || !cursor)
+    {
+      jbw_show_error2 (gettext ("Section"), gettext ("Not enough memory"));
+      return 3;
+    }
+  A = z + SECTION_BENCH_SEQUENCES * nlevels;
+  Q = A + SECTION_BENCH_SEQUENCES * nlevels;
+  srand (1);
+  for (i = 0, s = section_bench_section; i < section_bench_n; ++i, ++s)
+    {
+      h = s->sp[s->n].z - s->sp->z;
+      for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+        {
+          k = i * SECTION_BENCH_LEVELS + j;
+          z[k] = s->sp->z + h * (1.15 * rand () / RAND_MAX - 0.05);
+          z[nlevels + k] = s->sp->z + h * (0.55 + 0.5 * sin (2. * M_PI * j
+                                           / SECTION_BENCH_LEVELS));
+        }
+    }
+  for (k = 0; k < SECTION_BENCH_SEQUENCES * nlevels; ++k)
+    {
+      s = section_bench_section + (k % nlevels) / SECTION_BENCH_LEVELS;
+      A[k] = section_area (s, z[k]);
+      Q[k] = A[k] > 0. ? section_critical_discharge (s, A[k]) : 0.;
+    }
+  printf ("Sections=%d levels=%d iterations=%d\n",
+          section_bench_n, SECTION_BENCH_LEVELS, iterations);
+
+  // Inlined and called geometry functions
+  printf ("%-22s %-6s %-8s %10s %10s\n",
+          "function", "INLINE", "sequence", "inline_ns", "call_ns");
+  sum = 0.;
+  for (l = 0; l < SECTION_BENCH_FUNCTIONS; ++l)
+    for (q = 0; q < SECTION_BENCH_SEQUENCES; ++q)
+      {
+        input = z + (section_bench_input[l] * SECTION_BENCH_SEQUENCES + q)
+          * nlevels;
+        time0 = g_get_monotonic_time ();
+        for (k = 0; k < iterations; ++k)
+          for (i = 0, s = section_bench_section; i < section_bench_n;
+               ++i, ++s)
+            for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+              {
+                x = input[i * SECTION_BENCH_LEVELS + j];
+                switch (l)
+                  {
+                  case 0:
+                    sum += _section_area (s, x);
+                    break;
+                  case 1:
+                    sum += _section_level (s, x);
+                    break;
+                  case 2:
+                    sum += _section_width (s, x);
+                    break;
+                  case 3:
+                    sum += _section_perimeter (s, x);
+                    break;
+                  case 4:
+                    sum += _section_beta (s, x);
+                    break;
+                  default:
+                    sum += _section_critical_area (s, x);
+                  }
+              }
+        ns[0] = 1000. * (g_get_monotonic_time () - time0)
+          / ((double) iterations * nlevels);
+        time0 = g_get_monotonic_time ();
+        for (k = 0; k < iterations; ++k)
+          for (i = 0, s = section_bench_section; i < section_bench_n;
+               ++i, ++s)
+            for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+              sum += section_bench_function[l]
+                (s, input[i * SECTION_BENCH_LEVELS + j]);
+        ns[1] = 1000. * (g_get_monotonic_time () - time0)
+          / ((double) iterations * nlevels);
+        printf ("%-22s %-6d %-8s %10.3lf %10.3lf\n", section_bench_name[l],
+                section_bench_inline[l], section_bench_sequence[q], ns[0],
+                ns[1]);
+      }
+
+  // Lookup strategies of the section_area level search
+  printf ("%-22s %-8s %10s %10s %10s %10s\n", "lookup", "sequence",
+          "binary_ns", "linear_ns", "cursor_ns", "max_error");
+  for (q = 0; q < SECTION_BENCH_SEQUENCES; ++q)
+    {
+      input = z + q * nlevels;
+      time0 = g_get_monotonic_time ();
+      for (k = 0; k < iterations; ++k)
+        for (i = 0, s = section_bench_section; i < section_bench_n; ++i, ++s)
+          for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+            sum += _section_area (s, input[i * SECTION_BENCH_LEVELS + j]);
+      ns[0] = 1000. * (g_get_monotonic_time () - time0)
+        / ((double) iterations * nlevels);
+      time0 = g_get_monotonic_time ();
+      for (k = 0; k < iterations; ++k)
+        for (i = 0, s = section_bench_section; i < section_bench_n; ++i, ++s)
+          for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+            sum += section_bench_area_linear
+              (s, input[i * SECTION_BENCH_LEVELS + j]);
+      ns[1] = 1000. * (g_get_monotonic_time () - time0)
+        / ((double) iterations * nlevels);
+      memset (cursor, 0, section_bench_n * sizeof (int));
+      time0 = g_get_monotonic_time ();
+      for (k = 0; k < iterations; ++k)
+        for (i = 0, s = section_bench_section; i < section_bench_n; ++i, ++s)
+          for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+            sum += section_bench_area_cursor
+              (s, input[i * SECTION_BENCH_LEVELS + j], cursor + i);
+      ns[2] = 1000. * (g_get_monotonic_time () - time0)
+        / ((double) iterations * nlevels);
+      e = 0.;
+      memset (cursor, 0, section_bench_n * sizeof (int));
+      for (i = 0, s = section_bench_section; i < section_bench_n; ++i, ++s)
+        for (j = 0; j < SECTION_BENCH_LEVELS; ++j)
+          {
+            x = input[i * SECTION_BENCH_LEVELS + j];
+            h = _section_area (s, x);
+            e = fmaxl (e, fabsl (section_bench_area_linear (s, x) - h));
+            e = fmaxl (e, fabsl (section_bench_area_cursor (s, x, cursor + i)
+                                 - h));
+          }
+      printf ("%-22s %-8s %10.3lf %10.3lf %10.3lf %10.3Lg\n", "section_area",
+              section_bench_sequence[q], ns[0], ns[1], ns[2],
+              (long double) e);
+    }
+
+  // Section construction from the transient sections
+  printf ("%-22s %-6s %10s\n", "function", "INLINE", "call_ns");
+  time0 = g_get_monotonic_time ();
+  for (k = 0; k < iterations; ++k)
+    for (i = 0; i < section_bench_n; ++i)
+      {
+        if (!section_open (s2, section_bench_ts + i))
+          return 3;
+        section_delete (s2);
+      }
+  printf ("%-22s %-6d %10.3lf\n", "section_open", INLINE_SECTION_OPEN,
+          1000. * (g_get_monotonic_time () - time0)
+          / ((double) iterations * section_bench_n));
+  printf ("Checksum=%Lg\n", (long double) sum);
+  return 0;
+}
+#endif
@@ -41,6 +41,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define friction_4b3 (4. * friction_b + 3.)
 #define friction_2b1i (1. / friction_2b1)
 #define friction_beta (friction_b1b1 / friction_2b1)
+// FRICTION_SIXTHS has to be 0 if friction_b is not a multiple of 1/6
+#if FRICTION_SIXTHS
+#define friction_pow(x, e) (section_pow6 (x, (int) rint (6. * (e))))
+#else
+#define friction_pow(x, e) (pow (x, e))
+#endif
 
 #if MODEL_FRICTION == MODEL_FRICTION_MINIMIZATION_STRESS
 #define friction_gi1e (friction_2b2)
@@ -91,14 +97,39 @@ typedef struct
 #endif
 } FrictionCoefficients;
 
+enum SectionStorage
+{
+  SECTION_STORAGE_ARENA_PARAMETERS = 1,
+  SECTION_STORAGE_ARENA_FRICTION = 2
+};
+
 typedef struct
 {
   int n, nf, e;
   JBFLOAT dz, zmin, zmax, zleft, zright, hmin, hmax, Amax, u;
   SectionParameters *sp;
   FrictionParameters *fp;
+  int *rsp, *rfp;
+  int storage;
 } Section;
 
+typedef struct
+{
+  GSList *block;
+  char *data;
+  size_t size;
+} SectionArena;
+
+typedef struct
+{
+  TransientSection *ts1, *ts2;
+  JBDOUBLE k;
+  Section s[1];
+} SectionPair;
+
+extern GMutex mutex[1];
+extern GHashTable *section_memo, *section_pair_memo;
+
 static inline JBDOUBLE
 _wave_velocity (JBDOUBLE g, JBDOUBLE A, JBDOUBLE B)
 {
@@ -437,6 +468,106 @@ _section_critical_area (Section * s, JBDOUBLE Q)
 JBDOUBLE section_critical_area (Section *, JBDOUBLE);
 #endif
 
+static inline void
+_section_arena_init_empty (SectionArena * a)
+{
+  a->block = NULL;
+  a->data = NULL;
+  a->size = 0;
+}
+
+#if INLINE_SECTION_ARENA_INIT_EMPTY
+#define section_arena_init_empty _section_arena_init_empty
+#else
+void section_arena_init_empty (SectionArena *);
+#endif
+
+static inline void
+_section_arena_delete (SectionArena * a)
+{
+  GSList *list;
+#if DEBUG_SECTION_ARENA_DELETE
+  fprintf (stderr, "Section arena delete: start\n");
+#endif
+  for (list = a->block; list; list = list->next)
+    g_free (list->data);
+  g_slist_free (a->block);
+  section_arena_init_empty (a);
+#if DEBUG_SECTION_ARENA_DELETE
+  fprintf (stderr, "Section arena delete: end\n");
+#endif
+}
+
+#if INLINE_SECTION_ARENA_DELETE
+#define section_arena_delete _section_arena_delete
+#else
+void section_arena_delete (SectionArena *);
+#endif
+
+static inline void *
+_section_arena_alloc (SectionArena * a, size_t size)
+{
+  size_t block;
+  void *data;
+#if DEBUG_SECTION_ARENA_ALLOC
+  fprintf (stderr, "Section arena alloc: start\n");
+#endif
+  size = (size + sizeof (JBDOUBLE) - 1) / sizeof (JBDOUBLE) * sizeof (JBDOUBLE);
+  if (size > a->size)
+    {
+      block = size > SECTION_ARENA_BLOCK ? size : SECTION_ARENA_BLOCK;
+      data = g_try_malloc (block);
+      if (!data)
+        {
+#if DEBUG_SECTION_ARENA_ALLOC
+          fprintf (stderr, "Section arena alloc: end\n");
+#endif
+          return NULL;
+        }
+      a->block = g_slist_prepend (a->block, data);
+      a->data = (char *) data;
+      a->size = block;
+    }
+  data = a->data;
+  a->data += size;
+  a->size -= size;
+#if DEBUG_SECTION_ARENA_ALLOC
+  fprintf (stderr, "SAA size=%lu free=%lu\n", (unsigned long) size,
+           (unsigned long) a->size);
+  fprintf (stderr, "Section arena alloc: end\n");
+#endif
+  return data;
+}
+
+#if INLINE_SECTION_ARENA_ALLOC
+#define section_arena_alloc _section_arena_alloc
+#else
+void *section_arena_alloc (SectionArena *, size_t);
+#endif
+
+static inline void
+_section_release (void **data, int **r, int arena)
+{
+  if (*r)
+    {
+      if (--**r)
+        goto exit0;
+      jb_free_null ((void **) r);
+    }
+  if (!arena)
+    g_free (*data);
+
+exit0:
+  *data = NULL;
+  *r = NULL;
+}
+
+#if INLINE_SECTION_RELEASE
+#define section_release _section_release
+#else
+void section_release (void **, int **, int);
+#endif
+
 static inline void
 _section_delete (Section * s)
 {
@@ -444,11 +575,14 @@ _section_delete (Section * s)
   fprintf (stderr, "Section delete: start\n");
   fprintf (stderr, "SD deleting section points\n");
 #endif
-  jb_free_null ((void **) &s->sp);
+  section_release ((void **) &s->sp, &s->rsp,
+                   s->storage & SECTION_STORAGE_ARENA_PARAMETERS);
 #if DEBUG_SECTION_DELETE
   fprintf (stderr, "SD deleting friction points\n");
 #endif
-  jb_free_null ((void **) &s->fp);
+  section_release ((void **) &s->fp, &s->rfp,
+                   s->storage & SECTION_STORAGE_ARENA_FRICTION);
+  s->storage = 0;
 #if DEBUG_SECTION_DELETE
   fprintf (stderr, "Section delete: end\n");
 #endif
@@ -461,17 +595,31 @@ void section_delete (Section *);
 #endif
 
 static inline int
-_section_create (Section * s, int n, int nf)
+_section_create (Section * s, int n, int nf, SectionArena * arena)
 {
 #if DEBUG_SECTION_CREATE
   fprintf (stderr, "Section create: start\n");
 #endif
+  s->rsp = s->rfp = NULL;
   s->n = n;
-  s->sp = (SectionParameters *)
-    g_try_malloc ((n + 1) * sizeof (SectionParameters));
   s->nf = nf;
-  s->fp = (FrictionParameters *)
-    g_try_malloc ((nf + 1) * sizeof (FrictionParameters));
+  if (arena)
+    {
+      s->storage = SECTION_STORAGE_ARENA_PARAMETERS
+        | SECTION_STORAGE_ARENA_FRICTION;
+      s->sp = (SectionParameters *) section_arena_alloc
+        (arena, (n + 1) * sizeof (SectionParameters)
+         + (nf + 1) * sizeof (FrictionParameters));
+      s->fp = s->sp ? (FrictionParameters *) (s->sp + n + 1) : NULL;
+    }
+  else
+    {
+      s->storage = 0;
+      s->sp = (SectionParameters *)
+        g_try_malloc ((n + 1) * sizeof (SectionParameters));
+      s->fp = (FrictionParameters *)
+        g_try_malloc ((nf + 1) * sizeof (FrictionParameters));
+    }
   if (!s->sp || !s->fp)
     {
       section_delete (s);
@@ -490,17 +638,17 @@ _section_create (Section * s, int n, int nf)
 #if INLINE_SECTION_CREATE
 #define section_create _section_create
 #else
-int section_create (Section *, int, int);
+int section_create (Section *, int, int, SectionArena *);
 #endif
 
 static inline int
-_section_copy (Section * s, Section * s_copy)
+_section_copy (Section * s, Section * s_copy, SectionArena * arena)
 {
 #if DEBUG_SECTION_COPY
   fprintf (stderr, "Section copy: start\n");
   section_print (s_copy, stderr);
 #endif
-  if (!section_create (s, s_copy->n, s_copy->nf))
+  if (!section_create (s, s_copy->n, s_copy->nf, arena))
     goto exit2;
   memcpy (s, s_copy, (size_t) & s->sp - (size_t) s);
   memcpy (s->sp, s_copy->sp, (s->n + 1) * sizeof (SectionParameters));
@@ -521,7 +669,235 @@ exit2:
 #if INLINE_SECTION_COPY
 #define section_copy _section_copy
 #else
-int section_copy (Section *, Section *);
+int section_copy (Section *, Section *, SectionArena *);
+#endif
+
+static inline int
+_section_share (Section * s, Section * s_share, int friction)
+{
+  int **r, **r_share, bit;
+  void **data, **data_share;
+#if DEBUG_SECTION_SHARE
+  fprintf (stderr, "Section share: start\n");
+#endif
+  if (friction)
+    {
+      r = &s->rfp, r_share = &s_share->rfp;
+      data = (void **) &s->fp, data_share = (void **) &s_share->fp;
+      bit = SECTION_STORAGE_ARENA_FRICTION;
+    }
+  else
+    {
+      r = &s->rsp, r_share = &s_share->rsp;
+      data = (void **) &s->sp, data_share = (void **) &s_share->sp;
+      bit = SECTION_STORAGE_ARENA_PARAMETERS;
+    }
+  if (*data == *data_share)
+    goto exit1;
+  if (!*r_share)
+    {
+      *r_share = (int *) g_try_malloc (sizeof (int));
+      if (!*r_share)
+        {
+          jbw_show_error2 (gettext ("Section"), gettext ("Not enough memory"));
+#if DEBUG_SECTION_SHARE
+          fprintf (stderr, "Section share: end\n");
+#endif
+          return 0;
+        }
+      **r_share = 1;
+    }
+  section_release (data, r, s->storage & bit);
+  *data = *data_share;
+  *r = *r_share;
+  ++**r;
+  s->storage = (s->storage & ~bit) | (s_share->storage & bit);
+
+exit1:
+#if DEBUG_SECTION_SHARE
+  fprintf (stderr, "SS friction=%d references=%d\n", friction, *r ? **r : 1);
+  fprintf (stderr, "Section share: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_SECTION_SHARE
+#define section_share _section_share
+#else
+int section_share (Section *, Section *, int);
+#endif
+
+static inline int
+_section_link (Section * s, Section * s_link)
+{
+#if DEBUG_SECTION_LINK
+  fprintf (stderr, "Section link: start\n");
+#endif
+  if (!section_share (s, s_link, 0) || !section_share (s, s_link, 1))
+    {
+#if DEBUG_SECTION_LINK
+      fprintf (stderr, "Section link: end\n");
+#endif
+      return 0;
+    }
+  memcpy (s, s_link, (size_t) & s->sp - (size_t) s);
+#if DEBUG_SECTION_LINK
+  fprintf (stderr, "Section link: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_SECTION_LINK
+#define section_link _section_link
+#else
+int section_link (Section *, Section *);
+#endif
+
+static inline guint
+_section_hash_add (guint h, JBDOUBLE x)
+{
+  guint64 u;
+  double d;
+  d = (double) x + 0.;
+  memcpy (&u, &d, sizeof (guint64));
+  return (h ^ (guint) (u ^ (u >> 32))) * 16777619u;
+}
+
+#if INLINE_SECTION_HASH_ADD
+#define section_hash_add _section_hash_add
+#else
+guint section_hash_add (guint, JBDOUBLE);
+#endif
+
+static inline guint
+_section_hash_parameters (gconstpointer data)
+{
+  int i;
+  guint h;
+  Section *s;
+  SectionParameters *sp;
+#if DEBUG_SECTION_HASH_PARAMETERS
+  fprintf (stderr, "Section hash parameters: start\n");
+#endif
+  s = (Section *) data;
+  h = 2166136261u ^ (guint) s->n;
+  for (i = 0, sp = s->sp; i <= s->n; ++i, ++sp)
+    {
+      h = section_hash_add (h, sp->z);
+      h = section_hash_add (h, sp->B);
+      h = section_hash_add (h, sp->P);
+      h = section_hash_add (h, sp->A);
+    }
+#if DEBUG_SECTION_HASH_PARAMETERS
+  fprintf (stderr, "SHP h=%u\n", h);
+  fprintf (stderr, "Section hash parameters: end\n");
+#endif
+  return h;
+}
+
+#if INLINE_SECTION_HASH_PARAMETERS
+#define section_hash_parameters _section_hash_parameters
+#else
+guint section_hash_parameters (gconstpointer);
+#endif
+
+static inline gboolean
+_section_equal_parameters (gconstpointer data1, gconstpointer data2)
+{
+  int i;
+  Section *s1, *s2;
+  SectionParameters *sp1, *sp2;
+#if DEBUG_SECTION_EQUAL_PARAMETERS
+  fprintf (stderr, "Section equal parameters: start\n");
+#endif
+  s1 = (Section *) data1;
+  s2 = (Section *) data2;
+  if (s1->n != s2->n)
+    goto exit0;
+  for (i = 0, sp1 = s1->sp, sp2 = s2->sp; i <= s1->n; ++i, ++sp1, ++sp2)
+    if (sp1->z != sp2->z || sp1->B != sp2->B || sp1->P != sp2->P
+        || sp1->dBz != sp2->dBz || sp1->dPz != sp2->dPz || sp1->A != sp2->A
+        || sp1->I != sp2->I || sp1->c != sp2->c)
+      goto exit0;
+#if DEBUG_SECTION_EQUAL_PARAMETERS
+  fprintf (stderr, "Section equal parameters: end\n");
+#endif
+  return TRUE;
+exit0:
+#if DEBUG_SECTION_EQUAL_PARAMETERS
+  fprintf (stderr, "Section equal parameters: end\n");
+#endif
+  return FALSE;
+}
+
+#if INLINE_SECTION_EQUAL_PARAMETERS
+#define section_equal_parameters _section_equal_parameters
+#else
+gboolean section_equal_parameters (gconstpointer, gconstpointer);
+#endif
+
+static inline guint
+_section_hash_friction (gconstpointer data)
+{
+  int i;
+  guint h;
+  Section *s;
+  FrictionParameters *fp;
+#if DEBUG_SECTION_HASH_FRICTION
+  fprintf (stderr, "Section hash friction: start\n");
+#endif
+  s = (Section *) data;
+  h = 2166136261u ^ (guint) s->nf;
+  for (i = 0, fp = s->fp; i <= s->nf; ++i, ++fp)
+    {
+      h = section_hash_add (h, fp->r);
+      h = section_hash_add (h, fp->beta);
+    }
+#if DEBUG_SECTION_HASH_FRICTION
+  fprintf (stderr, "SHF h=%u\n", h);
+  fprintf (stderr, "Section hash friction: end\n");
+#endif
+  return h;
+}
+
+#if INLINE_SECTION_HASH_FRICTION
+#define section_hash_friction _section_hash_friction
+#else
+guint section_hash_friction (gconstpointer);
+#endif
+
+static inline gboolean
+_section_equal_friction (gconstpointer data1, gconstpointer data2)
+{
+  int i;
+  Section *s1, *s2;
+  FrictionParameters *fp1, *fp2;
+#if DEBUG_SECTION_EQUAL_FRICTION
+  fprintf (stderr, "Section equal friction: start\n");
+#endif
+  s1 = (Section *) data1;
+  s2 = (Section *) data2;
+  if (s1->nf != s2->nf)
+    goto exit0;
+  for (i = 0, fp1 = s1->fp, fp2 = s2->fp; i <= s1->nf; ++i, ++fp1, ++fp2)
+    if (fp1->r != fp2->r || fp1->beta != fp2->beta
+        || fp1->dbetaA != fp2->dbetaA)
+      goto exit0;
+#if DEBUG_SECTION_EQUAL_FRICTION
+  fprintf (stderr, "Section equal friction: end\n");
+#endif
+  return TRUE;
+exit0:
+#if DEBUG_SECTION_EQUAL_FRICTION
+  fprintf (stderr, "Section equal friction: end\n");
+#endif
+  return FALSE;
+}
+
+#if INLINE_SECTION_EQUAL_FRICTION
+#define section_equal_friction _section_equal_friction
+#else
+gboolean section_equal_friction (gconstpointer, gconstpointer);
 #endif
 
 static inline JBDOUBLE
@@ -724,6 +1100,43 @@ static inline void _section_P
 void section_P (TransientSection *, SectionParameters *, int, int *);
 #endif
 
+static inline JBDOUBLE
+_section_pow6 (JBDOUBLE x, int k)
+{
+  JBDOUBLE y, c;
+  switch (k % 6)
+    {
+    case 0:
+      y = 1.;
+      break;
+    case 1:
+      y = sqrtl (cbrtl (x));
+      break;
+    case 2:
+      y = cbrtl (x);
+      break;
+    case 3:
+      y = sqrtl (x);
+      break;
+    case 4:
+      c = cbrtl (x);
+      y = c * c;
+      break;
+    default:
+      c = cbrtl (x);
+      y = c * c * sqrtl (c);
+    }
+  for (k /= 6; k > 0; --k)
+    y *= x;
+  return y;
+}
+
+#if INLINE_SECTION_POW6
+#define section_pow6 _section_pow6
+#else
+JBDOUBLE section_pow6 (JBDOUBLE, int);
+#endif
+
 static inline void _section_rhpa
   (FrictionParameters * fp, JBDOUBLE h1, JBDOUBLE h2, JBDOUBLE r1, JBDOUBLE r2)
 {
@@ -732,10 +1145,10 @@ static inline void _section_rhpa
   fprintf (stderr, "SRHPA h1=" FWL " h2=" FWL "\n", h1, h2);
   fprintf (stderr, "SRHPA r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
 #endif
-  fp->r +=
-    friction_gi21c * (pow (h1, friction_gi21e) - pow (h2, friction_gi21e)) / r1;
-  fp->beta +=
-    friction_xi21c * (pow (h1, friction_xi21e) - pow (h2, friction_xi21e)) / r2;
+  fp->r += friction_gi21c * (friction_pow (h1, friction_gi21e)
+                             - friction_pow (h2, friction_gi21e)) / r1;
+  fp->beta += friction_xi21c * (friction_pow (h1, friction_xi21e)
+                                - friction_pow (h2, friction_xi21e)) / r2;
 #if DEBUG_SECTION_RHPA
   fprintf (stderr, "SRHPA r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
   fprintf (stderr, "Section rhpa: end\n");
@@ -757,8 +1170,8 @@ static inline void _section_rhpb
   fprintf (stderr, "SRHPB h=" FWL "\n", h);
   fprintf (stderr, "SRHPB r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
 #endif
-  fp->r += pow (h, friction_gi1e) / r1;
-  fp->beta += pow (h, friction_xi1e) / r2;
+  fp->r += friction_pow (h, friction_gi1e) / r1;
+  fp->beta += friction_pow (h, friction_xi1e) / r2;
 #if DEBUG_SECTION_RHPB
   fprintf (stderr, "SRHPB r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
   fprintf (stderr, "Section rhpb: end\n");
@@ -779,8 +1192,8 @@ static inline void _section_rhpc
   fprintf (stderr, "SRHPC h=" FWL "\n", h);
   fprintf (stderr, "SRHPC r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
 #endif
-  fp->r += friction_gi21c * pow (h, friction_gi21e) / r1;
-  fp->beta += friction_xi21c * pow (h, friction_xi21e) / r2;
+  fp->r += friction_gi21c * friction_pow (h, friction_gi21e) / r1;
+  fp->beta += friction_xi21c * friction_pow (h, friction_xi21e) / r2;
 #if DEBUG_SECTION_RHPC
   fprintf (stderr, "SRHPC r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
   fprintf (stderr, "Section rhpc: end\n");
@@ -804,35 +1217,34 @@ _section_rhla (FrictionParameters * fp, JBDOUBLE h1, JBDOUBLE h2,
 #endif
 #if MODEL_FRICTION == MODEL_FRICTION_MINIMIZATION_STRESS
   fp->r +=
-    (friction_gi21c * (pow (h1, friction_gi21e) - pow (h2, friction_gi21e)) +
-     fc->l1 * friction_gi22c * (pow (h1, friction_gi22e) -
-                                pow (h2,
-                                     friction_gi22e)) + fc->l2 * (h1 -
-                                                                  h2)) / r1;
+    (friction_gi21c * (friction_pow (h1, friction_gi21e)
+                       - friction_pow (h2, friction_gi21e))
+     + fc->l1 * friction_gi22c * (friction_pow (h1, friction_gi22e)
+                                  - friction_pow (h2, friction_gi22e))
+     + fc->l2 * (h1 - h2)) / r1;
   fp->beta +=
-    (friction_xi21c * (pow (h1, friction_xi21e) - pow (h2, friction_xi21e)) +
-     fc->l1 * friction_xi22c * (pow (h1, friction_xi22e) -
-                                pow (h2,
-                                     friction_xi22e)) +
-     fc->l2 * friction_xi23c * (pow (h1, friction_xi23e) -
-                                pow (h2,
-                                     friction_xi23e)) +
-     fc->l3 * friction_xi24c * (pow (h1, friction_xi24e) -
-                                pow (h2,
-                                     friction_xi24e)) +
-     fc->l4 * friction_xi25c * (pow (h1, friction_xi25e) -
-                                pow (h2,
-                                     friction_xi25e)) - fc->l5 * (h1 -
-                                                                  h2)) / r2;
+    (friction_xi21c * (friction_pow (h1, friction_xi21e)
+                       - friction_pow (h2, friction_xi21e))
+     + fc->l1 * friction_xi22c * (friction_pow (h1, friction_xi22e)
+                                  - friction_pow (h2, friction_xi22e))
+     + fc->l2 * friction_xi23c * (friction_pow (h1, friction_xi23e)
+                                  - friction_pow (h2, friction_xi23e))
+     + fc->l3 * friction_xi24c * (friction_pow (h1, friction_xi24e)
+                                  - friction_pow (h2, friction_xi24e))
+     + fc->l4 * friction_xi25c * (friction_pow (h1, friction_xi25e)
+                                  - friction_pow (h2, friction_xi25e))
+     - fc->l5 * (h1 - h2)) / r2;
 #else
   fp->r +=
-    (friction_gi21c * (pow (h1, friction_gi21e) - pow (h2, friction_gi21e)) +
-     fc->l1 * friction_gi22c * (pow (h1, friction_gi22e) -
-                                pow (h2, friction_gi22e))) / r1;
+    (friction_gi21c * (friction_pow (h1, friction_gi21e)
+                       - friction_pow (h2, friction_gi21e))
+     + fc->l1 * friction_gi22c * (friction_pow (h1, friction_gi22e)
+                                  - friction_pow (h2, friction_gi22e))) / r1;
   fp->beta +=
-    (friction_xi21c * (pow (h1, friction_xi21e) - pow (h2, friction_xi21e)) +
-     fc->l2 * friction_xi22c * (pow (h1, friction_xi22e) -
-                                pow (h2, friction_xi22e))) / r2;
+    (friction_xi21c * (friction_pow (h1, friction_xi21e)
+                       - friction_pow (h2, friction_xi21e))
+     + fc->l2 * friction_xi22c * (friction_pow (h1, friction_xi22e)
+                                  - friction_pow (h2, friction_xi22e))) / r2;
 #endif
 #if DEBUG_SECTION_RHLA
   fprintf (stderr, "SRHLA r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
@@ -860,12 +1272,15 @@ _section_rhlb (FrictionParameters * fp, JBDOUBLE h, JBDOUBLE r1,
   R = fc->l / h;
 #if MODEL_FRICTION == MODEL_FRICTION_MINIMIZATION_STRESS
   JBDOUBLE R1;
-  R1 = jbm_fsqr (1. - pow (R, friction_b1));
-  fp->r += pow (h, friction_gi1e) * R1 / r1;
-  fp->beta += pow (h, friction_xi1e) * (1. - pow (R, friction_2b1)) * R1 / r2;
+  R1 = jbm_fsqr (1. - friction_pow (R, friction_b1));
+  fp->r += friction_pow (h, friction_gi1e) * R1 / r1;
+  fp->beta += friction_pow (h, friction_xi1e)
+    * (1. - friction_pow (R, friction_2b1)) * R1 / r2;
 #else
-  fp->r += pow (h, friction_gi1e) * (1. - pow (R, friction_b1)) / r1;
-  fp->beta += pow (h, friction_xi1e) * (1. - pow (R, friction_2b1)) / r2;
+  fp->r += friction_pow (h, friction_gi1e)
+    * (1. - friction_pow (R, friction_b1)) / r1;
+  fp->beta += friction_pow (h, friction_xi1e)
+    * (1. - friction_pow (R, friction_2b1)) / r2;
 #endif
 #if DEBUG_SECTION_RHLB
   fprintf (stderr, "SRHLB r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
@@ -890,23 +1305,21 @@ _section_rhlc (FrictionParameters * fp, JBDOUBLE h, JBDOUBLE r1,
   fprintf (stderr, "SRHLC r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
 #endif
 #if MODEL_FRICTION == MODEL_FRICTION_MINIMIZATION_STRESS
-  fp->r += (friction_gi21c * pow (h, friction_gi21e) +
-            fc->l1 * friction_gi22c * pow (h,
-                                           friction_gi22e) + fc->l2 * h) / r1;
-  fp->beta +=
-    (friction_xi21c * pow (h, friction_xi21e) +
-     fc->l1 * friction_xi22c * pow (h,
-                                    friction_xi22e) +
-     fc->l2 * friction_xi23c * pow (h,
-                                    friction_xi23e) +
-     fc->l3 * friction_xi24c * pow (h,
-                                    friction_xi24e) +
-     fc->l4 * friction_xi25c * pow (h, friction_xi25e) - fc->l5 * h) / r2;
-#else
-  fp->r += (friction_gi21c * pow (h, friction_gi21e) +
-            fc->l1 * friction_gi22c * pow (h, friction_gi22e)) / r1;
-  fp->beta += (friction_xi21c * pow (h, friction_xi21e)
-               + fc->l2 * friction_xi22c * pow (h, friction_xi22e)) / r2;
+  fp->r += (friction_gi21c * friction_pow (h, friction_gi21e)
+            + fc->l1 * friction_gi22c * friction_pow (h, friction_gi22e)
+            + fc->l2 * h) / r1;
+  fp->beta += (friction_xi21c * friction_pow (h, friction_xi21e)
+               + fc->l1 * friction_xi22c * friction_pow (h, friction_xi22e)
+               + fc->l2 * friction_xi23c * friction_pow (h, friction_xi23e)
+               + fc->l3 * friction_xi24c * friction_pow (h, friction_xi24e)
+               + fc->l4 * friction_xi25c * friction_pow (h, friction_xi25e)
+               - fc->l5 * h) / r2;
+#else
+  fp->r += (friction_gi21c * friction_pow (h, friction_gi21e)
+            + fc->l1 * friction_gi22c * friction_pow (h, friction_gi22e)) / r1;
+  fp->beta += (friction_xi21c * friction_pow (h, friction_xi21e)
+               + fc->l2 * friction_xi22c
+               * friction_pow (h, friction_xi22e)) / r2;
 #endif
 #if DEBUG_SECTION_RHLC
   fprintf (stderr, "SRHLC r=" FWF " beta=" FWF "\n", fp->r, fp->beta);
@@ -1386,6 +1799,382 @@ _section_open_parameters (Section * s)
 void section_open_parameters (Section *);
 #endif
 
+static inline guint
+_section_memo_hash (gconstpointer data)
+{
+  int i;
+  guint h;
+  TransientSection *ts;
+  SectionPoint2 *sp;
+  ts = (TransientSection *) data;
+  h = 2166136261u ^ (guint) ts->n;
+  h = section_hash_add (h, ts->dz);
+  h = section_hash_add (h, ts->hmax);
+  for (i = 0, sp = ts->sp; i <= ts->n; ++i, ++sp)
+    {
+      h = section_hash_add (h, sp->y);
+      h = section_hash_add (h, sp->z - ts->zmin);
+      h = section_hash_add (h, sp->r);
+    }
+  return h;
+}
+
+#if INLINE_SECTION_MEMO_HASH
+#define section_memo_hash _section_memo_hash
+#else
+guint section_memo_hash (gconstpointer);
+#endif
+
+static inline gboolean
+_section_memo_equal (gconstpointer data1, gconstpointer data2)
+{
+  int i;
+  TransientSection *ts1, *ts2;
+  SectionPoint2 *sp1, *sp2;
+  ts1 = (TransientSection *) data1;
+  ts2 = (TransientSection *) data2;
+  if (ts1->n != ts2->n || ts1->dz != ts2->dz || ts1->hmax != ts2->hmax
+      || ts1->u != ts2->u || ts1->contraction != ts2->contraction)
+    return FALSE;
+  for (i = 0, sp1 = ts1->sp, sp2 = ts2->sp; i <= ts1->n; ++i, ++sp1, ++sp2)
+    if (sp1->y != sp2->y || sp1->z - ts1->zmin != sp2->z - ts2->zmin
+        || sp1->r != sp2->r || sp1->t != sp2->t)
+      return FALSE;
+  return TRUE;
+}
+
+#if INLINE_SECTION_MEMO_EQUAL
+#define section_memo_equal _section_memo_equal
+#else
+gboolean section_memo_equal (gconstpointer, gconstpointer);
+#endif
+
+static inline void
+_section_memo_free (gpointer data)
+{
+  section_delete ((Section *) data);
+  g_free (data);
+}
+
+#if INLINE_SECTION_MEMO_FREE
+#define section_memo_free _section_memo_free
+#else
+void section_memo_free (gpointer);
+#endif
+
+static inline void
+_section_memo_open ()
+{
+#if DEBUG_SECTION_MEMO_OPEN
+  fprintf (stderr, "Section memo open: start\n");
+#endif
+  section_memo = g_hash_table_new_full (section_memo_hash, section_memo_equal,
+                                        NULL, section_memo_free);
+#if DEBUG_SECTION_MEMO_OPEN
+  fprintf (stderr, "Section memo open: end\n");
+#endif
+}
+
+#if INLINE_SECTION_MEMO_OPEN
+#define section_memo_open _section_memo_open
+#else
+void section_memo_open ();
+#endif
+
+static inline void
+_section_memo_close ()
+{
+#if DEBUG_SECTION_MEMO_CLOSE
+  fprintf (stderr, "Section memo close: start\n");
+#endif
+  if (section_memo)
+    {
+#if DEBUG_SECTION_MEMO_CLOSE
+      fprintf (stderr, "SMC sections=%u\n", g_hash_table_size (section_memo));
+#endif
+      g_hash_table_destroy (section_memo);
+      section_memo = NULL;
+    }
+#if DEBUG_SECTION_MEMO_CLOSE
+  fprintf (stderr, "Section memo close: end\n");
+#endif
+}
+
+#if INLINE_SECTION_MEMO_CLOSE
+#define section_memo_close _section_memo_close
+#else
+void section_memo_close ();
+#endif
+
+static inline int
+_section_memo_get (Section * s, TransientSection * ts)
+{
+  int i;
+  JBDOUBLE dz;
+  gpointer key, value;
+  TransientSection *ts2;
+  Section *s2;
+#if DEBUG_SECTION_MEMO_GET
+  fprintf (stderr, "Section memo get: start\n");
+#endif
+  g_mutex_lock (mutex);
+  i = g_hash_table_lookup_extended (section_memo, ts, &key, &value);
+  g_mutex_unlock (mutex);
+  if (!i)
+    goto exit0;
+  ts2 = (TransientSection *) key;
+  s2 = (Section *) value;
+  if (!section_copy (s, s2, NULL))
+    goto exit0;
+  dz = ts->zmin - ts2->zmin;
+  if (dz != 0.)
+    {
+      for (i = 0; i <= s->n; ++i)
+        s->sp[i].z += dz;
+      s->zmin += dz;
+      s->zleft += dz;
+      s->zright += dz;
+      section_open_parameters (s);
+    }
+#if DEBUG_SECTION_MEMO_GET
+  fprintf (stderr, "SMG dz=" FWL "\n", dz);
+  fprintf (stderr, "Section memo get: end\n");
+#endif
+  return 1;
+
+exit0:
+#if DEBUG_SECTION_MEMO_GET
+  fprintf (stderr, "Section memo get: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SECTION_MEMO_GET
+#define section_memo_get _section_memo_get
+#else
+int section_memo_get (Section *, TransientSection *);
+#endif
+
+static inline void
+_section_memo_add (Section * s, TransientSection * ts)
+{
+  Section *s2;
+#if DEBUG_SECTION_MEMO_ADD
+  fprintf (stderr, "Section memo add: start\n");
+#endif
+  s2 = (Section *) g_try_malloc (sizeof (Section));
+  if (!s2)
+    goto exit0;
+  s2->storage = 0;
+  s2->sp = NULL;
+  s2->fp = NULL;
+  s2->rsp = s2->rfp = NULL;
+  if (!section_copy (s2, s, NULL))
+    {
+      g_free (s2);
+      goto exit0;
+    }
+  g_mutex_lock (mutex);
+  if (g_hash_table_contains (section_memo, ts))
+    section_memo_free (s2);
+  else
+    g_hash_table_insert (section_memo, ts, s2);
+  g_mutex_unlock (mutex);
+
+exit0:
+#if DEBUG_SECTION_MEMO_ADD
+  fprintf (stderr, "Section memo add: end\n");
+#endif
+  return;
+}
+
+#if INLINE_SECTION_MEMO_ADD
+#define section_memo_add _section_memo_add
+#else
+void section_memo_add (Section *, TransientSection *);
+#endif
+
+static inline TransientSection *
+_section_memo_key (TransientSection * ts)
+{
+  gpointer key;
+  g_mutex_lock (mutex);
+  if (!g_hash_table_lookup_extended (section_memo, ts, &key, NULL))
+    key = NULL;
+  g_mutex_unlock (mutex);
+  return (TransientSection *) key;
+}
+
+#if INLINE_SECTION_MEMO_KEY
+#define section_memo_key _section_memo_key
+#else
+TransientSection *section_memo_key (TransientSection *);
+#endif
+
+static inline guint
+_section_pair_memo_hash (gconstpointer data)
+{
+  guint h;
+  SectionPair *pair;
+  pair = (SectionPair *) data;
+  h = g_direct_hash (pair->ts1) * 16777619u ^ g_direct_hash (pair->ts2);
+  return section_hash_add (h, pair->k);
+}
+
+#if INLINE_SECTION_PAIR_MEMO_HASH
+#define section_pair_memo_hash _section_pair_memo_hash
+#else
+guint section_pair_memo_hash (gconstpointer);
+#endif
+
+static inline gboolean
+_section_pair_memo_equal (gconstpointer data1, gconstpointer data2)
+{
+  SectionPair *pair1, *pair2;
+  pair1 = (SectionPair *) data1;
+  pair2 = (SectionPair *) data2;
+  return pair1->ts1 == pair2->ts1 && pair1->ts2 == pair2->ts2
+    && pair1->k == pair2->k;
+}
+
+#if INLINE_SECTION_PAIR_MEMO_EQUAL
+#define section_pair_memo_equal _section_pair_memo_equal
+#else
+gboolean section_pair_memo_equal (gconstpointer, gconstpointer);
+#endif
+
+static inline void
+_section_pair_memo_free (gpointer data)
+{
+  SectionPair *pair;
+  pair = (SectionPair *) data;
+  section_release ((void **) &pair->s->fp, &pair->s->rfp,
+                   pair->s->storage & SECTION_STORAGE_ARENA_FRICTION);
+  g_free (pair);
+}
+
+#if INLINE_SECTION_PAIR_MEMO_FREE
+#define section_pair_memo_free _section_pair_memo_free
+#else
+void section_pair_memo_free (gpointer);
+#endif
+
+static inline void
+_section_pair_memo_open ()
+{
+#if DEBUG_SECTION_PAIR_MEMO_OPEN
+  fprintf (stderr, "Section pair memo open: start\n");
+#endif
+  section_pair_memo = g_hash_table_new_full
+    (section_pair_memo_hash, section_pair_memo_equal, section_pair_memo_free,
+     NULL);
+#if DEBUG_SECTION_PAIR_MEMO_OPEN
+  fprintf (stderr, "Section pair memo open: end\n");
+#endif
+}
+
+#if INLINE_SECTION_PAIR_MEMO_OPEN
+#define section_pair_memo_open _section_pair_memo_open
+#else
+void section_pair_memo_open ();
+#endif
+
+static inline void
+_section_pair_memo_close ()
+{
+#if DEBUG_SECTION_PAIR_MEMO_CLOSE
+  fprintf (stderr, "Section pair memo close: start\n");
+#endif
+  if (section_pair_memo)
+    {
+#if DEBUG_SECTION_PAIR_MEMO_CLOSE
+      fprintf (stderr, "SPMC pairs=%u\n",
+               g_hash_table_size (section_pair_memo));
+#endif
+      g_hash_table_destroy (section_pair_memo);
+      section_pair_memo = NULL;
+    }
+#if DEBUG_SECTION_PAIR_MEMO_CLOSE
+  fprintf (stderr, "Section pair memo close: end\n");
+#endif
+}
+
+#if INLINE_SECTION_PAIR_MEMO_CLOSE
+#define section_pair_memo_close _section_pair_memo_close
+#else
+void section_pair_memo_close ();
+#endif
+
+static inline int _section_pair_memo_get
+  (Section * s, TransientSection * ts1, TransientSection * ts2, JBDOUBLE k)
+{
+  int i;
+  SectionPair key[1], *pair;
+#if DEBUG_SECTION_PAIR_MEMO_GET
+  fprintf (stderr, "Section pair memo get: start\n");
+#endif
+  key->ts1 = ts1;
+  key->ts2 = ts2;
+  key->k = k;
+  g_mutex_lock (mutex);
+  pair = (SectionPair *) g_hash_table_lookup (section_pair_memo, key);
+  i = pair && section_share (s, pair->s, 1);
+  g_mutex_unlock (mutex);
+  if (i)
+    s->dz = pair->s->dz;
+#if DEBUG_SECTION_PAIR_MEMO_GET
+  fprintf (stderr, "SPMG found=%d\n", i);
+  fprintf (stderr, "Section pair memo get: end\n");
+#endif
+  return i;
+}
+
+#if INLINE_SECTION_PAIR_MEMO_GET
+#define section_pair_memo_get _section_pair_memo_get
+#else
+int section_pair_memo_get
+  (Section *, TransientSection *, TransientSection *, JBDOUBLE);
+#endif
+
+static inline void _section_pair_memo_add
+  (Section * s, TransientSection * ts1, TransientSection * ts2, JBDOUBLE k)
+{
+  SectionPair *pair;
+#if DEBUG_SECTION_PAIR_MEMO_ADD
+  fprintf (stderr, "Section pair memo add: start\n");
+#endif
+  pair = (SectionPair *) g_try_malloc (sizeof (SectionPair));
+  if (!pair)
+    goto exit0;
+  pair->ts1 = ts1;
+  pair->ts2 = ts2;
+  pair->k = k;
+  pair->s->fp = NULL;
+  pair->s->rfp = NULL;
+  pair->s->storage = 0;
+  pair->s->dz = s->dz;
+  g_mutex_lock (mutex);
+  if (g_hash_table_contains (section_pair_memo, pair)
+      || !section_share (pair->s, s, 1))
+    g_free (pair);
+  else
+    g_hash_table_add (section_pair_memo, pair);
+  g_mutex_unlock (mutex);
+
+exit0:
+#if DEBUG_SECTION_PAIR_MEMO_ADD
+  fprintf (stderr, "Section pair memo add: end\n");
+#endif
+  return;
+}
+
+#if INLINE_SECTION_PAIR_MEMO_ADD
+#define section_pair_memo_add _section_pair_memo_add
+#else
+void section_pair_memo_add
+  (Section *, TransientSection *, TransientSection *, JBDOUBLE);
+#endif
+
 static inline int
 _section_open (Section * s, TransientSection * ts)
 {
@@ -1403,6 +2192,12 @@ _section_open (Section * s, TransientSection * ts)
   transient_section_print (ts, stderr);
 #endif
 
+  if (section_memo && section_memo_get (s, ts))
+    {
+      i = 1;
+      goto exit4;
+    }
+
   i = ts->n + 1;
   py = (JBFLOAT *) g_try_malloc (i * 2 * sizeof (JBFLOAT));
   if (!py)
@@ -1424,7 +2219,7 @@ _section_open (Section * s, TransientSection * ts)
       goto exit4;
     }
   nr = ceill (ts->hmax / ts->dz);
-  if (!section_create (s, n, nr))
+  if (!section_create (s, n, nr, NULL))
     goto exit2;
 
   for (i = 0, sp = s->sp; i <= n; ++i, ++sp)
@@ -1607,7 +2402,7 @@ _section_open (Section * s, TransientSection * ts)
 			(MODEL_FRICTION == MODEL_FRICTION_CONSTANT_SLOPE)
       fp->r = A / jbm_fsqr (fp->r);
 #endif
-      fp->r *= A * pow (R, friction_2b1);
+      fp->r *= A * friction_pow (R, friction_2b1);
 #if DEBUG_SECTION_OPEN
       fprintf (stderr, "SO r=" FWF " beta=" FWF " dbetaA=" FWF "\n",
                fp->r, fp->beta, fp->dbetaA);
@@ -1621,6 +2416,8 @@ _section_open (Section * s, TransientSection * ts)
 #if DEBUG_SECTION_OPEN
   section_print (s, stderr);
 #endif
+  if (section_memo)
+    section_memo_add (s, ts);
   goto exit3;
 
 exit1:
@@ -37,6 +37,14 @@ section_changes_print (SectionChanges * sc, FILE * file)
 }
 #endif
 
+#if !INLINE_SECTION_CHANGES_NEXT
+JBDOUBLE
+section_changes_next (SectionChanges * sc)
+{
+  return _section_changes_next (sc);
+}
+#endif
+
 #if !INLINE_SECTION_CHANGES_TMAX
 void
 section_changes_tmax (SectionChanges * sc)
@@ -109,6 +117,30 @@ list_section_gauge_open (GSList ** list, ChannelGeometry * cg)
 }
 #endif
 
+#if !INLINE_SECTION_GEOMETRY_DELETE
+void
+section_geometry_delete (SectionGeometry * g)
+{
+  _section_geometry_delete (g);
+}
+#endif
+
+#if !INLINE_SECTION_VARIABLE_DELETE
+void
+section_variable_delete (SectionVariable * sv)
+{
+  _section_variable_delete (sv);
+}
+#endif
+
+#if !INLINE_LIST_VARIABLE_SEGMENTS_DELETE
+void
+list_variable_segments_delete (GSList ** list)
+{
+  _list_variable_segments_delete (list);
+}
+#endif
+
 #if !INLINE_LIST_VARIABLE_SEGMENTS_OPEN
 int
 list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
@@ -116,3 +148,21 @@ list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
   return _list_variable_segments_open (list, cg);
 }
 #endif
+
+#if !INLINE_LIST_SECTION_GAUGE_LINK
+void
+list_section_gauge_link (GSList * list_section_gauge,
+                         GSList * list_variable_segments)
+{
+  _list_section_gauge_link (list_section_gauge, list_variable_segments);
+}
+#endif
+
+#if !INLINE_LIST_SECTION_CHANGES_LINK
+void
+list_section_changes_link (GSList * list_section_changes,
+                           GSList * list_variable_segments)
+{
+  _list_section_changes_link (list_section_changes, list_variable_segments);
+}
+#endif
@@ -30,7 +30,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef SECTION_CHANGES__H
 #define SECTION_CHANGES__H 1
 
-#include "channel_geometry.h"
+#include "channel_segment.h"
 
 extern GMutex mutex[1];
 
@@ -38,19 +38,31 @@ extern JBDOUBLE t, tmax;
 
 typedef struct
 {
-  CrossSection *cs;
-} SectionChanges;
+  TransientSection *ts1, *ts2;
+  Section *s;
+  int n;
+} SectionGeometry;
 
 typedef struct
 {
-  CrossSection *cs, *csc;
-} SectionGauge;
+  JBFLOAT *x;
+  CrossSection *cs;
+  TransientSection *ts1, *ts2;
+  GSList *geometry;
+} SectionVariable;
 
 typedef struct
 {
-  JBFLOAT *x;
   CrossSection *cs;
-} SectionVariable;
+  SectionVariable *sv[2];
+  int i;
+} SectionChanges;
+
+typedef struct
+{
+  CrossSection *cs, *csc;
+  SectionVariable *sv[2];
+} SectionGauge;
 
 static inline void
 _section_changes_print (SectionChanges * sc, FILE * file)
@@ -66,40 +78,51 @@ _section_changes_print (SectionChanges * sc, FILE * file)
 void section_changes_print (SectionChanges *, FILE *);
 #endif
 
-static inline void
-_section_changes_tmax (SectionChanges * sc)
+static inline JBDOUBLE
+_section_changes_next (SectionChanges * sc)
 {
   register int i;
   register CrossSection *cs = sc->cs;
+  if (t >= cs->ts[cs->n].t)
+    return INFINITY;
+  i = sc->i;
+  if (t < cs->ts[i].t)
+    i = jbm_vdarray_search (t, &cs->ts->t, sizeof (TransientSection), cs->n);
+  else
+    while (i < cs->n && t >= cs->ts[i + 1].t)
+      ++i;
+  sc->i = i;
+  if (i < cs->n)
+    return cs->ts[i + 1].t;
+  return INFINITY;
+}
+
+#if INLINE_SECTION_CHANGES_NEXT
+#define section_changes_next _section_changes_next
+#else
+JBDOUBLE section_changes_next (SectionChanges *);
+#endif
+
+static inline void
+_section_changes_tmax (SectionChanges * sc)
+{
+  register JBDOUBLE ts;
 #if DEBUG_SECTION_CHANGES_TMAX
   fprintf (stderr, "Section changes tmax: start\n");
   fprintf (stderr, "SCT t=" FWL " tmax=" FWL "\n", t, tmax);
 #endif
-  if (t >= cs->ts[cs->n].t)
-    goto exit;
-  i = jbm_vdarray_search (t, &cs->ts->t, sizeof (TransientSection), cs->n);
-#if DEBUG_SECTION_CHANGES_TMAX
-  fprintf (stderr, "SCT i=%d n=%d\n", i, cs->n);
-#endif
-  if (i < cs->n)
+  ts = section_changes_next (sc);
+  if (ts < tmax)
     {
-      if (cs->ts[i + 1].t < tmax)
-        {
-          g_mutex_lock (mutex);
-          tmax = cs->ts[i + 1].t;
-          g_mutex_unlock (mutex);
-        }
-#if DEBUG_SECTION_CHANGES_TMAX
-      fprintf (stderr,
-               "SCT i=%d ti=" FWL " tmax=" FWL "\n", i, cs->ts[i + 1].t, tmax);
-#endif
+      g_mutex_lock (mutex);
+      if (ts < tmax)
+        tmax = ts;
+      g_mutex_unlock (mutex);
     }
-exit:
 #if DEBUG_SECTION_CHANGES_TMAX
-  fprintf (stderr, "SCT tmax=" FWL "\n", tmax);
+  fprintf (stderr, "SCT i=%d ti=" FWL " tmax=" FWL "\n", sc->i, ts, tmax);
   fprintf (stderr, "Section changes tmax: end\n");
 #endif
-  return;
 }
 
 #if INLINE_SECTION_CHANGES_TMAX
@@ -168,6 +191,8 @@ _list_section_changes_open (GSList ** list, ChannelGeometry * cg)
             return 0;
           }
         sc->cs = cs;
+        sc->sv[0] = sc->sv[1] = NULL;
+        sc->i = 0;
         *list = g_slist_prepend (*list, sc);
       }
 #if DEBUG_LIST_SECTION_CHANGES_OPEN
@@ -208,7 +233,8 @@ _section_gauge_tmax (SectionGauge * sg)
   if (sg->cs->tmax < tmax)
     {
       g_mutex_lock (mutex);
-      tmax = sg->cs->tmax;
+      if (sg->cs->tmax < tmax)
+        tmax = sg->cs->tmax;
       g_mutex_unlock (mutex);
     }
 #if DEBUG_SECTION_GAUGE_TMAX
@@ -285,11 +311,14 @@ _list_section_gauge_open (GSList ** list, ChannelGeometry * cg)
           }
         sg->csc = cg->cs + cs->control - 1;
         sg->cs = cs;
+        sg->sv[0] = sg->sv[1] = NULL;
         *list = g_slist_prepend (*list, sg);
         cs->j = 0;
         cs->nt = 0;
         cs->pt = 0.;
-        cs->tmax = cs->time;
+        cs->tmax = -INFINITY;
+        cs->position = 0.;
+        cs->error = 0.;
       }
 #if DEBUG_LIST_SECTION_GAUGE_OPEN
   fprintf (stderr, "List section gauge open: end\n");
@@ -303,6 +332,53 @@ _list_section_gauge_open (GSList ** list, ChannelGeometry * cg)
 int list_section_gauge_open (GSList **, ChannelGeometry *);
 #endif
 
+static inline void
+_section_geometry_delete (SectionGeometry * g)
+{
+  int i;
+  for (i = 0; i <= g->n; ++i)
+    section_delete (g->s + i);
+  g_free (g->s);
+  g_free (g);
+}
+
+#if INLINE_SECTION_GEOMETRY_DELETE
+#define section_geometry_delete _section_geometry_delete
+#else
+void section_geometry_delete (SectionGeometry *);
+#endif
+
+static inline void
+_section_variable_delete (SectionVariable * sv)
+{
+  GSList *list;
+  for (list = sv->geometry; list; list = list->next)
+    section_geometry_delete ((SectionGeometry *) list->data);
+  g_slist_free (sv->geometry);
+  sv->geometry = NULL;
+}
+
+#if INLINE_SECTION_VARIABLE_DELETE
+#define section_variable_delete _section_variable_delete
+#else
+void section_variable_delete (SectionVariable *);
+#endif
+
+static inline void
+_list_variable_segments_delete (GSList ** list)
+{
+  GSList *l;
+  for (l = *list; l; l = l->next)
+    section_variable_delete ((SectionVariable *) l->data);
+  jb_slist_free (list);
+}
+
+#if INLINE_LIST_VARIABLE_SEGMENTS_DELETE
+#define list_variable_segments_delete _list_variable_segments_delete
+#else
+void list_variable_segments_delete (GSList **);
+#endif
+
 static inline int
 _list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
 {
@@ -312,7 +388,7 @@ _list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
 #if DEBUG_LIST_VARIABLE_SEGMENTS_OPEN
   fprintf (stderr, "List variable segments open: start\n");
 #endif
-  jb_slist_free (list);
+  list_variable_segments_delete (list);
   for (i = cg->n, cs = cg->cs + cg->n - 1; --i >= 0; --cs)
     if (cs->n || (cs + 1)->n)
       {
@@ -328,6 +404,9 @@ _list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
           }
         sv->cs = cs;
         sv->x = cg->x + i;
+        sv->ts1 = cs->ts;
+        sv->ts2 = (cs + 1)->ts;
+        sv->geometry = NULL;
         *list = g_slist_prepend (*list, sv);
       }
 #if DEBUG_LIST_VARIABLE_SEGMENTS_OPEN
@@ -342,4 +421,59 @@ _list_variable_segments_open (GSList ** list, ChannelGeometry * cg)
 int list_variable_segments_open (GSList **, ChannelGeometry *);
 #endif
 
+static inline void
+_list_section_gauge_link (GSList * list_section_gauge,
+                          GSList * list_variable_segments)
+{
+  GSList *list;
+  SectionGauge *sg;
+  SectionVariable *sv;
+  for (; list_section_gauge; list_section_gauge = list_section_gauge->next)
+    {
+      sg = (SectionGauge *) list_section_gauge->data;
+      for (list = list_variable_segments; list; list = list->next)
+        {
+          sv = (SectionVariable *) list->data;
+          if (sv->cs + 1 == sg->cs)
+            sg->sv[0] = sv;
+          else if (sv->cs == sg->cs)
+            sg->sv[1] = sv;
+        }
+    }
+}
+
+#if INLINE_LIST_SECTION_GAUGE_LINK
+#define list_section_gauge_link _list_section_gauge_link
+#else
+void list_section_gauge_link (GSList *, GSList *);
+#endif
+
+static inline void
+_list_section_changes_link (GSList * list_section_changes,
+                            GSList * list_variable_segments)
+{
+  GSList *list;
+  SectionChanges *sc;
+  SectionVariable *sv;
+  for (; list_section_changes;
+       list_section_changes = list_section_changes->next)
+    {
+      sc = (SectionChanges *) list_section_changes->data;
+      for (list = list_variable_segments; list; list = list->next)
+        {
+          sv = (SectionVariable *) list->data;
+          if (sv->cs + 1 == sc->cs)
+            sc->sv[0] = sv;
+          else if (sv->cs == sc->cs)
+            sc->sv[1] = sv;
+        }
+    }
+}
+
+#if INLINE_LIST_SECTION_CHANGES_LINK
+#define list_section_changes_link _list_section_changes_link
+#else
+void list_section_changes_link (GSList *, GSList *);
+#endif
+
 #endif
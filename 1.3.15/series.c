@@ -0,0 +1,332 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file series.c
+ * \brief Source file to define the lookup of the boundary time series.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#include "series.h"
+
+/**
+ * \fn void series_cursor_reset(SeriesCursor *c)
+ * \brief Function to unset a time series cursor.
+ * \param c
+ * \brief time series cursor.
+ */
+#if !INLINE_SERIES_CURSOR_RESET
+void
+series_cursor_reset (SeriesCursor * c)
+{
+  _series_cursor_reset (c);
+}
+#endif
+
+/**
+ * \fn int series_search(JBDOUBLE t, JBDOUBLE *x, int n)
+ * \brief Function to search the interval of a time in a times array.
+ * \param t
+ * \brief time.
+ * \param x
+ * \brief array of times.
+ * \param n
+ * \brief last index of the array.
+ * \return interval index, -1 before the first time and n after the last time.
+ */
+#if !INLINE_SERIES_SEARCH
+int
+series_search (JBDOUBLE t, JBDOUBLE * x, int n)
+{
+  return _series_search (t, x, n);
+}
+#endif
+
+/**
+ * \fn JBDOUBLE series_interpolate(SeriesCursor *c, JBDOUBLE t, JBDOUBLE *x, \
+ *   JBFLOAT *p, int n)
+ * \brief Function to interpolate a time series moving its cursor.
+ * \param c
+ * \brief time series cursor.
+ * \param t
+ * \brief time.
+ * \param x
+ * \brief array of times.
+ * \param p
+ * \brief array of parameters.
+ * \param n
+ * \brief last index of the arrays.
+ * \return interpolated parameter.
+ */
+#if !INLINE_SERIES_INTERPOLATE
+JBDOUBLE
+series_interpolate (SeriesCursor * c, JBDOUBLE t, JBDOUBLE * x, JBFLOAT * p,
+                    int n)
+{
+  return _series_interpolate (c, t, x, p, n);
+}
+#endif
+
+/**
+ * \fn JBDOUBLE series_integral(SeriesCursor *c, JBDOUBLE t, JBDOUBLE t2, \
+ *   JBDOUBLE *x, JBFLOAT *p, int n)
+ * \brief Function to integrate a time series in a time interval moving its
+ *   cursor.
+ * \param c
+ * \brief time series cursor.
+ * \param t
+ * \brief initial time.
+ * \param t2
+ * \brief final time.
+ * \param x
+ * \brief array of times.
+ * \param p
+ * \brief array of parameters.
+ * \param n
+ * \brief last index of the arrays.
+ * \return integral of the parameter.
+ */
+#if !INLINE_SERIES_INTEGRAL
+JBDOUBLE
+series_integral (SeriesCursor * c, JBDOUBLE t, JBDOUBLE t2, JBDOUBLE * x,
+                 JBFLOAT * p, int n)
+{
+  return _series_integral (c, t, t2, x, p, n);
+}
+#endif
+
+/**
+ * \fn void series_file_init_empty(SeriesFile *sf)
+ * \brief Function to init an empty time series file.
+ * \param sf
+ * \brief time series file.
+ */
+#if !INLINE_SERIES_FILE_INIT_EMPTY
+void
+series_file_init_empty (SeriesFile * sf)
+{
+  _series_file_init_empty (sf);
+}
+#endif
+
+/**
+ * \fn void series_file_delete(SeriesFile *sf)
+ * \brief Function to close a time series file and to free its name.
+ * \param sf
+ * \brief time series file.
+ */
+#if !INLINE_SERIES_FILE_DELETE
+void
+series_file_delete (SeriesFile * sf)
+{
+  _series_file_delete (sf);
+}
+#endif
+
+/**
+ * \fn int series_file_copy(SeriesFile *sf, SeriesFile *sf_copy, int n)
+ * \brief Function to copy the definition of a time series file.
+ * \param sf
+ * \brief time series file copy.
+ * \param sf_copy
+ * \brief time series file to copy.
+ * \param n
+ * \brief last index of the copied window arrays.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SERIES_FILE_COPY
+int
+series_file_copy (SeriesFile * sf, SeriesFile * sf_copy, int n)
+{
+  return _series_file_copy (sf, sf_copy, n);
+}
+#endif
+
+/**
+ * \fn int series_file_open_xml(SeriesFile *sf, xmlNode *node, int np)
+ * \brief Function to read the definition of a time series file on a XML node.
+ * \param sf
+ * \brief time series file.
+ * \param node
+ * \brief XML node.
+ * \param np
+ * \brief number of parameters of every record.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SERIES_FILE_OPEN_XML
+int
+series_file_open_xml (SeriesFile * sf, xmlNode * node, int np)
+{
+  return _series_file_open_xml (sf, node, np);
+}
+#endif
+
+/**
+ * \fn void series_file_save_xml(SeriesFile *sf, xmlNode *node)
+ * \brief Function to save the definition of a time series file on a XML node.
+ * \param sf
+ * \brief time series file.
+ * \param node
+ * \brief XML node.
+ */
+#if !INLINE_SERIES_FILE_SAVE_XML
+void
+series_file_save_xml (SeriesFile * sf, xmlNode * node)
+{
+  _series_file_save_xml (sf, node);
+}
+#endif
+
+/**
+ * \fn int series_file_open(SeriesFile *sf, char *directory)
+ * \brief Function to open a time series file to read its first window.
+ * \param sf
+ * \brief time series file.
+ * \param directory
+ * \brief system directory.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SERIES_FILE_OPEN
+int
+series_file_open (SeriesFile * sf, char *directory)
+{
+  return _series_file_open (sf, directory);
+}
+#endif
+
+/**
+ * \fn int series_file_read(SeriesFile *sf, JBDOUBLE *t, JBFLOAT *p)
+ * \brief Function to read the next record of a time series file.
+ * \param sf
+ * \brief time series file.
+ * \param t
+ * \brief pointer to the record time.
+ * \param p
+ * \brief array of the record parameters.
+ * \return 1 on success, 0 on the file end or on a bad record.
+ */
+#if !INLINE_SERIES_FILE_READ
+int
+series_file_read (SeriesFile * sf, JBDOUBLE * t, JBFLOAT * p)
+{
+  return _series_file_read (sf, t, p);
+}
+#endif
+
+/**
+ * \fn int series_file_window(SeriesFile *sf, JBDOUBLE t, JBDOUBLE t2, \
+ *   JBDOUBLE **x, JBFLOAT **p1, JBFLOAT **p2, int *n, SeriesCursor *c, int nc)
+ * \brief Function to move the window of a time series file to hold a time
+ *   interval.
+ * \param sf
+ * \brief time series file.
+ * \param t
+ * \brief initial time.
+ * \param t2
+ * \brief final time.
+ * \param x
+ * \brief pointer to the window array of times.
+ * \param p1
+ * \brief pointer to the window array of first parameters.
+ * \param p2
+ * \brief pointer to the window array of second parameters.
+ * \param n
+ * \brief pointer to the last index of the window arrays.
+ * \param c
+ * \brief array of cursors on the window.
+ * \param nc
+ * \brief number of cursors.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SERIES_FILE_WINDOW
+int
+series_file_window (SeriesFile * sf, JBDOUBLE t, JBDOUBLE t2, JBDOUBLE ** x,
+                    JBFLOAT ** p1, JBFLOAT ** p2, int *n, SeriesCursor * c,
+                    int nc)
+{
+  return _series_file_window (sf, t, t2, x, p1, p2, n, c, nc);
+}
+#endif
+
+/**
+ * \fn void series_grid_init_empty(SeriesGrid *g)
+ * \brief Function to init an empty resampled time series.
+ * \param g
+ * \brief resampled time series.
+ */
+#if !INLINE_SERIES_GRID_INIT_EMPTY
+void
+series_grid_init_empty (SeriesGrid * g)
+{
+  _series_grid_init_empty (g);
+}
+#endif
+
+/**
+ * \fn void series_grid_delete(SeriesGrid *g)
+ * \brief Function to free the memory used by a resampled time series.
+ * \param g
+ * \brief resampled time series.
+ */
+#if !INLINE_SERIES_GRID_DELETE
+void
+series_grid_delete (SeriesGrid * g)
+{
+  _series_grid_delete (g);
+}
+#endif
+
+/**
+ * \fn int series_grid_open(SeriesGrid *g, JBDOUBLE h, JBDOUBLE *x, \
+ *   JBFLOAT *p1, JBFLOAT *p2, int n, JBDOUBLE *e)
+ * \brief Function to resample a time series on a uniform time grid.
+ * \param g
+ * \brief resampled time series.
+ * \param h
+ * \brief time interval of the grid.
+ * \param x
+ * \brief array of times.
+ * \param p1
+ * \brief array of first parameters.
+ * \param p2
+ * \brief array of second parameters, NULL if not used.
+ * \param n
+ * \brief last index of the arrays.
+ * \param e
+ * \brief pointer to the maximum interpolation error.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SERIES_GRID_OPEN
+int
+series_grid_open (SeriesGrid * g, JBDOUBLE h, JBDOUBLE * x, JBFLOAT * p1,
+                  JBFLOAT * p2, int n, JBDOUBLE * e)
+{
+  return _series_grid_open (g, h, x, p1, p2, n, e);
+}
+#endif
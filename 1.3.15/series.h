@@ -0,0 +1,740 @@
+/*
+SWIGS (Shallow Water in Irregular Geometries Simulator): a software to simulate
+transient or steady flows with solute transport in channels, channel networks
+and rivers.
+
+Copyright 2005-2015 Javier Burguete Tolosa.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice,
+		this list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+		this list of conditions and the following disclaimer in the
+		documentation and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY Javier Burguete Tolosa ``AS IS'' AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL Javier Burguete Tolosa OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+ * \file series.h
+ * \brief Header file to define the lookup of the boundary time series.
+ * \author Javier Burguete Tolosa.
+ * \copyright Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved.
+ */
+#ifndef SERIES__H
+#define SERIES__H 1
+
+#include "points.h"
+
+/**
+ * \struct SeriesCursor
+ * \brief Structure to define a cursor on a time series keeping the
+ *   interpolation coefficients of the actual time interval.
+ */
+typedef struct
+{
+/**
+ * \var t0
+ * \brief initial time of the actual interval.
+ * \var t1
+ * \brief final time of the actual interval.
+ * \var x0
+ * \brief time origin of the interpolation.
+ * \var p0
+ * \brief parameter value at the time origin.
+ * \var k
+ * \brief parameter slope in the actual interval.
+ * \var h
+ * \brief time interval of a uniform time series, 0 if irregular.
+ * \var i
+ * \brief index of the actual interval, -1 before the first time, n after the
+ *   last time and -2 if unset.
+ */
+  JBDOUBLE t0, t1, x0, p0, k, h;
+  int i;
+} SeriesCursor;
+
+static inline void
+_series_cursor_reset (SeriesCursor * c)
+{
+#if DEBUG_SERIES_CURSOR_RESET
+  fprintf (stderr, "series_cursor_reset: start\n");
+#endif
+  c->t0 = c->t1 = c->x0 = c->p0 = c->k = c->h = 0.;
+  c->i = -2;
+#if DEBUG_SERIES_CURSOR_RESET
+  fprintf (stderr, "series_cursor_reset: end\n");
+#endif
+}
+
+#if INLINE_SERIES_CURSOR_RESET
+#define series_cursor_reset _series_cursor_reset
+#else
+void series_cursor_reset (SeriesCursor *);
+#endif
+
+static inline int
+_series_search (JBDOUBLE t, JBDOUBLE * x, int n)
+{
+  int i, j;
+#if DEBUG_SERIES_SEARCH
+  fprintf (stderr, "series_search: start\n");
+#endif
+  if (t < x[0])
+    i = -1;
+  else if (t >= x[n])
+    i = n;
+  else
+    for (i = 0; n - i > 1;)
+      {
+        j = (i + n) >> 1;
+        if (t < x[j])
+          n = j;
+        else
+          i = j;
+      }
+#if DEBUG_SERIES_SEARCH
+  fprintf (stderr, "SS t=" FWL " i=%d\n", t, i);
+  fprintf (stderr, "series_search: end\n");
+#endif
+  return i;
+}
+
+#if INLINE_SERIES_SEARCH
+#define series_search _series_search
+#else
+int series_search (JBDOUBLE, JBDOUBLE *, int);
+#endif
+
+static inline JBDOUBLE _series_interpolate
+  (SeriesCursor * c, JBDOUBLE t, JBDOUBLE * x, JBFLOAT * p, int n)
+{
+  int i, j;
+#if DEBUG_SERIES_INTERPOLATE
+  fprintf (stderr, "series_interpolate: start\n");
+  fprintf (stderr, "SI t=" FWL " i=%d t0=" FWL " t1=" FWL "\n",
+           t, c->i, c->t0, c->t1);
+#endif
+  if (c->i < -1 || t < c->t0 || t >= c->t1)
+    {
+      // the time advances monotonously in the transient simulations so the
+      // cursor is walked to the next intervals, the long jumps and the rewinds
+      // of the steady iterations are searched
+      i = c->i;
+      if (c->h > 0.)
+        {
+          // direct indexing on the uniform time series
+          if (t < x[0])
+            i = -1;
+          else if (t >= x[n])
+            i = n;
+          else
+            {
+              i = (int) ((t - x[0]) / c->h);
+              if (i >= n)
+                i = n - 1;
+              if (t < x[i])
+                --i;
+              else if (t >= x[i + 1])
+                ++i;
+            }
+        }
+      else if (i < -1 || i > n)
+        i = series_search (t, x, n);
+      else
+        {
+          for (j = SERIES_CURSOR_STEPS; i >= 0 && t < x[i]; --i)
+            if (!--j)
+              break;
+          for (; i < n && t >= x[i + 1]; ++i)
+            if (!--j)
+              break;
+          if (!j)
+            i = series_search (t, x, n);
+        }
+      c->i = i;
+      if (i < 0)
+        {
+          c->t0 = -INFINITY;
+          c->t1 = x[0];
+          c->x0 = c->k = 0.;
+          c->p0 = p[0];
+        }
+      else if (i >= n)
+        {
+          c->t0 = x[n];
+          c->t1 = INFINITY;
+          c->x0 = c->k = 0.;
+          c->p0 = p[n];
+        }
+      else
+        {
+          c->t0 = c->x0 = x[i];
+          c->t1 = x[i + 1];
+          c->p0 = p[i];
+          c->k = (p[i + 1] - p[i]) / (x[i + 1] - x[i]);
+        }
+    }
+#if DEBUG_SERIES_INTERPOLATE
+  fprintf (stderr, "SI i=%d p0=" FWL " k=" FWL "\n", c->i, c->p0, c->k);
+  fprintf (stderr, "series_interpolate: end\n");
+#endif
+  return c->p0 + c->k * (t - c->x0);
+}
+
+#if INLINE_SERIES_INTERPOLATE
+#define series_interpolate _series_interpolate
+#else
+JBDOUBLE series_interpolate
+  (SeriesCursor *, JBDOUBLE, JBDOUBLE *, JBFLOAT *, int);
+#endif
+
+static inline JBDOUBLE _series_integral
+  (SeriesCursor * c, JBDOUBLE t, JBDOUBLE t2, JBDOUBLE * x, JBFLOAT * p,
+   int n)
+{
+  JBDOUBLE k, p1, p2;
+#if DEBUG_SERIES_INTEGRAL
+  fprintf (stderr, "series_integral: start\n");
+  fprintf (stderr, "SI t=" FWL " t2=" FWL "\n", t, t2);
+#endif
+  p1 = series_interpolate (c, t, x, p, n);
+  for (k = 0.; t2 > c->t1; t = c->t0, p1 = p2)
+    {
+      p2 = series_interpolate (c, c->t1, x, p, n);
+      k += 0.5 * (p1 + p2) * (c->t0 - t);
+    }
+  p2 = series_interpolate (c, t2, x, p, n);
+  k += 0.5 * (p1 + p2) * (t2 - t);
+#if DEBUG_SERIES_INTEGRAL
+  fprintf (stderr, "SI integral=" FWL "\n", k);
+  fprintf (stderr, "series_integral: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_SERIES_INTEGRAL
+#define series_integral _series_integral
+#else
+JBDOUBLE series_integral
+  (SeriesCursor *, JBDOUBLE, JBDOUBLE, JBDOUBLE *, JBFLOAT *, int);
+#endif
+
+/**
+ * \enum SeriesFileFormat
+ * \brief Enumeration to define the formats of the time series files.
+ * \var SERIES_FILE_FORMAT_CSV
+ * \brief text lines with the date and the parameters separated by blanks,
+ *   commas or semicolons.
+ * \var SERIES_FILE_FORMAT_BINARY
+ * \brief records of native doubles with the time and the parameters.
+ */
+enum SeriesFileFormat
+{
+  SERIES_FILE_FORMAT_CSV = 0,
+  SERIES_FILE_FORMAT_BINARY = 1
+};
+
+/**
+ * \struct SeriesFile
+ * \brief Structure to define an external time series file read in windows.
+ */
+typedef struct
+{
+/**
+ * \var file
+ * \brief file pointer, NULL if not opened.
+ * \var name
+ * \brief file name relative to the system directory, NULL if the time series
+ *   is defined in the XML file.
+ * \var format
+ * \brief file format.
+ * \var np
+ * \brief number of parameters of every record.
+ * \var size
+ * \brief allocated records number of the window arrays.
+ * \var eof
+ * \brief 1 if all the file records have been read.
+ * \var reset
+ * \brief 1 if the window has to be reloaded from the file start.
+ */
+  FILE *file;
+  char *name;
+  int format, np, size, eof, reset;
+} SeriesFile;
+
+static inline void
+_series_file_init_empty (SeriesFile * sf)
+{
+#if DEBUG_SERIES_FILE_INIT_EMPTY
+  fprintf (stderr, "series_file_init_empty: start\n");
+#endif
+  sf->file = NULL;
+  sf->name = NULL;
+  sf->size = 0;
+#if DEBUG_SERIES_FILE_INIT_EMPTY
+  fprintf (stderr, "series_file_init_empty: end\n");
+#endif
+}
+
+#if INLINE_SERIES_FILE_INIT_EMPTY
+#define series_file_init_empty _series_file_init_empty
+#else
+void series_file_init_empty (SeriesFile *);
+#endif
+
+static inline void
+_series_file_delete (SeriesFile * sf)
+{
+#if DEBUG_SERIES_FILE_DELETE
+  fprintf (stderr, "series_file_delete: start\n");
+#endif
+  if (sf->file)
+    fclose (sf->file);
+  sf->file = NULL;
+  jb_free_null ((void **) &sf->name);
+  sf->size = 0;
+#if DEBUG_SERIES_FILE_DELETE
+  fprintf (stderr, "series_file_delete: end\n");
+#endif
+}
+
+#if INLINE_SERIES_FILE_DELETE
+#define series_file_delete _series_file_delete
+#else
+void series_file_delete (SeriesFile *);
+#endif
+
+static inline int
+_series_file_copy (SeriesFile * sf, SeriesFile * sf_copy, int n)
+{
+#if DEBUG_SERIES_FILE_COPY
+  fprintf (stderr, "series_file_copy: start\n");
+#endif
+  series_file_init_empty (sf);
+  if (sf_copy->name)
+    {
+      sf->name = jb_strdup (sf_copy->name);
+      if (!sf->name)
+        return 0;
+      sf->format = sf_copy->format;
+      sf->np = sf_copy->np;
+      sf->size = n + 1;
+    }
+#if DEBUG_SERIES_FILE_COPY
+  fprintf (stderr, "series_file_copy: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_SERIES_FILE_COPY
+#define series_file_copy _series_file_copy
+#else
+int series_file_copy (SeriesFile *, SeriesFile *, int);
+#endif
+
+static inline int
+_series_file_open_xml (SeriesFile * sf, xmlNode * node, int np)
+{
+  char *buffer;
+#if DEBUG_SERIES_FILE_OPEN_XML
+  fprintf (stderr, "series_file_open_xml: start\n");
+#endif
+  series_file_init_empty (sf);
+  buffer = (char *) xmlGetProp (node, XML_FILE);
+  sf->name = jb_strdup (buffer);
+  xmlFree (buffer);
+  if (!sf->name)
+    goto exit1;
+  sf->format = SERIES_FILE_FORMAT_CSV;
+  if (xmlHasProp (node, XML_FORMAT))
+    {
+      buffer = (char *) xmlGetProp (node, XML_FORMAT);
+      if (!xmlStrcmp ((const xmlChar *) buffer, XML_BINARY))
+        sf->format = SERIES_FILE_FORMAT_BINARY;
+      else if (xmlStrcmp ((const xmlChar *) buffer, XML_CSV))
+        {
+          xmlFree (buffer);
+          goto exit1;
+        }
+      xmlFree (buffer);
+    }
+  sf->np = np;
+#if DEBUG_SERIES_FILE_OPEN_XML
+  fprintf (stderr, "SFOX name=%s format=%d np=%d\n",
+           sf->name, sf->format, sf->np);
+  fprintf (stderr, "series_file_open_xml: end\n");
+#endif
+  return 1;
+
+exit1:
+  series_file_delete (sf);
+#if DEBUG_SERIES_FILE_OPEN_XML
+  fprintf (stderr, "series_file_open_xml: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SERIES_FILE_OPEN_XML
+#define series_file_open_xml _series_file_open_xml
+#else
+int series_file_open_xml (SeriesFile *, xmlNode *, int);
+#endif
+
+static inline void
+_series_file_save_xml (SeriesFile * sf, xmlNode * node)
+{
+#if DEBUG_SERIES_FILE_SAVE_XML
+  fprintf (stderr, "series_file_save_xml: start\n");
+#endif
+  xmlSetProp (node, XML_FILE, (const xmlChar *) sf->name);
+  if (sf->format == SERIES_FILE_FORMAT_BINARY)
+    xmlSetProp (node, XML_FORMAT, XML_BINARY);
+#if DEBUG_SERIES_FILE_SAVE_XML
+  fprintf (stderr, "series_file_save_xml: end\n");
+#endif
+}
+
+#if INLINE_SERIES_FILE_SAVE_XML
+#define series_file_save_xml _series_file_save_xml
+#else
+void series_file_save_xml (SeriesFile *, xmlNode *);
+#endif
+
+static inline int
+_series_file_open (SeriesFile * sf, char *directory)
+{
+  char *buffer;
+#if DEBUG_SERIES_FILE_OPEN
+  fprintf (stderr, "series_file_open: start\n");
+#endif
+  if (sf->file)
+    fclose (sf->file);
+  buffer = (char *) g_build_filename (directory, sf->name, NULL);
+  sf->file = g_fopen (buffer, "rb");
+  g_free (buffer);
+  sf->eof = 0;
+  sf->reset = 1;
+#if DEBUG_SERIES_FILE_OPEN
+  fprintf (stderr, "SFO name=%s file=%p\n", sf->name, sf->file);
+  fprintf (stderr, "series_file_open: end\n");
+#endif
+  return sf->file != NULL;
+}
+
+#if INLINE_SERIES_FILE_OPEN
+#define series_file_open _series_file_open
+#else
+int series_file_open (SeriesFile *, char *);
+#endif
+
+static inline int
+_series_file_read (SeriesFile * sf, JBDOUBLE * t, JBFLOAT * p)
+{
+  int i, k;
+  double r[3];
+  char *c, buffer[JB_BUFFER_SIZE];
+#if DEBUG_SERIES_FILE_READ
+  fprintf (stderr, "series_file_read: start\n");
+#endif
+  if (sf->format == SERIES_FILE_FORMAT_BINARY)
+    {
+      if (fread (r, sizeof (double), sf->np + 1, sf->file) != sf->np + 1)
+        goto exit1;
+      *t = r[0];
+      for (i = 0; i < sf->np; ++i)
+        p[i] = r[i + 1];
+      goto exit0;
+    }
+  do
+    {
+      if (!fgets (buffer, JB_BUFFER_SIZE, sf->file))
+        goto exit1;
+      for (c = buffer; *c == ' ' || *c == '\t'; ++c);
+    }
+  // blank, comment or header lines
+  while (!*c || !strchr ("0123456789+-.", *c));
+  for (k = 0; c[k]; ++k)
+    if (c[k] == ',' || c[k] == ';')
+      c[k] = ' ';
+  k = 0;
+  sscanf (c, "%*s%*s%*s%*s%*s%*s%n", &k);
+  if (!k || !c[k])
+    goto exit1;
+  c[k] = 0;
+  *t = jb_get_time (c, &i);
+  if (!i)
+    goto exit1;
+  if (sscanf (c + k + 1, FRF FRF, p, p + 1) < sf->np)
+    goto exit1;
+
+exit0:
+#if DEBUG_SERIES_FILE_READ
+  fprintf (stderr, "SFR t=" FWL " p=" FWF "\n", *t, p[0]);
+  fprintf (stderr, "series_file_read: end\n");
+#endif
+  return 1;
+
+exit1:
+#if DEBUG_SERIES_FILE_READ
+  fprintf (stderr, "series_file_read: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SERIES_FILE_READ
+#define series_file_read _series_file_read
+#else
+int series_file_read (SeriesFile *, JBDOUBLE *, JBFLOAT *);
+#endif
+
+static inline int _series_file_window
+  (SeriesFile * sf, JBDOUBLE t, JBDOUBLE t2, JBDOUBLE ** x, JBFLOAT ** p1,
+   JBFLOAT ** p2, int *n, SeriesCursor * c, int nc)
+{
+  int i, j;
+  JBDOUBLE tr;
+  JBFLOAT p[2];
+#if DEBUG_SERIES_FILE_WINDOW
+  fprintf (stderr, "series_file_window: start\n");
+  fprintf (stderr, "SFW t=" FWL " t2=" FWL " n=%d\n", t, t2, *n);
+#endif
+
+  // the window contains the time interval
+  if (!sf->reset && t >= (*x)[0] && (sf->eof || (*x)[*n] >= t2))
+    goto exit0;
+
+  if (sf->reset || t < (*x)[0])
+    {
+      // rewinding on the initial time or on the steady iterations
+      rewind (sf->file);
+      sf->eof = sf->reset = 0;
+      *n = -1;
+    }
+  else
+    {
+      // dropping the records before the interval of the initial time
+      i = series_search (t, *x, *n);
+      if (i > 0)
+        {
+          *n -= i;
+          j = (*n + 1) * sizeof (JBDOUBLE);
+          memmove (*x, *x + i, j);
+          j = (*n + 1) * sizeof (JBFLOAT);
+          memmove (*p1, *p1 + i, j);
+          if (sf->np > 1)
+            memmove (*p2, *p2 + i, j);
+        }
+    }
+
+  // filling the window up to its size and at least up to the final time
+  while (!sf->eof && (*n < 0 || (*x)[*n] < t2 || *n + 1 < sf->size))
+    {
+      if (!series_file_read (sf, &tr, p))
+        {
+          sf->eof = 1;
+          break;
+        }
+      if (*n < 0 || (*x)[*n] > t || tr > t)
+        {
+          if (*n + 1 >= sf->size)
+            {
+              // growing the window if it can not hold the time interval
+              i = 2 * sf->size;
+              if (i < SERIES_FILE_WINDOW)
+                i = SERIES_FILE_WINDOW;
+              *x = (JBDOUBLE *) jb_try_realloc (*x, i * sizeof (JBDOUBLE));
+              *p1 = (JBFLOAT *) jb_try_realloc (*p1, i * sizeof (JBFLOAT));
+              if (sf->np > 1)
+                *p2 = (JBFLOAT *) jb_try_realloc (*p2, i * sizeof (JBFLOAT));
+              if (!*x || !*p1 || (sf->np > 1 && !*p2))
+                goto exit1;
+              sf->size = i;
+            }
+          ++*n;
+        }
+      (*x)[*n] = tr;
+      (*p1)[*n] = p[0];
+      if (sf->np > 1)
+        (*p2)[*n] = p[1];
+    }
+  if (*n < 0)
+    goto exit1;
+  for (i = 0; i < nc; ++i)
+    series_cursor_reset (c + i);
+
+exit0:
+#if DEBUG_SERIES_FILE_WINDOW
+  fprintf (stderr, "SFW n=%d eof=%d\n", *n, sf->eof);
+  fprintf (stderr, "series_file_window: end\n");
+#endif
+  return 1;
+
+exit1:
+#if DEBUG_SERIES_FILE_WINDOW
+  fprintf (stderr, "series_file_window: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SERIES_FILE_WINDOW
+#define series_file_window _series_file_window
+#else
+int series_file_window (SeriesFile *, JBDOUBLE, JBDOUBLE, JBDOUBLE **,
+                        JBFLOAT **, JBFLOAT **, int *, SeriesCursor *, int);
+#endif
+
+/**
+ * \struct SeriesGrid
+ * \brief Structure to define a time series resampled on a uniform time grid.
+ */
+typedef struct
+{
+/**
+ * \var x
+ * \brief array of times, NULL if not resampled.
+ * \var p1
+ * \brief array of first parameters.
+ * \var p2
+ * \brief array of second parameters, NULL if not used.
+ * \var n
+ * \brief last index of the arrays.
+ */
+  JBDOUBLE *x;
+  JBFLOAT *p1, *p2;
+  int n;
+} SeriesGrid;
+
+static inline void
+_series_grid_init_empty (SeriesGrid * g)
+{
+#if DEBUG_SERIES_GRID_INIT_EMPTY
+  fprintf (stderr, "series_grid_init_empty: start\n");
+#endif
+  g->x = NULL;
+  g->p1 = g->p2 = NULL;
+  g->n = -1;
+#if DEBUG_SERIES_GRID_INIT_EMPTY
+  fprintf (stderr, "series_grid_init_empty: end\n");
+#endif
+}
+
+#if INLINE_SERIES_GRID_INIT_EMPTY
+#define series_grid_init_empty _series_grid_init_empty
+#else
+void series_grid_init_empty (SeriesGrid *);
+#endif
+
+static inline void
+_series_grid_delete (SeriesGrid * g)
+{
+#if DEBUG_SERIES_GRID_DELETE
+  fprintf (stderr, "series_grid_delete: start\n");
+#endif
+  jb_free_null ((void **) &g->x);
+  jb_free_null ((void **) &g->p1);
+  jb_free_null ((void **) &g->p2);
+  g->n = -1;
+#if DEBUG_SERIES_GRID_DELETE
+  fprintf (stderr, "series_grid_delete: end\n");
+#endif
+}
+
+#if INLINE_SERIES_GRID_DELETE
+#define series_grid_delete _series_grid_delete
+#else
+void series_grid_delete (SeriesGrid *);
+#endif
+
+static inline int _series_grid_open
+  (SeriesGrid * g, JBDOUBLE h, JBDOUBLE * x, JBFLOAT * p1, JBFLOAT * p2,
+   int n, JBDOUBLE * e)
+{
+  int i, j;
+  JBDOUBLE k, tr;
+#if DEBUG_SERIES_GRID_OPEN
+  fprintf (stderr, "series_grid_open: start\n");
+  fprintf (stderr, "SGO h=" FWL " n=%d\n", h, n);
+#endif
+  series_grid_delete (g);
+  *e = 0.;
+  k = ceil ((x[n] - x[0]) / h);
+  if (!(k > 0.) || k >= SERIES_GRID_MAX)
+    goto exit1;
+  g->n = (int) k;
+  i = (g->n + 1) * sizeof (JBFLOAT);
+  g->x = (JBDOUBLE *) g_try_malloc ((g->n + 1) * sizeof (JBDOUBLE));
+  g->p1 = (JBFLOAT *) g_try_malloc (i);
+  if (p2)
+    g->p2 = (JBFLOAT *) g_try_malloc (i);
+  if (!g->x || !g->p1 || (p2 && !g->p2))
+    goto exit1;
+
+  // linear interpolation of the time series on the grid times
+  for (i = j = 0; i <= g->n; ++i)
+    {
+      g->x[i] = tr = x[0] + i * h;
+      while (j < n && tr >= x[j + 1])
+        ++j;
+      if (j >= n)
+        {
+          g->p1[i] = p1[n];
+          if (p2)
+            g->p2[i] = p2[n];
+        }
+      else
+        {
+          k = (tr - x[j]) / (x[j + 1] - x[j]);
+          g->p1[i] = p1[j] + k * (p1[j + 1] - p1[j]);
+          if (p2)
+            g->p2[i] = p2[j] + k * (p2[j + 1] - p2[j]);
+        }
+    }
+
+  // the maximum interpolation error is at the time series points
+  for (j = 0; j <= n; ++j)
+    {
+      i = (int) ((x[j] - x[0]) / h);
+      if (i >= g->n)
+        i = g->n - 1;
+      k = (x[j] - g->x[i]) / h;
+      *e = fmax (*e, fabs (g->p1[i] + k * (g->p1[i + 1] - g->p1[i]) - p1[j]));
+      if (p2)
+        *e = fmax (*e, fabs (g->p2[i] + k * (g->p2[i + 1] - g->p2[i])
+                             - p2[j]));
+    }
+
+#if DEBUG_SERIES_GRID_OPEN
+  fprintf (stderr, "SGO n=%d e=" FWL "\n", g->n, *e);
+  fprintf (stderr, "series_grid_open: end\n");
+#endif
+  return 1;
+
+exit1:
+  series_grid_delete (g);
+#if DEBUG_SERIES_GRID_OPEN
+  fprintf (stderr, "series_grid_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SERIES_GRID_OPEN
+#define series_grid_open _series_grid_open
+#else
+int series_grid_open (SeriesGrid *, JBDOUBLE, JBDOUBLE *, JBFLOAT *,
+                      JBFLOAT *, int, JBDOUBLE *);
+#endif
+
+#endif
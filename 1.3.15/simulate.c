@@ -184,12 +184,14 @@ dialog_simulate_steady_new (DialogSimulateSteady * dlg)
 #endif
 
 /**
- * \fn void simulate_steady()
+ * \fn int simulate_steady()
  * \brief Function to calculate steady initial conditions.
+ * \return 1 on success, 0 on error.
  */
-void
+int
 simulate_steady ()
 {
+  int k;
   time_t t1, t2;
   JBDOUBLE e1, e2, tsteady;
 #if JBW == JBW_GTK
@@ -239,7 +241,12 @@ simulate_steady ()
         fprintf (stderr, "SS system_parameters2\n");
 #endif
       e2 = flow_steady_error (p, n);
-      system_parameters2 ();
+      k = system_parameters2 ();
+      if (!k)
+        {
+          steading = 0;
+          break;
+        }
 #if MODEL_PRESSURE == MODEL_PRESSURE_HIGH_ORDER
       dt2v = dt2;
 #endif
@@ -290,6 +297,7 @@ simulate_steady ()
 #if DEBUG_SIMULATE_STEADY
   fprintf (stderr, "Simulate steady: end\n");
 #endif
+  return k;
 }
 
 /**
@@ -302,6 +310,7 @@ int
 simulate_start ()
 {
   int i, j;
+  FILE *file;
   Channel *channel;
 #if DEBUG_SIMULATE_START
   fprintf (stderr, "simulate_start: start\n");
@@ -337,6 +346,8 @@ simulate_start ()
 #endif
   if (!mesh_open (sys, &p, &tp, v, &junction, &m, &n, &njunctions, &vsize))
     goto exit;
+  if (sys->resample_interval > 0. && !system_resample (sys->resample_interval))
+    goto exit;
 
 #if JBW == JBW_GTK
 #if DEBUG_SIMULATE_START
@@ -352,6 +363,8 @@ simulate_start ()
   fprintf (stderr, "SS system_parameters\n");
 #endif
   system_parameters ();
+  if (!event_queue_open (event_queue, sys))
+    goto exit;
 
   channel_overflow = 0;
   tf = sys->final_time;
@@ -375,21 +388,38 @@ simulate_start ()
 #if DEBUG_SIMULATE_START
   fprintf (stderr, "SS system parameters2\n");
 #endif
-  system_parameters2 ();
+  if (!system_parameters2 ())
+    goto exit;
 
 #if DEBUG_SIMULATE_START
   fprintf (stderr, "SS t=" FWL " tf=" FWL " dtmax=" FWL "\n", t, tf, dtmax);
 #endif
 
-  if (sys->channel->ifc->type == INITIAL_FLOW_TYPE_STEADY)
+  resuming = 0;
+  if (restarting && sys->checkpoint_path)
+    {
+      file = g_fopen (sys->checkpoint_path, "rb");
+      if (file)
+        {
+          fclose (file);
+          resuming = 1;
+        }
+    }
+#if DEBUG_SIMULATE_START
+  fprintf (stderr, "SS resuming=%d\n", resuming);
+#endif
+
+  if (!resuming && sys->channel->ifc->type == INITIAL_FLOW_TYPE_STEADY)
     {
-      simulate_steady ();
+      if (!simulate_steady ())
+        goto exit;
       for (j = sys->n, channel = sys->channel; j >= 0; --j, ++channel)
         for (i = 0; i <= channel->nt; ++i)
           if (channel->ct[i].it->type != INITIAL_TRANSPORT_TYPE_STEADY)
             transport_variables_open
               (p, tp + i * (n + 1), n, channel->ct[i].it);
-      system_parameters2 ();
+      if (!system_parameters2 ())
+        goto exit;
     }
 #if DEBUG_SIMULATE_START
   fprintf (stderr, "SS tf=" FWL "\n", tf);
@@ -426,13 +456,21 @@ exit:
 void
 simulate ()
 {
-  int i, j;
+  int i, j, k;
   char *overflow_path;
 #if GUAD2D
   int iRec, iEnv;
 #endif
-  JBDOUBLE at;
-  FILE *file2, *file3, *file4;
+  gint64 ptime;
+  JBDOUBLE at, st, ct, tlimit;
+  FILE *file2;
+  Stream plumes[1], contributions[1];
+  Sampler sampler[1];
+  Checkpoint checkpoint[1];
+  Status status[1];
+  Memory memory[1];
+  EventQueue outputs[1];
+  Calibration calibration[1];
 #if JBW == JBW_GTK
   GtkMessageDialog *dlg;
 #endif
@@ -442,6 +480,8 @@ simulate ()
   fprintf (stderr, "S tf=" FWL "\n", tf);
 #endif
 
+  event_queue_init_empty (outputs);
+  calibration_init_empty (calibration);
   if (!started && !simulate_start ())
     {
       nstep = 0;
@@ -475,53 +515,141 @@ simulate ()
 #if JBW == JBW_GTK
   dialog_simulator_actualize_menu (dialog_simulator, 0);
 #endif
-  sys->solution_file = g_fopen (sys->solution_path, "wb");
-  write_data (sys->solution_file, v, p, tp, n, vsize, sys->channel->nt);
-  if (sys->plumes_path)
+  profile_open (profile, nth);
+  if (sys->counters)
+    profile_counters_open (profile);
+  if (sys->limiter_path)
+    limiter_open (limiter, sys, n);
+  memory_open (memory);
+  memory_account (memory, sys, p, n, junction, njunctions, vsize, limiter);
+  sampler->v0 = NULL;
+  sampler->mode = OUTPUT_MODE_CLIP;
+  plumes->file = contributions->file = NULL;
+  plumes->record = contributions->record = NULL;
+  if (sys->checkpoint_path)
+    mesh_cache_key (checkpoint->key, sys, p, n);
+  if (resuming)
     {
-      file3 = g_fopen (sys->plumes_path, "w");
-      write_plumes (file3, p, tp, t, sys);
+      if (sys->save_solution)
+        sampler_open (sampler, sys->output_mode, v, n, sys->channel->nt, t);
+      if (!checkpoint_load (checkpoint, sampler, plumes, contributions, sys,
+                            sys->checkpoint_name, sys->checkpoint_path))
+        {
+          sampler_close (sampler);
+          nstep = 0;
+          goto exit2;
+        }
+      if (!event_queue_open (event_queue, sys))
+        {
+          sampler_close (sampler);
+          nstep = 0;
+          goto exit2;
+        }
+      k = checkpoint->k;
+      at = checkpoint->at;
+      st = checkpoint->st;
+      ct = checkpoint->ct;
+#if DEBUG_SIMULATE
+      fprintf (stderr, "S resuming t=" FWL " at=" FWL "\n", t, at);
+#endif
     }
-  if (sys->contributions_path)
+  else
     {
-      file4 = g_fopen (sys->contributions_path, "w");
-      write_contributions (file4, t, sys);
-    }
+      if (sys->save_solution)
+        {
+          sys->solution_file = g_fopen (sys->solution_path, "wb");
+          write_data (sys->solution_file, v, p, tp, n, vsize,
+                      sys->channel->nt);
+          sampler_open (sampler, sys->output_mode, v, n, sys->channel->nt, t);
+        }
+      for (i = 0; i <= sys->nout; ++i)
+        if (write_output_open (sys->output + i, sys, t, 0))
+          write_output (sys->output + i, p, tp, t, n);
+      if (sys->plumes_path
+          && stream_open (plumes, sys->plumes_path, STREAM_TYPE_PLUMES, sys,
+                          0))
+        stream_write (plumes, p, tp, t, sys);
+      if (sys->contributions_path
+          && stream_open (contributions, sys->contributions_path,
+                          STREAM_TYPE_CONTRIBUTIONS, sys, 0))
+        stream_write (contributions, p, tp, t, sys);
+      k = 0;
+      st = t + sys->streams_interval;
+      at = t;
+      ct = t + sys->checkpoint_interval;
 #if DEBUG_SIMULATE
-  fprintf (stderr, "S t=" FWL " tf=" FWL " ti=" FWL " dtmax=" FWL "\n",
-           t, tf, ti, dtmax);
+      fprintf (stderr, "S t=" FWL " tf=" FWL " ti=" FWL " dtmax=" FWL "\n",
+               t, tf, ti, dtmax);
 #endif
 
-  mass_start (m);
-  m[0].m0 = flow_mass (p, n);
+      mass_start (m);
+      m[0].m0 = flow_mass (p, n);
 #if DEBUG_SIMULATE
-  fprintf (stderr, "S mass m0=" FWL "\n", m[0].m0);
+      fprintf (stderr, "S mass m0=" FWL "\n", m[0].m0);
 #endif
-  for (i = j = 0; i <= sys->nt; ++i, j += n + 1)
-    {
-      mass_start (m + i + 1);
-      m[i + 1].m0 = transport_mass (tp + j, n);
+      for (i = j = 0; i <= sys->nt; ++i, j += n + 1)
+        {
+          mass_start (m + i + 1);
+          m[i + 1].m0 = transport_mass (tp + j, n);
 #if DEBUG_SIMULATE
-      fprintf (stderr, "S solute=%d m0=" FWL "\n", i, m[i + 1].m0);
+          fprintf (stderr, "S solute=%d m0=" FWL "\n", i, m[i + 1].m0);
 #endif
+        }
     }
 
+  if (sys->status_path)
+    {
+      status_open (status, sys);
+      status_write (status, sys, 0);
+    }
+  if (!event_queue_open_outputs (outputs, sys)
+      || (sys->calibration_path && !calibration_open (calibration, sys)))
+    {
+      sampler_close (sampler);
+      nstep = 0;
+      goto exit2;
+    }
 #if GUAD2D
 // abrir interfaces
 #endif
   while (t < tf)
     {
-      at = fmin (tf, t + ti);
+      at = fmin (tf, at + ti);
 #if DEBUG_SIMULATE
       if (t >= DEBUG_TIME)
         fprintf (stderr, "S at=" FWL "\n", at);
 #endif
+      if (calibrating)
+        {
+          calibration->checkpoint->k = k;
+          calibration->checkpoint->at = at;
+          calibration->checkpoint->st = st;
+          calibration->checkpoint->ct = ct;
+          if (!calibration_start
+              (calibration, sampler, plumes, contributions, sys))
+            goto exit;
+        }
+trial:
       for (; t < at;)
         {
           if (!simulating)
             goto exit;
-          tmax = fmin (tmax, at);
+          if (sampler->mode == OUTPUT_MODE_CLIP)
+            {
+              tlimit = tmax;
+              tmax = fmin (tmax, at);
+              limiter_update
+                (limiter, tlimit, tmax, LIMITER_TYPE_OBSERVATION, -1, -1);
+            }
+          else
+            {
+              tmax = fmin (tmax, tf);
+              if (sampler->mode == OUTPUT_MODE_AVERAGE || tmax >= at)
+                sampler_advance (sampler, v, t);
+            }
+          event_queue_tmax (outputs);
           dt = tmax - t;
+          limiter_step (limiter, p, n);
 #if DEBUG_SIMULATE
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S t=" FWL " dt=" FWL "\n", t, dt);
@@ -538,29 +666,38 @@ simulate ()
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S system_decomposition\n");
 #endif
+          profile_start (profile, &ptime);
           system_decomposition ();
+          profile_lap (profile, PROFILE_PHASE_DECOMPOSITION, &ptime);
 #if DEBUG_SIMULATE
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S system_simulate_step\n");
 #endif
           system_simulate_step ();
+          profile_lap (profile, PROFILE_PHASE_SIMULATE_STEP, &ptime);
 #if DEBUG_SIMULATE
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S system_simulate_step2\n");
 #endif
           system_simulate_step2 ();
+          profile_lap (profile, PROFILE_PHASE_SIMULATE_STEP2, &ptime);
 #if DEBUG_SIMULATE
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S system_transport_step\n");
 #endif
           if (sys->nt >= 0)
-            system_transport_step ();
+            {
+              system_transport_step ();
+              profile_lap (profile, PROFILE_PHASE_TRANSPORT_STEP, &ptime);
+            }
 #if DEBUG_SIMULATE
           if (t >= DEBUG_TIME)
             fprintf (stderr, "S system_parameters2\n");
 #endif
           t = tmax;
-          system_parameters2 ();
+          if (!system_parameters2 ())
+            goto exit;
+          profile_lap (profile, PROFILE_PHASE_PARAMETERS2, &ptime);
 #if MODEL_PRESSURE == MODEL_PRESSURE_HIGH_ORDER
           dt2v = dt2;
 #endif
@@ -578,10 +715,41 @@ simulate ()
 #endif
           if (type_animation == 2)
             draw ();
-          if (sys->plumes_path)
-            write_plumes (file3, p, tp, t, sys);
-          if (sys->contributions_path)
-            write_contributions (file4, t, sys);
+          profile_start (profile, &ptime);
+          while (outputs->n && t >= outputs->event->t)
+            {
+              i = outputs->event->index;
+              event_queue_pop (outputs);
+              write_output (sys->output + i, p, tp, t, n);
+              if (sys->output[i].t > t)
+                event_queue_push (outputs, sys->output[i].t,
+                                  LIMITER_TYPE_OUTPUT, -1, i, sys->output + i);
+            }
+          ++k;
+          if ((k >= sys->streams_step && t >= st) || t >= tf)
+            {
+              k = 0;
+              st = t + sys->streams_interval;
+              stream_write (plumes, p, tp, t, sys);
+              stream_write (contributions, p, tp, t, sys);
+            }
+          profile_lap (profile, PROFILE_PHASE_WRITE, &ptime);
+          if (sys->status_path)
+            status_step (status, sys);
+        }
+      if (calibrating && calibration_step (calibration, sys))
+        {
+#if DEBUG_SIMULATE
+          fprintf (stderr, "S calibration_rollback\n");
+#endif
+          if (!calibration_rollback
+              (calibration, sampler, plumes, contributions, sys)
+              || !event_queue_open_outputs (outputs, sys))
+            goto exit;
+          k = calibration->checkpoint->k;
+          st = calibration->checkpoint->st;
+          ct = calibration->checkpoint->ct;
+          goto trial;
         }
 #if DEBUG_SIMULATE
       if (t >= DEBUG_TIME)
@@ -593,7 +761,27 @@ simulate ()
       if (t >= DEBUG_TIME)
         fprintf (stderr, "S write_data\n");
 #endif
-      write_data (sys->solution_file, v, p, tp, n, vsize, sys->channel->nt);
+      profile_start (profile, &ptime);
+      if (sampler->mode != OUTPUT_MODE_CLIP)
+        sampler_write (sampler, v, t, at, sys->solution_file);
+      else if (sys->save_solution)
+        write_data (sys->solution_file, v, p, tp, n, vsize,
+                    sys->channel->nt);
+      if (sys->checkpoint_path && t >= ct && t < tf)
+        {
+#if DEBUG_SIMULATE
+          fprintf (stderr, "S checkpoint_save\n");
+#endif
+          ct = t + sys->checkpoint_interval;
+          checkpoint->k = k;
+          checkpoint->at = at;
+          checkpoint->st = st;
+          checkpoint->ct = ct;
+          checkpoint_save (checkpoint, sampler, plumes, contributions, sys,
+                           sys->checkpoint_path);
+        }
+      memory_account (memory, sys, p, n, junction, njunctions, vsize, limiter);
+      profile_lap (profile, PROFILE_PHASE_WRITE, &ptime);
     }
 exit:
 #if GUAD2D
@@ -603,18 +791,47 @@ exit:
   fprintf (stderr, "S drawing\n");
 #endif
   draw ();
-  fclose (sys->solution_file);
+  if (sys->save_solution && sys->solution_file)
+    fclose (sys->solution_file);
+  sampler_close (sampler);
+  for (i = 0; i <= sys->nout; ++i)
+    write_output_close (sys->output + i);
   if (sys->advances_path)
     {
       file2 = g_fopen (sys->advances_path, "w");
       write_advances (file2, p, n);
       fclose (file2);
     }
-  if (sys->plumes_path)
-    fclose (file3);
-  if (sys->contributions_path)
-    fclose (file4);
+  stream_close (plumes);
+  stream_close (contributions);
   printf ("channel_overflow=%d\n", channel_overflow);
+  if (calibrating)
+    printf ("Calibration periods=%d trials=%d\n", calibration->periods,
+            calibration->trials);
+  profile->end = g_get_monotonic_time ();
+  if (sys->status_path)
+    status_write (status, sys, 1);
+  // the GTK interface prints the profile only when it is saved
+#if JBW == JBW_GTK
+  if (sys->profile_path)
+    profile_print (profile, stdout);
+#else
+  profile_print (profile, stdout);
+#endif
+  if (sys->profile_path)
+    profile_save (profile, sys->profile_path);
+  if (limiter->cell)
+    {
+      limiter_print (limiter, stdout, LIMITER_PRINT_LINES);
+      limiter_save (limiter, sys->limiter_path);
+    }
+  memory_rss (memory);
+#if JBW == JBW_GTK
+  if (sys->profile_path)
+    memory_print (memory, stdout);
+#else
+  memory_print (memory, stdout);
+#endif
   overflow_path = g_strconcat (sys->directory, "/overflow", NULL);
   file2 = fopen (overflow_path, "w");
   g_free (overflow_path);
@@ -624,7 +841,12 @@ exit:
   fclose (file2);
   simulated = 1;
 exit2:
-  simulating = started = 0;
+  profile_close (profile);
+  limiter_close (limiter);
+  event_queue_delete (outputs);
+  event_queue_delete (event_queue);
+  calibration_delete (calibration);
+  simulating = started = resuming = 0;
 #if JBW == JBW_GTK
   istep = nstep - 1;
   dialog_simulator_actualize_menu (dialog_simulator, 1);
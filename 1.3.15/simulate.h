@@ -41,9 +41,11 @@ Copyright 2005-2015 Javier Burguete Tolosa. All rights reserved
 
 #include "flow_scheme.h"
 #include "transport_simulate.h"
-#include "write.h"
+#include "calibration.h"
+#include "memory.h"
 
 extern int n, type_animation, started, simulated, istep, steading, file_advance;
+extern int restarting, resuming;
 extern JBFLOAT flow_steady_error_max;
 
 extern void
@@ -148,7 +150,7 @@ _scheme_open ()
 void scheme_open ();
 #endif
 
-void simulate_steady ();
+int simulate_steady ();
 int simulate_start ();
 void simulate ();
 
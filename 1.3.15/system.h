@@ -37,6 +37,41 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SYSTEM__H 1
 
 #include "channel.h"
+#include "output.h"
+
+/**
+ * \enum StreamsFormat
+ * \brief Enumeration to define the format of the plumes and contributions
+ *   files.
+ * \var STREAMS_FORMAT_TEXT
+ * \brief ASCII file with a line per saved time step.
+ * \var STREAMS_FORMAT_BINARY
+ * \brief binary file with a header and fixed width records.
+ */
+enum StreamsFormat
+{
+  STREAMS_FORMAT_TEXT = 0,
+  STREAMS_FORMAT_BINARY = 1
+};
+
+/**
+ * \enum OutputMode
+ * \brief Enumeration to define how the solution is saved at the measured
+ *   times.
+ * \var OUTPUT_MODE_CLIP
+ * \brief the time step is shortened to reach exactly every measured time.
+ * \var OUTPUT_MODE_INTERPOLATE
+ * \brief the solution is linearly interpolated in time between the states
+ *   bracketing every measured time.
+ * \var OUTPUT_MODE_AVERAGE
+ * \brief the solution is averaged in time over every measured interval.
+ */
+enum OutputMode
+{
+  OUTPUT_MODE_CLIP = 0,
+  OUTPUT_MODE_INTERPOLATE = 1,
+  OUTPUT_MODE_AVERAGE = 2
+};
 
 /**
  * \struct System
@@ -49,6 +84,8 @@ typedef struct
  * \brief number of channels.
  * \var nt
  * \brief number of transported solutes.
+ * \var nout
+ * \brief number of selective outputs.
  * \var initial_time
  * \brief simulation initial time.
  * \var observation_time
@@ -71,12 +108,37 @@ typedef struct
  * \brief minimum flow depth allowing the water movement.
  * \var granulometric_coefficient
  * \brief aerodynamical friction coefficient of granulometric roughness.
+ * \var streams_interval
+ * \brief minimum time interval to save the plumes and contributions.
+ * \var checkpoint_interval
+ * \brief simulated time interval to save the checkpoints.
+ * \var status_interval
+ * \brief wall time interval in seconds to rewrite the status file.
+ * \var resample_interval
+ * \brief time interval to resample the boundary time series, 0 to not
+ *   resample.
+ * \var streams_step
+ * \brief number of time steps to save the plumes and contributions.
+ * \var streams_format
+ * \brief format of the plumes and contributions files.
+ * \var save_solution
+ * \brief 1 to save the full solution file, 0 otherwise.
+ * \var output_mode
+ * \brief mode to save the solution at the measured times. Only the full
+ *   solution file is sampled, so it needs save_solution.
+ * \var counters
+ * \brief 1 to read the hardware performance counters, 0 otherwise.
+ * \var calibration_iterations
+ * \brief maximum number of trials to calibrate the controlled cross sections
+ *   in every measured interval.
  * \var solution_file
  * \brief solution file.
  * \var transport
  * \brief array of transported solutes.
  * \var channel
  * \brief array of channels.
+ * \var output
+ * \brief array of selective outputs.
  * \var *name
  * \brief name.
  * \var *directory
@@ -97,17 +159,48 @@ typedef struct
  * \brief plumes solution file path.
  * \var *contributions_path
  * \brief contributions solution file path.
+ * \var *mesh_cache_name
+ * \brief binary mesh cache file name.
+ * \var *mesh_cache_path
+ * \brief binary mesh cache file path.
+ * \var *checkpoint_name
+ * \brief checkpoint file name.
+ * \var *checkpoint_path
+ * \brief checkpoint file path.
+ * \var *calibration_name
+ * \brief calibration checkpoint file name.
+ * \var *calibration_path
+ * \brief calibration checkpoint file path.
+ * \var *profile_name
+ * \brief profiling JSON file name.
+ * \var *profile_path
+ * \brief profiling JSON file path.
+ * \var *limiter_name
+ * \brief time step size limits report file name.
+ * \var *limiter_path
+ * \brief time step size limits report file path.
+ * \var *status_name
+ * \brief live status file name.
+ * \var *status_path
+ * \brief live status file path.
  */
-  int n, nt;
+  int n, nt, nout;
   JBDOUBLE initial_time, observation_time, final_time, measured_interval;
   JBFLOAT cfl, implicit, steady_error, max_steady_time, section_width_min,
     depth_min, granulometric_coefficient;
+  JBDOUBLE streams_interval, checkpoint_interval, status_interval,
+    resample_interval;
+  int streams_step, streams_format, save_solution, output_mode, counters,
+    calibration_iterations;
   FILE *solution_file;
   Transport *transport;
   Channel *channel;
+  Output *output;
   char *name, *directory, *solution_name, *advances_name, *plumes_name,
     *contributions_name, *solution_path, *advances_path, *plumes_path,
-    *contributions_path;
+    *contributions_path, *mesh_cache_name, *mesh_cache_path, *checkpoint_name,
+    *checkpoint_path, *calibration_name, *calibration_path, *profile_name,
+    *profile_path, *limiter_name, *limiter_path, *status_name, *status_path;
 } System;
 
 extern System sys[1], sysnew[1];
@@ -124,6 +217,16 @@ _system_print (System * s, FILE * file)
   fprintf (file, "SP advances_name=%s\n", s->advances_name);
   fprintf (file, "SP plumes_name=%s\n", s->plumes_name);
   fprintf (file, "SP contributions_name=%s\n", s->contributions_name);
+  fprintf (file, "SP mesh_cache_name=%s\n", s->mesh_cache_name);
+  fprintf (file, "SP checkpoint_name=%s checkpoint_interval=" FWL "\n",
+           s->checkpoint_name, s->checkpoint_interval);
+  fprintf (file, "SP calibration_name=%s calibration_iterations=%d\n",
+           s->calibration_name, s->calibration_iterations);
+  fprintf (file, "SP profile_name=%s\n", s->profile_name);
+  fprintf (file, "SP limiter_name=%s\n", s->limiter_name);
+  fprintf (file, "SP status_name=%s status_interval=" FWL "\n",
+           s->status_name, s->status_interval);
+  fprintf (file, "SP resample_interval=" FWL "\n", s->resample_interval);
   fprintf (file,
            "SP initial_time=" FWL " observation_time=" FWL " final_time=" FWL
            "\n" "SP measured_interval=" FWL "\n", s->initial_time,
@@ -134,10 +237,17 @@ _system_print (System * s, FILE * file)
            s->max_steady_time, s->section_width_min);
   fprintf (file, "SP depth_min=" FWF " granulometric_coefficient=" FWF "\n",
            s->depth_min, s->granulometric_coefficient);
+  fprintf (file, "SP streams_interval=" FWL " streams_step=%d"
+           " streams_format=%d\n",
+           s->streams_interval, s->streams_step, s->streams_format);
+  fprintf (file, "SP save_solution=%d output_mode=%d nout=%d counters=%d\n",
+           s->save_solution, s->output_mode, s->nout, s->counters);
   for (i = 0; i <= s->nt; ++i)
     transport_print (s->transport + i, file);
   for (i = 0; i <= s->n; ++i)
     channel_print (s->channel + i, file);
+  for (i = 0; i <= s->nout; ++i)
+    output_print (s->output + i, file);
   fprintf (file, "system_print: end\n");
 }
 
@@ -177,8 +287,11 @@ _system_delete (System * s)
     transport_delete (s->transport + i);
   for (i = 0; i <= s->n; ++i)
     channel_delete (s->channel + i);
+  for (i = 0; i <= s->nout; ++i)
+    output_delete (s->output + i);
   jb_free_null ((void **) &s->transport);
   jb_free_null ((void **) &s->channel);
+  jb_free_null ((void **) &s->output);
   jb_free_null ((void **) &s->name);
   jb_free_null ((void **) &s->directory);
   jb_free_null ((void **) &s->solution_name);
@@ -189,7 +302,19 @@ _system_delete (System * s)
   jb_free_null ((void **) &s->plumes_path);
   jb_free_null ((void **) &s->contributions_name);
   jb_free_null ((void **) &s->contributions_path);
-  s->n = s->nt = -1;
+  jb_free_null ((void **) &s->mesh_cache_name);
+  jb_free_null ((void **) &s->mesh_cache_path);
+  jb_free_null ((void **) &s->checkpoint_name);
+  jb_free_null ((void **) &s->checkpoint_path);
+  jb_free_null ((void **) &s->calibration_name);
+  jb_free_null ((void **) &s->calibration_path);
+  jb_free_null ((void **) &s->profile_name);
+  jb_free_null ((void **) &s->profile_path);
+  jb_free_null ((void **) &s->limiter_name);
+  jb_free_null ((void **) &s->limiter_path);
+  jb_free_null ((void **) &s->status_name);
+  jb_free_null ((void **) &s->status_path);
+  s->n = s->nt = s->nout = -1;
 #if DEBUG_SYSTEM_DELETE
   fprintf (stderr, "system_delete: end\n");
 #endif
@@ -209,10 +334,15 @@ _system_init_empty (System * s)
 #endif
   s->transport = NULL;
   s->channel = NULL;
+  s->output = NULL;
   s->name = s->directory = s->solution_name = s->solution_path
     = s->advances_name = s->plumes_name = s->contributions_name
-    = s->advances_path = s->plumes_path = s->contributions_path = NULL;
-  s->n = s->nt = -1;
+    = s->advances_path = s->plumes_path = s->contributions_path
+    = s->mesh_cache_name = s->mesh_cache_path = s->checkpoint_name
+    = s->checkpoint_path = s->calibration_name = s->calibration_path
+    = s->profile_name = s->profile_path = s->limiter_name = s->limiter_path
+    = s->status_name = s->status_path = NULL;
+  s->n = s->nt = s->nout = -1;
 #if DEBUG_SYSTEM_INIT_EMPTY
   fprintf (stderr, "system_init_empty: end\n");
 #endif
@@ -449,6 +579,60 @@ _system_copy (System * s, System * s_copy)
     }
   else
     s->contributions_name = s->contributions_path = NULL;
+  if (s_copy->mesh_cache_name)
+    {
+      s->mesh_cache_name = jb_strdup (s_copy->mesh_cache_name);
+      s->mesh_cache_path = jb_strdup (s_copy->mesh_cache_path);
+      if (!s->mesh_cache_name || !s->mesh_cache_path)
+        goto exit1;
+    }
+  else
+    s->mesh_cache_name = s->mesh_cache_path = NULL;
+  if (s_copy->checkpoint_name)
+    {
+      s->checkpoint_name = jb_strdup (s_copy->checkpoint_name);
+      s->checkpoint_path = jb_strdup (s_copy->checkpoint_path);
+      if (!s->checkpoint_name || !s->checkpoint_path)
+        goto exit1;
+    }
+  else
+    s->checkpoint_name = s->checkpoint_path = NULL;
+  if (s_copy->calibration_name)
+    {
+      s->calibration_name = jb_strdup (s_copy->calibration_name);
+      s->calibration_path = jb_strdup (s_copy->calibration_path);
+      if (!s->calibration_name || !s->calibration_path)
+        goto exit1;
+    }
+  else
+    s->calibration_name = s->calibration_path = NULL;
+  if (s_copy->profile_name)
+    {
+      s->profile_name = jb_strdup (s_copy->profile_name);
+      s->profile_path = jb_strdup (s_copy->profile_path);
+      if (!s->profile_name || !s->profile_path)
+        goto exit1;
+    }
+  else
+    s->profile_name = s->profile_path = NULL;
+  if (s_copy->limiter_name)
+    {
+      s->limiter_name = jb_strdup (s_copy->limiter_name);
+      s->limiter_path = jb_strdup (s_copy->limiter_path);
+      if (!s->limiter_name || !s->limiter_path)
+        goto exit1;
+    }
+  else
+    s->limiter_name = s->limiter_path = NULL;
+  if (s_copy->status_name)
+    {
+      s->status_name = jb_strdup (s_copy->status_name);
+      s->status_path = jb_strdup (s_copy->status_path);
+      if (!s->status_name || !s->status_path)
+        goto exit1;
+    }
+  else
+    s->status_name = s->status_path = NULL;
 #if DEBUG_SYSTEM_COPY
   fprintf (stderr, "SC dir=%s name=%s solution=%s\n",
            s->directory, s->name, s->solution_name);
@@ -493,6 +677,22 @@ _system_copy (System * s, System * s_copy)
         }
       ++s->n;
     }
+  if (s_copy->nout >= 0)
+    {
+      s->output =
+        (Output *) g_try_malloc ((s_copy->nout + 1) * sizeof (Output));
+      if (!s->output)
+        goto exit1;
+      for (i = 0; i <= s_copy->nout; ++i)
+        {
+          if (!output_copy (s->output + i, s_copy->output + i))
+            {
+              system_error (s, message);
+              goto exit2;
+            }
+          ++s->nout;
+        }
+    }
 
 exit0:
 #if DEBUG_SYSTEM_COPY
@@ -547,10 +747,10 @@ _system_junctions_set_up (System * s)
                     }
                   jd->channel = l;
                   c = s->channel + l;
-                  for (l = 0; l <= s->n; ++l)
-                    if (!strcmp (jd->section, c->bf[l].name))
+                  for (l = 0; l <= c->cg->n; ++l)
+                    if (!strcmp (jd->section, c->cg->cs[l].name))
                       break;
-                  if (l > c->n)
+                  if (l > c->cg->n)
                     {
                       junction_data_error (gettext ("Bad cross section"));
                       goto error1;
@@ -560,14 +760,15 @@ _system_junctions_set_up (System * s)
                     jd->pos2 = l;
                   else
                     {
-                      for (l = 0; l <= s->n; ++l)
-                        if (!strcmp (jd->section2, c->bf[l].name))
+                      for (l = 0; l <= c->cg->n; ++l)
+                        if (!strcmp (jd->section2, c->cg->cs[l].name))
                           break;
-                      if (l > c->n || l < jd->pos)
+                      if (l > c->cg->n || l < jd->pos)
                         {
                           junction_data_error (gettext ("Bad cross section"));
                           goto error1;
                         }
+                      jd->pos2 = l;
                     }
                   if ((!jd->pos && !jd->pos2 &&
                        c->bf->type != BOUNDARY_FLOW_TYPE_JUNCTION) ||
@@ -692,15 +893,90 @@ set_up_error:
 int system_controls_set_up (System *);
 #endif
 
+static inline int
+_system_outputs_set_up (System * s)
+{
+  int i, j;
+  Channel *channel;
+  ChannelGeometry *cg;
+  Output *o;
+#if DEBUG_SYSTEM_OUTPUTS_SET_UP
+  fprintf (stderr, "system_outputs_set_up: start\n");
+#endif
+  for (i = 0, o = s->output; i <= s->nout; ++i, ++o)
+    {
+      for (j = 0; j <= s->n; ++j)
+        if (!strcmp (s->channel[j].name, o->channel))
+          break;
+      if (j > s->n)
+        {
+          output_error (o, gettext ("Bad channel"));
+          goto set_up_error;
+        }
+      o->ichannel = j;
+      channel = s->channel + j;
+      cg = channel->cg;
+      o->pos = 0;
+      if (o->section)
+        {
+          for (j = 0; j <= cg->n; ++j)
+            if (!strcmp (cg->cs[j].name, o->section))
+              break;
+          if (j > cg->n)
+            {
+              output_error (o, gettext ("Bad position"));
+              goto set_up_error;
+            }
+          o->pos = j;
+        }
+      o->pos2 = cg->n;
+      if (o->section2)
+        {
+          for (j = 0; j <= cg->n; ++j)
+            if (!strcmp (cg->cs[j].name, o->section2))
+              break;
+          if (j > cg->n || j < o->pos)
+            {
+              output_error (o, gettext ("Bad position"));
+              goto set_up_error;
+            }
+          o->pos2 = j;
+        }
+#if DEBUG_SYSTEM_OUTPUTS_SET_UP
+      fprintf (stderr, "SOSU output=%d channel=%d pos=%d pos2=%d\n",
+               i, o->ichannel, o->pos, o->pos2);
+#endif
+    }
+#if DEBUG_SYSTEM_OUTPUTS_SET_UP
+  fprintf (stderr, "system_outputs_set_up: end\n");
+#endif
+  return 1;
+
+set_up_error:
+  system_error (s, message);
+#if DEBUG_SYSTEM_OUTPUTS_SET_UP
+  fprintf (stderr, "system_outputs_set_up: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_SYSTEM_OUTPUTS_SET_UP
+#define system_outputs_set_up _system_outputs_set_up
+#else
+int system_outputs_set_up (System *);
+#endif
+
 static inline int
 _system_open_xml (System * s, char *name, char *directory)
 {
   int j, k;
   char buffer[JB_BUFFER_SIZE];
+  xmlChar *buffer2;
   xmlDoc *doc;
   xmlNode *node;
   Transport *transport;
   Channel *channel;
+  Output *output;
 
 #if DEBUG_SYSTEM_OPEN_XML
   fprintf (stderr, "system_open_xml: start\n");
@@ -795,6 +1071,189 @@ _system_open_xml (System * s, char *name, char *directory)
     }
   else
     s->contributions_path = NULL;
+  if (xmlHasProp (node, XML_MESH_CACHE))
+    {
+      s->mesh_cache_name = (char *) xmlGetProp (node, XML_MESH_CACHE);
+      s->mesh_cache_path =
+        (char *) g_build_filename (s->directory, s->mesh_cache_name, NULL);
+      if (!s->mesh_cache_path)
+        {
+          jbw_show_error (gettext ("Bad mesh cache file"));
+          goto exit1;
+        }
+    }
+  else
+    s->mesh_cache_path = NULL;
+  if (xmlHasProp (node, XML_CHECKPOINT))
+    {
+      s->checkpoint_name = (char *) xmlGetProp (node, XML_CHECKPOINT);
+      s->checkpoint_path =
+        (char *) g_build_filename (s->directory, s->checkpoint_name, NULL);
+      if (!s->checkpoint_path)
+        {
+          jbw_show_error (gettext ("Bad checkpoint file"));
+          goto exit1;
+        }
+    }
+  else
+    s->checkpoint_path = NULL;
+  if (xmlHasProp (node, XML_CALIBRATION))
+    {
+      s->calibration_name = (char *) xmlGetProp (node, XML_CALIBRATION);
+      s->calibration_path =
+        (char *) g_build_filename (s->directory, s->calibration_name, NULL);
+      if (!s->calibration_path)
+        {
+          jbw_show_error (gettext ("Bad calibration file"));
+          goto exit1;
+        }
+    }
+  else
+    s->calibration_path = NULL;
+  if (xmlHasProp (node, XML_PROFILING))
+    {
+      s->profile_name = (char *) xmlGetProp (node, XML_PROFILING);
+      s->profile_path =
+        (char *) g_build_filename (s->directory, s->profile_name, NULL);
+      if (!s->profile_path)
+        {
+          jbw_show_error (gettext ("Bad profiling file"));
+          goto exit1;
+        }
+    }
+  else
+    s->profile_path = NULL;
+  if (xmlHasProp (node, XML_LIMITER))
+    {
+      s->limiter_name = (char *) xmlGetProp (node, XML_LIMITER);
+      s->limiter_path =
+        (char *) g_build_filename (s->directory, s->limiter_name, NULL);
+      if (!s->limiter_path)
+        {
+          jbw_show_error (gettext ("Bad time step limits file"));
+          goto exit1;
+        }
+    }
+  else
+    s->limiter_path = NULL;
+  if (xmlHasProp (node, XML_STATUS))
+    {
+      s->status_name = (char *) xmlGetProp (node, XML_STATUS);
+      s->status_path =
+        (char *) g_build_filename (s->directory, s->status_name, NULL);
+      if (!s->status_path)
+        {
+          jbw_show_error (gettext ("Bad status file"));
+          goto exit1;
+        }
+    }
+  else
+    s->status_path = NULL;
+  s->status_interval = jb_xml_node_get_float_with_default
+    (node, XML_STATUS_INTERVAL, &j, STATUS_INTERVAL);
+  if (!j || s->status_interval <= 0.)
+    {
+      jbw_show_error (gettext ("Bad status interval"));
+      goto exit1;
+    }
+  s->checkpoint_interval = jb_xml_node_get_float_with_default
+    (node, XML_CHECKPOINT_INTERVAL, &j, 0.);
+  if (!j || s->checkpoint_interval < 0.)
+    {
+      jbw_show_error (gettext ("Bad checkpoint interval"));
+      goto exit1;
+    }
+  s->calibration_iterations = CALIBRATION_ITERATIONS;
+  if (xmlHasProp (node, XML_CALIBRATION_ITERATIONS))
+    {
+      s->calibration_iterations =
+        jb_xml_node_get_int (node, XML_CALIBRATION_ITERATIONS, &j);
+      if (!j || s->calibration_iterations < 1)
+        {
+          jbw_show_error (gettext ("Bad calibration iterations"));
+          goto exit1;
+        }
+    }
+  s->resample_interval = jb_xml_node_get_float_with_default
+    (node, XML_RESAMPLE_INTERVAL, &j, 0.);
+  if (!j || s->resample_interval < 0.)
+    {
+      jbw_show_error (gettext ("Bad resample interval"));
+      goto exit1;
+    }
+  s->streams_format = STREAMS_FORMAT_TEXT;
+  if (xmlHasProp (node, XML_STREAMS_FORMAT))
+    {
+      buffer2 = xmlGetProp (node, XML_STREAMS_FORMAT);
+      if (!xmlStrcmp (buffer2, XML_BINARY))
+        s->streams_format = STREAMS_FORMAT_BINARY;
+      else if (xmlStrcmp (buffer2, XML_TEXT))
+        {
+          xmlFree (buffer2);
+          jbw_show_error (gettext ("Bad streams format"));
+          goto exit1;
+        }
+      xmlFree (buffer2);
+    }
+  s->streams_step = 1;
+  if (xmlHasProp (node, XML_STREAMS_STEP))
+    {
+      s->streams_step = jb_xml_node_get_int (node, XML_STREAMS_STEP, &j);
+      if (!j || s->streams_step < 1)
+        {
+          jbw_show_error (gettext ("Bad streams step"));
+          goto exit1;
+        }
+    }
+  s->streams_interval =
+    jb_xml_node_get_float_with_default (node, XML_STREAMS_INTERVAL, &j, 0.);
+  if (!j || s->streams_interval < 0.)
+    {
+      jbw_show_error (gettext ("Bad streams interval"));
+      goto exit1;
+    }
+  s->save_solution = 1;
+  if (xmlHasProp (node, XML_SAVE_SOLUTION))
+    {
+      s->save_solution = jb_xml_node_get_int (node, XML_SAVE_SOLUTION, &j);
+      if (!j || s->save_solution < 0 || s->save_solution > 1)
+        {
+          jbw_show_error (gettext ("Bad save solution"));
+          goto exit1;
+        }
+    }
+  s->counters = 0;
+  if (xmlHasProp (node, XML_COUNTERS))
+    {
+      s->counters = jb_xml_node_get_int (node, XML_COUNTERS, &j);
+      if (!j || s->counters < 0 || s->counters > 1)
+        {
+          jbw_show_error (gettext ("Bad hardware performance counters"));
+          goto exit1;
+        }
+    }
+  s->output_mode = OUTPUT_MODE_CLIP;
+  if (xmlHasProp (node, XML_OUTPUT_MODE))
+    {
+      buffer2 = xmlGetProp (node, XML_OUTPUT_MODE);
+      if (!xmlStrcmp (buffer2, XML_INTERPOLATE))
+        s->output_mode = OUTPUT_MODE_INTERPOLATE;
+      else if (!xmlStrcmp (buffer2, XML_AVERAGE))
+        s->output_mode = OUTPUT_MODE_AVERAGE;
+      else if (xmlStrcmp (buffer2, XML_CLIP))
+        {
+          xmlFree (buffer2);
+          jbw_show_error (gettext ("Bad output mode"));
+          goto exit1;
+        }
+      xmlFree (buffer2);
+      if (s->output_mode != OUTPUT_MODE_CLIP && !s->save_solution)
+        {
+          jbw_show_error
+            (gettext ("The output mode needs to save the solution"));
+          goto exit1;
+        }
+    }
   s->initial_time =
     jb_xml_node_get_time_with_default (node, XML_INITIAL_TIME, &j, 0.);
   if (!j)
@@ -929,6 +1388,31 @@ _system_open_xml (System * s, char *name, char *directory)
               goto exit0;
             }
         }
+      else if (!xmlStrcmp (node->name, XML_OUTPUT))
+        {
+#if DEBUG_SYSTEM_OPEN_XML
+          fprintf (stderr, "SOXML output\n");
+#endif
+          j = s->nout + 1;
+          output =
+            (Output *) jb_try_realloc (s->output, (j + 1) * sizeof (Output));
+          if (!output)
+            {
+              message = g_strconcat (gettext ("Output"), "\n",
+                                     gettext ("Not enough memory"), NULL);
+              system_error (s, message);
+              goto exit0;
+            }
+          j = output_open_xml (output + j, node, s->transport, s->nt);
+          s->output = output;
+          if (j)
+            ++s->nout;
+          else
+            {
+              system_error (s, message);
+              goto exit0;
+            }
+        }
       else
         {
           system_error (s, gettext ("Bad defined"));
@@ -943,6 +1427,8 @@ _system_open_xml (System * s, char *name, char *directory)
     goto exit0;
   if (!system_controls_set_up (s))
     goto exit0;
+  if (!system_outputs_set_up (s))
+    goto exit0;
 
 #if DEBUG_SYSTEM_OPEN_XML
   system_print (s, stderr);
@@ -973,7 +1459,7 @@ static inline void
 _system_save_xml (System * s)
 {
   int i;
-  char *buffer;
+  char *buffer, number[32];
   xmlDoc *doc;
   xmlNode *node, *child;
 #if DEBUG_SYSTEM_SAVE_XML
@@ -992,6 +1478,37 @@ _system_save_xml (System * s)
   if (s->measured_interval > 0.)
     jb_xml_node_set_float (node, XML_MEASURED_TIME, s->measured_interval);
   xmlSetProp (node, XML_SOLUTION_FILE, (const xmlChar *) s->solution_name);
+  if (s->mesh_cache_name)
+    xmlSetProp (node, XML_MESH_CACHE, (const xmlChar *) s->mesh_cache_name);
+  if (s->checkpoint_name)
+    {
+      xmlSetProp (node, XML_CHECKPOINT, (const xmlChar *) s->checkpoint_name);
+      if (s->checkpoint_interval > 0.)
+        jb_xml_node_set_float
+          (node, XML_CHECKPOINT_INTERVAL, s->checkpoint_interval);
+    }
+  if (s->calibration_name)
+    {
+      xmlSetProp (node, XML_CALIBRATION, (const xmlChar *) s->calibration_name);
+      if (s->calibration_iterations != CALIBRATION_ITERATIONS)
+        {
+          snprintf (number, 32, "%d", s->calibration_iterations);
+          xmlSetProp (node, XML_CALIBRATION_ITERATIONS,
+                      (const xmlChar *) number);
+        }
+    }
+  if (s->profile_name)
+    xmlSetProp (node, XML_PROFILING, (const xmlChar *) s->profile_name);
+  if (s->limiter_name)
+    xmlSetProp (node, XML_LIMITER, (const xmlChar *) s->limiter_name);
+  if (s->status_name)
+    {
+      xmlSetProp (node, XML_STATUS, (const xmlChar *) s->status_name);
+      jb_xml_node_set_float_with_default
+        (node, XML_STATUS_INTERVAL, s->status_interval, STATUS_INTERVAL);
+    }
+  jb_xml_node_set_float_with_default
+    (node, XML_RESAMPLE_INTERVAL, s->resample_interval, 0.);
   jb_xml_node_set_float_with_default (node, XML_CFL, s->cfl, CFL_DEFAULT);
   jb_xml_node_set_float_with_default
     (node, XML_IMPLICIT_NUMBER, s->implicit, 0.5);
@@ -1006,6 +1523,14 @@ _system_save_xml (System * s)
   jb_xml_node_set_float_with_default (node, XML_GRANULOMETRIC_COEFFICIENT,
                                       s->granulometric_coefficient,
                                       GRANULOMETRIC_COEFFICIENT);
+  if (!s->save_solution)
+    xmlSetProp (node, XML_SAVE_SOLUTION, (const xmlChar *) "0");
+  if (s->counters)
+    xmlSetProp (node, XML_COUNTERS, (const xmlChar *) "1");
+  if (s->output_mode == OUTPUT_MODE_INTERPOLATE)
+    xmlSetProp (node, XML_OUTPUT_MODE, XML_INTERPOLATE);
+  else if (s->output_mode == OUTPUT_MODE_AVERAGE)
+    xmlSetProp (node, XML_OUTPUT_MODE, XML_AVERAGE);
   for (i = 0; i <= s->nt; ++i)
     {
       child = xmlNewChild (node, 0, XML_TRANSPORT, 0);
@@ -1016,6 +1541,11 @@ _system_save_xml (System * s)
       child = xmlNewChild (node, 0, XML_CHANNEL, 0);
       channel_save_xml (s->channel + i, child);
     }
+  for (i = 0; i <= s->nout; ++i)
+    {
+      child = xmlNewChild (node, 0, XML_OUTPUT, 0);
+      output_save_xml (s->output + i, child, s->transport);
+    }
   buffer = (char *) g_build_filename (s->directory, s->name, NULL);
   xmlSaveFormatFile (buffer, doc, 1);
   xmlFreeDoc (doc);
@@ -0,0 +1,245 @@
+# Synthetic channel network generator for scaling tests.
+#
+# To run it: perl network.pl [options] > network.xml
+#
+# Options:
+#   --topology single|tree|loop: a long single channel, a binary tree
+#     distribution network or a main channel with looped parallel branches
+#     (default single).
+#   --cells N: cells number of every channel (default 1000000 in a single
+#     channel, 1000 in the networks).
+#   --cell-size DX: cell size in m (default 1).
+#   --levels N: levels number of the binary tree (default 4).
+#   --loops N: loops number of the looped network (default 8).
+#   --sections N: cross sections number of every channel (default 11).
+#   --shape trapezoidal|compound|irregular: cross section shape (default
+#     trapezoidal).
+#   --gate: gate outlets instead of depth outlets.
+#   --solutes N: transported solutes number (default 0).
+#   --hours N: simulated time in hours (default 1).
+#   --seed N: random seed of the irregular cross sections (default 1).
+#
+# The inlet of the first channel is a hydrograph. The tree and loop branches
+# are connected with tributary junctions to the cross sections of their parent
+# channels.
+
+use strict;
+use Getopt::Long;
+
+my $topology = 'single';
+my $cells;
+my $dx = 1.;
+my $levels = 4;
+my $loops = 8;
+my $nsections = 11;
+my $shape = 'trapezoidal';
+my $gate = 0;
+my $solutes = 0;
+my $hours = 1;
+my $seed = 1;
+GetOptions ('topology=s' => \$topology, 'cells=i' => \$cells,
+	'cell-size=f' => \$dx, 'levels=i' => \$levels, 'loops=i' => \$loops,
+	'sections=i' => \$nsections, 'shape=s' => \$shape, 'gate' => \$gate,
+	'solutes=i' => \$solutes, 'hours=i' => \$hours, 'seed=i' => \$seed)
+	or die "Bad options\n";
+$topology =~ /^(single|tree|loop)$/ or die "Bad topology: $topology\n";
+$shape =~ /^(trapezoidal|compound|irregular)$/ or die "Bad shape: $shape\n";
+$cells = ($topology eq 'single' ? 1000000 : 1000) unless defined $cells;
+$cells > 0 && $dx > 0. && $levels > 0 && $loops > 0 && $hours > 0
+	or die "Bad sizes\n";
+$nsections = 2 * $loops + 3
+	if $topology eq 'loop' && $nsections < 2 * $loops + 3;
+$nsections = 5 if $nsections < 5;
+srand ($seed);
+
+my $slope = 1e-4;	# bed slope
+my $width = 10.;	# bottom width
+my $depth = 1.;		# initial and outlet depth
+my $discharge = 10.;	# base inlet discharge
+my $manning = 0.03;	# Manning roughness coefficient
+my $length = $cells * $dx;
+
+# Channels: name, plan origin, bed level at the inlet, discharge, inlet and
+# outlet junctions as [channel, initial section, final section]
+my @channels;
+
+sub channel
+{
+	my ($x, $y, $z, $q, $inlet, $outlet) = @_;
+	my $i = @channels;
+	push @channels, { name => 'c' . ($i + 1), x => $x, y => $y, z => $z,
+		q => $q, inlet => $inlet, outlet => $outlet };
+	return $i;
+}
+
+# Section number of a distance fraction along a channel
+sub section
+{
+	my $f = shift;
+	my $k = int ($f * ($nsections - 1) + 0.5);
+	$k = 1 if $k < 1;
+	$k = $nsections - 2 if $k > $nsections - 2;
+	return $k;
+}
+
+if ($topology eq 'single')
+{
+	channel (0., 0., $slope * $length, $discharge);
+}
+elsif ($topology eq 'tree')
+{
+	my @parents = (channel (0., 0., $levels * $slope * $length, $discharge));
+	for (my $l = 1; $l < $levels; ++$l)
+	{
+		my @children;
+		foreach my $p (@parents)
+		{
+			my $c = $channels[$p];
+			for (my $b = 0; $b < 2; ++$b)
+			{
+				my $k = section ((1 + $b) / 3.);
+				my $f = $k / ($nsections - 1.);
+				push @children, channel ($c->{x} + $f * $length,
+					$c->{y} + (2 * $b - 1) * $length / 2 ** $l,
+					$c->{z} - $f * $slope * $length, $c->{q} / 3.,
+					[$p, $k, $k + 1]);
+			}
+		}
+		@parents = @children;
+	}
+}
+else
+{
+	my $m = channel (0., 0., $slope * $length, $discharge);
+	for (my $l = 0; $l < $loops; ++$l)
+	{
+		my $k = 2 * $l + 1;
+		my $f = $k / ($nsections - 1.);
+		channel ($f * $length, ($l + 1) * $length / $loops,
+			(1. - $f) * $slope * $length, $discharge / (2 * $loops),
+			[$m, $k, $k], [$m, $k + 1, $k + 1]);
+	}
+}
+
+# Transient section points as "y z" or "y z r t" lines
+sub points
+{
+	my $z = shift;
+	my @p;
+	if ($shape eq 'trapezoidal')
+	{
+		@p = ([0., $z + 3.], [3., $z], [3. + $width, $z],
+			[6. + $width, $z + 3.]);
+	}
+	elsif ($shape eq 'compound')
+	{
+		@p = ([0., $z + 4.], [2., $z + 2.], [22., $z + 2.], [24., $z],
+			[24. + $width, $z], [26. + $width, $z + 2.],
+			[46. + $width, $z + 2.], [48. + $width, $z + 4.]);
+	}
+	else
+	{
+		my $n = 12;
+		for (my $i = 0; $i <= $n; ++$i)
+		{
+			my $s = 2. * $i / $n - 1.;
+			push @p, [($i + 0.2 * (rand () - 0.5)) * ($width + 6.) / $n,
+				$z + 3. * $s * $s + 0.2 * rand ()];
+		}
+		$p[0][1] = $p[$n][1] = $z + 3.2;
+	}
+	return join ('',
+		map ({ sprintf ("\t\t\t\t\t%.14e %.14e %.14e 0\n", @$_, $manning) }
+			@p[0 .. $#p - 1]),
+		sprintf ("\t\t\t\t\t%.14e %.14e\n", @{$p[$#p]}));
+}
+
+# Time series lines at the initial time and every hour
+sub series
+{
+	my ($v0, $v1) = @_;
+	my $s = '';
+	for (my $i = 0; $i <= $hours; ++$i)
+	{
+		$s .= sprintf ("\t\t\t%d %d %d %d 0 0 %.14e\n", 2010, 1,
+			1 + int ($i / 24), $i % 24, $i % 2 ? $v1 : $v0);
+	}
+	return $s;
+}
+
+sub junction
+{
+	my ($type, $j) = @_;
+	my ($c, $i, $f) = @$j;
+	printf "\t\t<%s type=\"junction\">\n", $type;
+	printf "\t\t\t<junction channel=\"%s\" initial=\"%d.sec\""
+		. " final=\"%d.sec\"/>\n", $channels[$c]->{name}, $i + 1, $f + 1;
+	printf "\t\t</%s>\n", $type;
+}
+
+printf "<?xml version=\"1.0\"?>\n";
+printf "<system initial_time=\"2010 1 1 0 0 0\" final_time=\"2010 1 %d %d 0 0\""
+	. " solution_file=\"network.bin\">\n", 1 + int ($hours / 24), $hours % 24;
+for (my $i = 1; $i <= $solutes; ++$i)
+{
+	printf "\t<transport name=\"Solute%d\" solubility=\"100\"/>\n", $i;
+}
+foreach my $c (@channels)
+{
+	printf "\t<channel name=\"%s\" cell_size=\"%g\">\n", $c->{name}, $dx;
+	print "\t\t<geometry>\n";
+	for (my $i = 0; $i < $nsections; ++$i)
+	{
+		my $f = $i / ($nsections - 1.);
+		printf "\t\t\t<cross_section name=\"%d.sec\" x=\"%.14e\" y=\"%.14e\""
+			. " angle=\"0\">\n", $i + 1, $c->{x} + $f * $length, $c->{y};
+		printf "\t\t\t\t<transient_section name=\"%d.tra\">\n", $i + 1;
+		print points ($c->{z} - $f * $slope * $length);
+		print "\t\t\t\t</transient_section>\n";
+		print "\t\t\t</cross_section>\n";
+	}
+	print "\t\t</geometry>\n";
+	print "\t\t<initial type=\"xqh\">\n";
+	printf "\t\t\t0 %.14e %.14e\n", $c->{q}, $depth;
+	print "\t\t</initial>\n";
+	if ($c->{inlet})
+	{
+		junction ('inlet', $c->{inlet});
+	}
+	else
+	{
+		print "\t\t<inlet type=\"qt\">\n";
+		print series ($c->{q}, 2. * $c->{q});
+		print "\t\t</inlet>\n";
+	}
+	if ($c->{outlet})
+	{
+		junction ('outlet', $c->{outlet});
+	}
+	elsif ($gate)
+	{
+		printf "\t\t<outlet type=\"gate\" height=\"%.14e\" width=\"%.14e\">\n",
+			$c->{z} - $slope * $length + 0.5 * $depth, $width;
+		print series (1., 0.5);
+		print "\t\t</outlet>\n";
+	}
+	else
+	{
+		printf "\t\t<outlet type=\"h\" depth=\"%.14e\"/>\n", $depth;
+	}
+	for (my $i = 1; $i <= $solutes; ++$i)
+	{
+		print "\t\t<transport>\n";
+		print "\t\t\t<initial type=\"dry\"/>\n";
+		unless ($c->{inlet})
+		{
+			printf "\t\t\t<boundary name=\"inlet\" type=\"q\" initial=\"1.sec\""
+				. " final=\"1.sec\">\n";
+			print series ($i * $c->{q}, 0.);
+			print "\t\t\t</boundary>\n";
+		}
+		print "\t\t</transport>\n";
+	}
+	print "\t</channel>\n";
+}
+print "</system>\n";
@@ -112,8 +112,8 @@ void transport_scheme_outlet_upwind
 
 #if !INLINE_TRANSPORT_BOUNDARY
 void transport_boundary
-  (TransportParameters * tp, Parameters * p, Mass * m, BoundaryTransport * bt)
+  (TransportParameters * tp, Parameters * p, BoundaryTransport * bt)
 {
-  _transport_boundary (tp, p, m, bt);
+  _transport_boundary (tp, p, bt);
 }
 #endif
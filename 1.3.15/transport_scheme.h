@@ -510,7 +510,7 @@ void transport_scheme_outlet_upwind
 #endif
 
 static inline void _transport_boundary
-  (TransportParameters * tp, Parameters * p, Mass * m, BoundaryTransport * bt)
+  (TransportParameters * tp, Parameters * p, BoundaryTransport * bt)
 {
   int i;
   register JBDOUBLE mass;
@@ -520,7 +520,7 @@ static inline void _transport_boundary
       fprintf (stderr, "transport_boundary: start\n");
       fprintf (stderr, "TB position=%d type=%d i=%d i2=%d\n",
                bt->pos, bt->type, bt->i, bt->i2);
-      fprintf (stderr, "TB im=" FWL " t=" FWL " tmax=" FWL "\n", m->inner, t,
+      fprintf (stderr, "TB im=" FWL " t=" FWL " tmax=" FWL "\n", bt->mass, t,
                tmax);
     }
 #endif
@@ -537,14 +537,18 @@ static inline void _transport_boundary
         mass = 0.;
       break;
     default:
-      mass = jbm_darray_farray_integral (bt->t, bt->p, bt->n, t, tmax);
+      if (bt->grid->x)
+        mass = series_integral (bt->cursor, t, tmax, bt->grid->x,
+                                bt->grid->p1, bt->grid->n);
+      else
+        mass = series_integral (bt->cursor, t, tmax, bt->t, bt->p, bt->n);
 #if DEBUG_TRANSPORT_BOUNDARY
       if (t >= DEBUG_TIME)
         fprintf (stderr, "TB mass=" FWL " length=" FWF "\n", mass, bt->length);
 #endif
     }
   g_mutex_lock (mutex);
-  m->inner += mass;
+  bt->mass += mass;
   bt->contribution = mass / dt;
   mass /= bt->length;
   for (i = bt->i; i <= bt->i2; ++i)
@@ -554,7 +558,7 @@ static inline void _transport_boundary
   if (t >= DEBUG_TIME)
     {
       fprintf (stderr, "TB im=" FWL " dm=" FWL " c=" FWF "\n",
-               m->inner, mass, (tp + bt->i)->c);
+               bt->mass, mass, (tp + bt->i)->c);
       fprintf (stderr, "transport_boundary: end\n");
     }
 #endif
@@ -564,7 +568,7 @@ static inline void _transport_boundary
 #define transport_boundary _transport_boundary
 #else
 void transport_boundary
-  (TransportParameters *, Parameters *, Mass *, BoundaryTransport *);
+  (TransportParameters *, Parameters *, BoundaryTransport *);
 #endif
 
 #endif
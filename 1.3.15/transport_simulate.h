@@ -205,6 +205,7 @@ static inline void
 _part_transport_step (int thread)
 {
   int i;
+  gint64 time0;
   GSList *l;
   ChannelGeometry *cg;
   Parameters *pv;
@@ -213,6 +214,7 @@ _part_transport_step (int thread)
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_transport_step: start\n");
 #endif
+  time0 = g_get_monotonic_time ();
   for (l = list_channels[thread]; l; l = l->next)
     {
       cg = (ChannelGeometry *) l->data;
@@ -232,6 +234,8 @@ _part_transport_step (int thread)
             (tpv, pv, cg->cs[cg->n].i - cg->cs->i, m + i + 1);
         }
     }
+  time0 = g_get_monotonic_time () - time0;
+  profile_thread_add (profile, PROFILE_PHASE_TRANSPORT_STEP, thread, time0);
 #if DEBUG_PART_TRANSPORT_STEP
   if (t >= DEBUG_TIME)
     fprintf (stderr, "part_transport_step: end\n");
@@ -254,6 +258,7 @@ static inline void
 _system_transport_step_parallel ()
 {
   int i;
+  gint64 time0;
   GThread *thread[nth];
 #if DEBUG_SYSTEM_TRANSPORT_STEP_PARALLEL
   if (t >= DEBUG_TIME)
@@ -264,8 +269,11 @@ _system_transport_step_parallel ()
       (NULL, (void (*)) part_transport_step, (void *) (size_t) i);
   for (i = 0; i < nth; ++i)
     g_thread_join (thread[i]);
+  time0 = g_get_monotonic_time ();
   for (i = 0; i <= njunctions; ++i)
     junction_transport_scheme (junction + i);
+  profile_add
+    (profile, PROFILE_PHASE_JUNCTIONS, g_get_monotonic_time () - time0);
 #if DEBUG_SYSTEM_TRANSPORT_STEP_PARALLEL
   if (t >= DEBUG_TIME)
     fprintf (stderr, "system_transport_step_parallel: end\n");
@@ -288,13 +296,17 @@ static inline void
 _system_transport_step_simple ()
 {
   int i;
+  gint64 time0;
 #if DEBUG_SYSTEM_TRANSPORT_STEP_SIMPLE
   if (t >= DEBUG_TIME)
     fprintf (stderr, "system_transport_step_simple: start\n");
 #endif
   part_transport_step (0);
+  time0 = g_get_monotonic_time ();
   for (i = 0; i <= njunctions; ++i)
     junction_transport_scheme (junction + i);
+  profile_add
+    (profile, PROFILE_PHASE_JUNCTIONS, g_get_monotonic_time () - time0);
 #if DEBUG_SYSTEM_TRANSPORT_STEP_SIMPLE
   if (t >= DEBUG_TIME)
     fprintf (stderr, "system_transport_step_simple: end\n");
@@ -67,6 +67,18 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * \brief array of masses.
  * \var list_channels
  * \brief array of channels lists.
+ * \var mesh_cache
+ * \brief binary mesh cache file.
+ * \var mesh_arena
+ * \brief arena of the packed section tables of the mesh cells.
+ * \var thread_arena
+ * \brief arenas of the sections opened by every thread while building the mesh.
+ * \var profile
+ * \brief wall clock profile of the simulation phases.
+ * \var profile_phase_name
+ * \brief names of the profiled phases.
+ * \var profile_counter_name
+ * \brief names of the hardware performance counters.
  */
 int nth, nthreads, n, njunctions, vsize;
 JBDOUBLE t, dt, tmax;
@@ -77,3 +89,13 @@ Variables v[1];
 Junction *junction = NULL;
 Mass *m = NULL;
 GSList **list_channels = NULL;
+MeshCache mesh_cache[1];
+SectionArena mesh_arena[1], *thread_arena = NULL;
+Profile profile[1];
+const char *profile_phase_name[PROFILE_PHASES] = {
+  "decomposition", "simulate_step", "simulate_step2", "transport_step",
+  "parameters2", "junctions", "sections", "write"
+};
+const char *profile_counter_name[PROFILE_COUNTERS] = {
+  "cycles", "instructions", "llc_misses", "branch_misses"
+};
@@ -82,9 +82,17 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * \brief a typical new system of channels.
  * \var sys
  * \brief the system of channels to simulate.
+ * \var section_memo
+ * \brief sections opened while building the mesh indexed by their transient
+ *   sections.
+ * \var section_pair_memo
+ * \brief friction parameters interpolated while building the mesh indexed by
+ *   the transient sections of the segment and the interpolation weight.
  */
 char *message = NULL;
 GMutex mutex[1];
+GHashTable *section_memo = NULL;
+GHashTable *section_pair_memo = NULL;
 int simulating = 0;
 SectionPoint2 spnew[2] = { {0., 0., 0.03, 0}, {1., 1., 0., 0} };
 
@@ -94,35 +102,39 @@ TransientSection tsnew[2] = {
 };
 
 CrossSection csnew[NEW_GEOMETRY_SIZE] = {
-  {0, 0, 0, 0, 0, 0, 0, 0, 0., 0., 90., 0., 0., 0., 0., 0., tsnew,
-   "Section1", NULL, NULL},
-  {0, 0, 0, 0, 0, 0, 0, 0, 1., 0., 90., 0., 0., 0., 0., 0., tsnew + 1,
-   "Section2", NULL, NULL}
+  {0, 0, 0, 0, 0, 0, 0, 0, 1, 0., 0., 90., 0., 0., 0., 0., 0., 0., 0., 0.,
+   0., tsnew, "Section1", NULL, NULL},
+  {0, 0, 0, 0, 0, 0, 0, 0, 1, 1., 0., 90., 0., 0., 0., 0., 0., 0., 0., 0.,
+   0., tsnew + 1, "Section2", NULL, NULL}
 };
-JBFLOAT bfnew1t[1] = { 0. };
+JBDOUBLE bfnew1t[1] = { 0. };
 JBFLOAT bfnew1p1[1] = { 0. };
-JBFLOAT bfnew2t[1] = { 0. };
+JBDOUBLE bfnew2t[1] = { 0. };
 JBFLOAT bfnew2p1[1] = { 0. };
-JBFLOAT bfnew3t[1] = { 0. };
+JBDOUBLE bfnew3t[1] = { 0. };
 JBFLOAT bfnew3p1[1] = { 0. };
 
 BoundaryFlow bfnew[3] = {
-  {0, 0, 0, 0, 0, 0, 0, 0., 0., bfnew1t, bfnew1p1, 0, "Inner1", 0},
-  {0, 0, 0, 0, 0, 0, -1, 0., 0., bfnew2t, bfnew2p1, 0, "Inlet", 0},
-  {0, 1, 1, 0, 0, 0, 1, 0., 0., bfnew3t, bfnew3p1, 0, "Outlet", 0}
+  {0, 0, 0, 0, 0, 0, 0, 0., 0., 0., bfnew1t, bfnew1p1, 0, "Inner1", 0},
+  {0, 0, 0, 0, 0, 0, -1, 0., 0., 0., bfnew2t, bfnew2p1, 0, "Inlet", 0},
+  {0, 1, 1, 0, 0, 0, 1, 0., 0., 0., bfnew3t, bfnew3p1, 0, "Outlet", 0}
 };
 BoundaryTransport btnew[1] =
-  { {0, 1, 1, 0, 0, 0, 0., 0., 0., bfnew1t, bfnew1p1, "Boundary"} };
+  { {0, 1, 1, 0, 0, 0, 0., 0., 0., bfnew1p1, 0., bfnew1t, "Boundary"} };
 ChannelTransport ctnew[1] = { {-1, {{0, 0, 0}}, NULL} };
 JBFLOAT cgnewx[NEW_GEOMETRY_SIZE] = { 0., 1. };
 Channel chanew[1] = { {1, -1, 0, 1, 0, 1., {{1, cgnewx, csnew}},
                        {{0, 0, 0}}, bfnew + 1, NULL, NULL, NULL, NULL, "Channel"}
 };
 
-System sys[1], sysnew[1] = { {0, -1, 0., 0., 0., 0., 0.9, 0.5, 1e-12, 0.,
+System sys[1], sysnew[1] = { {0, -1, -1, 0., 0., 0., 0., 0.9, 0.5, 1e-12, 0.,
                               SECTION_WIDTH_MIN, FLOW_DEPTH_MIN,
-                              GRANULOMETRIC_COEFFICIENT, NULL, NULL,
-                              chanew, "New.xml", ".", "sol.tmp", NULL, NULL,
-                              NULL, "./sol.tmp", NULL,
-                              NULL, NULL}
+                              GRANULOMETRIC_COEFFICIENT, 0., 0.,
+                              STATUS_INTERVAL, 0., 1,
+                              STREAMS_FORMAT_TEXT, 1, OUTPUT_MODE_CLIP, 0,
+                              CALIBRATION_ITERATIONS, NULL, NULL, chanew, NULL,
+                              "New.xml", ".", "sol.tmp", NULL, NULL, NULL,
+                              "./sol.tmp", NULL, NULL, NULL,
+                              NULL, NULL, NULL, NULL, NULL, NULL,
+                              NULL, NULL, NULL, NULL, NULL, NULL}
 };
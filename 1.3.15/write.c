@@ -306,3 +306,452 @@ write_contributions (FILE * file, JBDOUBLE t, System * s)
   _write_contributions (file, t, s);
 }
 #endif
+
+/**
+ * \fn FILE* write_file_open(char *path, int binary, long offset)
+ * \brief Function to open an output file, resuming it at a file offset when
+ *   restarting from a checkpoint and truncating it there.
+ * \param path
+ * \brief file path.
+ * \param binary
+ * \brief 1 on binary files, 0 on text files.
+ * \param offset
+ * \brief file offset to resume the writing, 0 to create a new file.
+ * \return the opened file, NULL on error.
+ */
+#if !INLINE_WRITE_FILE_OPEN
+FILE *
+write_file_open (char *path, int binary, long offset)
+{
+  return _write_file_open (path, binary, offset);
+}
+#endif
+
+/**
+ * \fn gint64 write_file_offset(FILE *file)
+ * \brief Function to flush an output file and to get its actual offset.
+ * \param file
+ * \brief output file, or NULL.
+ * \return the file offset, 0 if the file is not opened.
+ */
+#if !INLINE_WRITE_FILE_OFFSET
+gint64
+write_file_offset (FILE * file)
+{
+  return _write_file_offset (file);
+}
+#endif
+
+/**
+ * \fn int stream_plumes_header(FILE *file, System *s)
+ * \brief Function to write the column names of a binary plumes file.
+ * \param file
+ * \brief binary file of the plumes. If NULL the columns are only counted.
+ * \param s
+ * \brief system of channels.
+ * \return number of columns.
+ */
+#if !INLINE_STREAM_PLUMES_HEADER
+int
+stream_plumes_header (FILE * file, System * s)
+{
+  return _stream_plumes_header (file, s);
+}
+#endif
+
+/**
+ * \fn int stream_contributions_header(FILE *file, System *s)
+ * \brief Function to write the column names of a binary contributions file.
+ * \param file
+ * \brief binary file of the contributions. If NULL the columns are only
+ *   counted.
+ * \param s
+ * \brief system of channels.
+ * \return number of columns.
+ */
+#if !INLINE_STREAM_CONTRIBUTIONS_HEADER
+int
+stream_contributions_header (FILE * file, System * s)
+{
+  return _stream_contributions_header (file, s);
+}
+#endif
+
+/**
+ * \fn void stream_plumes_record(JBDOUBLE *record, Parameters *p, \
+ *   TransportParameters *tp, System *s)
+ * \brief Function to fill the plumes limits in a binary record.
+ * \param record
+ * \brief array of record columns.
+ * \param p
+ * \brief array of flow parameters.
+ * \param tp
+ * \brief array of transport parameters.
+ * \param s
+ * \brief system of channels.
+ */
+#if !INLINE_STREAM_PLUMES_RECORD
+void
+stream_plumes_record (JBDOUBLE * record, Parameters * p,
+                      TransportParameters * tp, System * s)
+{
+  _stream_plumes_record (record, p, tp, s);
+}
+#endif
+
+/**
+ * \fn void stream_contributions_record(JBDOUBLE *record, System *s)
+ * \brief Function to fill the boundary discharge contributions in a binary
+ *   record.
+ * \param record
+ * \brief array of record columns.
+ * \param s
+ * \brief system of channels.
+ */
+#if !INLINE_STREAM_CONTRIBUTIONS_RECORD
+void
+stream_contributions_record (JBDOUBLE * record, System * s)
+{
+  _stream_contributions_record (record, s);
+}
+#endif
+
+/**
+ * \fn int stream_open(Stream *stream, char *path, int type, System *s, \
+ *   long offset)
+ * \brief Function to open a plumes or contributions output stream.
+ * \param stream
+ * \brief output stream.
+ * \param path
+ * \brief file path.
+ * \param type
+ * \brief type of stream data.
+ * \param s
+ * \brief system of channels.
+ * \param offset
+ * \brief file offset to resume the stream, 0 to create a new stream.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_STREAM_OPEN
+int
+stream_open (Stream * stream, char *path, int type, System * s, long offset)
+{
+  return _stream_open (stream, path, type, s, offset);
+}
+#endif
+
+/**
+ * \fn void stream_write(Stream *stream, Parameters *p, \
+ *   TransportParameters *tp, JBDOUBLE t, System *s)
+ * \brief Function to write a time step in a plumes or contributions output
+ *   stream.
+ * \param stream
+ * \brief output stream.
+ * \param p
+ * \brief array of flow parameters.
+ * \param tp
+ * \brief array of transport parameters.
+ * \param t
+ * \brief actual time.
+ * \param s
+ * \brief system of channels.
+ */
+#if !INLINE_STREAM_WRITE
+void
+stream_write (Stream * stream, Parameters * p, TransportParameters * tp,
+              JBDOUBLE t, System * s)
+{
+  _stream_write (stream, p, tp, t, s);
+}
+#endif
+
+/**
+ * \fn void stream_close(Stream *stream)
+ * \brief Function to close a plumes or contributions output stream.
+ * \param stream
+ * \brief output stream.
+ */
+#if !INLINE_STREAM_CLOSE
+void
+stream_close (Stream * stream)
+{
+  _stream_close (stream);
+}
+#endif
+
+/**
+ * \fn int stream_convert(char *name_read, char *name_write)
+ * \brief Function to convert a binary plumes or contributions file in the
+ *   ASCII format.
+ * \param name_read
+ * \brief binary file name.
+ * \param name_write
+ * \brief ASCII file name.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_STREAM_CONVERT
+int
+stream_convert (char *name_read, char *name_write)
+{
+  return _stream_convert (name_read, name_write);
+}
+#endif
+
+/**
+ * \fn int write_output_open(Output *o, System *s, JBDOUBLE t, long offset)
+ * \brief Function to open the binary file of a selective output.
+ * \param o
+ * \brief selective output.
+ * \param s
+ * \brief system of channels.
+ * \param t
+ * \brief time of the next output.
+ * \param offset
+ * \brief file offset to resume the output, 0 to create a new file.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_WRITE_OUTPUT_OPEN
+int
+write_output_open (Output * o, System * s, JBDOUBLE t, long offset)
+{
+  return _write_output_open (o, s, t, offset);
+}
+#endif
+
+/**
+ * \fn void write_output(Output *o, Parameters *p, TransportParameters *tp, \
+ *   JBDOUBLE t, int n)
+ * \brief Function to save the selected variables of some mesh cells in the
+ *   binary file of a selective output.
+ * \param o
+ * \brief selective output.
+ * \param p
+ * \brief array of flow parameters.
+ * \param tp
+ * \brief array of transport parameters.
+ * \param t
+ * \brief actual time.
+ * \param n
+ * \brief number of mesh cells.
+ */
+#if !INLINE_WRITE_OUTPUT
+void
+write_output (Output * o, Parameters * p, TransportParameters * tp,
+              JBDOUBLE t, int n)
+{
+  _write_output (o, p, tp, t, n);
+}
+#endif
+
+/**
+ * \fn void write_output_close(Output *o)
+ * \brief Function to close the binary file of a selective output.
+ * \param o
+ * \brief selective output.
+ */
+#if !INLINE_WRITE_OUTPUT_CLOSE
+void
+write_output_close (Output * o)
+{
+  _write_output_close (o);
+}
+#endif
+
+/**
+ * \fn int sampler_open(Sampler *s, int mode, Variables *v, int n, int nt, \
+ *   JBDOUBLE t)
+ * \brief Function to open a sampler of the solution at the measured times.
+ * \param s
+ * \brief sampler.
+ * \param mode
+ * \brief output mode.
+ * \param v
+ * \brief variables.
+ * \param n
+ * \brief number of mesh cells.
+ * \param nt
+ * \brief highest solute number.
+ * \param t
+ * \brief actual time.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_SAMPLER_OPEN
+int
+sampler_open (Sampler * s, int mode, Variables * v, int n, int nt, JBDOUBLE t)
+{
+  return _sampler_open (s, mode, v, n, nt, t);
+}
+#endif
+
+/**
+ * \fn void sampler_advance(Sampler *s, Variables *v, JBDOUBLE t)
+ * \brief Function to store the solution at the start of a time step in a
+ *   sampler, integrating in time the previous step on averaged outputs.
+ * \param s
+ * \brief sampler.
+ * \param v
+ * \brief variables.
+ * \param t
+ * \brief actual time.
+ */
+#if !INLINE_SAMPLER_ADVANCE
+void
+sampler_advance (Sampler * s, Variables * v, JBDOUBLE t)
+{
+  _sampler_advance (s, v, t);
+}
+#endif
+
+/**
+ * \fn int sampler_write(Sampler *s, Variables *v, JBDOUBLE t, JBDOUBLE at, \
+ *   FILE *file)
+ * \brief Function to save in the solution file the interpolated or averaged
+ *   solution at a measured time.
+ * \param s
+ * \brief sampler.
+ * \param v
+ * \brief variables.
+ * \param t
+ * \brief actual time.
+ * \param at
+ * \brief measured time.
+ * \param file
+ * \brief solution file.
+ * \return number of saved values on success, 0 on error.
+ */
+#if !INLINE_SAMPLER_WRITE
+int
+sampler_write (Sampler * s, Variables * v, JBDOUBLE t, JBDOUBLE at,
+               FILE * file)
+{
+  return _sampler_write (s, v, t, at, file);
+}
+#endif
+
+/**
+ * \fn void sampler_close(Sampler *s)
+ * \brief Function to free the memory used by a sampler.
+ * \param s
+ * \brief sampler.
+ */
+#if !INLINE_SAMPLER_CLOSE
+void
+sampler_close (Sampler * s)
+{
+  _sampler_close (s);
+}
+#endif
+
+/**
+ * \fn int checkpoint_save(Checkpoint *c, Sampler *sampler, Stream *plumes, \
+ *   Stream *contributions, System *s, char *path)
+ * \brief Function to save atomically the state of a running simulation in the
+ *   checkpoint file.
+ * \param c
+ * \brief checkpoint header with the key of the mesh and the state of the
+ *   simulation loop.
+ * \param sampler
+ * \brief solution sampler.
+ * \param plumes
+ * \brief plumes stream.
+ * \param contributions
+ * \brief contributions stream.
+ * \param s
+ * \brief system of channels.
+ * \param path
+ * \brief checkpoint file path.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_CHECKPOINT_SAVE
+int
+checkpoint_save (Checkpoint * c, Sampler * sampler, Stream * plumes,
+                 Stream * contributions, System * s, char *path)
+{
+  return _checkpoint_save (c, sampler, plumes, contributions, s, path);
+}
+#endif
+
+/**
+ * \fn int checkpoint_load(Checkpoint *c, Sampler *sampler, Stream *plumes, \
+ *   Stream *contributions, System *s, char *name, char *path)
+ * \brief Function to restore the state of a simulation from the checkpoint
+ *   file and to reopen the output files at the saved offsets.
+ * \param c
+ * \brief checkpoint header with the key of the mesh. It returns the state of
+ *   the simulation loop.
+ * \param sampler
+ * \brief opened solution sampler.
+ * \param plumes
+ * \brief plumes stream.
+ * \param contributions
+ * \brief contributions stream.
+ * \param s
+ * \brief system of channels.
+ * \param name
+ * \brief checkpoint file name.
+ * \param path
+ * \brief checkpoint file path.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_CHECKPOINT_LOAD
+int
+checkpoint_load (Checkpoint * c, Sampler * sampler, Stream * plumes,
+                 Stream * contributions, System * s, char *name, char *path)
+{
+  return _checkpoint_load (c, sampler, plumes, contributions, s, name, path);
+}
+#endif
+
+/**
+ * \fn void status_open(Status *st, System *s)
+ * \brief Function to start the live status file of a simulation run.
+ * \param st
+ * \brief live status file.
+ * \param s
+ * \brief system of channels.
+ */
+#if !INLINE_STATUS_OPEN
+void
+status_open (Status * st, System * s)
+{
+  _status_open (st, s);
+}
+#endif
+
+/**
+ * \fn int status_write(Status *st, System *s, int finished)
+ * \brief Function to rewrite atomically the live status file with the
+ *   simulated time, the speed, the time step size limit, the mass errors and
+ *   the phase timings of a running simulation.
+ * \param st
+ * \brief live status file.
+ * \param s
+ * \brief system of channels.
+ * \param finished
+ * \brief 1 at the end or at the stop of the simulation, 0 otherwise.
+ * \return 1 on success, 0 on error.
+ */
+#if !INLINE_STATUS_WRITE
+int
+status_write (Status * st, System * s, int finished)
+{
+  return _status_write (st, s, finished);
+}
+#endif
+
+/**
+ * \fn void status_step(Status *st, System *s)
+ * \brief Function to count a time step and to rewrite the live status file if
+ *   the wall time interval is elapsed.
+ * \param st
+ * \brief live status file.
+ * \param s
+ * \brief system of channels.
+ */
+#if !INLINE_STATUS_STEP
+void
+status_step (Status * st, System * s)
+{
+  _status_step (st, s);
+}
+#endif
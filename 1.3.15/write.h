@@ -36,6 +36,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef WRITE_H
 #define WRITE_H 1
 
+#include <unistd.h>
 #include "flow_scheme.h"
 
 extern int nstep;
@@ -504,4 +505,1388 @@ _write_contributions (FILE * file, JBDOUBLE t, System * s)
 void write_contributions (FILE *, JBDOUBLE, System *);
 #endif
 
+static inline FILE *
+_write_file_open (char *path, int binary, long offset)
+{
+  FILE *file;
+#if DEBUG_WRITE_FILE_OPEN
+  fprintf (stderr, "write_file_open: start\n");
+  fprintf (stderr, "WFO path=%s binary=%d offset=%ld\n", path, binary, offset);
+#endif
+  if (offset <= 0)
+    file = g_fopen (path, binary ? "wb" : "w");
+  else
+    {
+      // the records written after the offset by a longer previous run or trial
+      // are discarded
+      file = g_fopen (path, binary ? "r+b" : "r+");
+      if (file && (fseek (file, offset, SEEK_SET)
+                   || ftruncate (fileno (file), offset)))
+        {
+          fclose (file);
+          file = NULL;
+        }
+    }
+#if DEBUG_WRITE_FILE_OPEN
+  fprintf (stderr, "write_file_open: end\n");
+#endif
+  return file;
+}
+
+#if INLINE_WRITE_FILE_OPEN
+#define write_file_open _write_file_open
+#else
+FILE *write_file_open (char *, int, long);
+#endif
+
+static inline gint64
+_write_file_offset (FILE * file)
+{
+  gint64 offset;
+#if DEBUG_WRITE_FILE_OFFSET
+  fprintf (stderr, "write_file_offset: start\n");
+#endif
+  offset = 0;
+  if (file)
+    {
+      fflush (file);
+      offset = ftell (file);
+    }
+#if DEBUG_WRITE_FILE_OFFSET
+  fprintf (stderr, "WFO offset=%ld\n", (long) offset);
+  fprintf (stderr, "write_file_offset: end\n");
+#endif
+  return offset;
+}
+
+#if INLINE_WRITE_FILE_OFFSET
+#define write_file_offset _write_file_offset
+#else
+gint64 write_file_offset (FILE *);
+#endif
+
+/**
+ * \def STREAM_LABEL
+ * \brief Macro to define the label identifying the binary plumes and
+ *   contributions files.
+ * \def STREAM_NAME_SIZE
+ * \brief Macro to define the size of the column names in the header of the
+ *   binary plumes and contributions files.
+ */
+#define STREAM_LABEL "SWIGSSTR"
+#define STREAM_NAME_SIZE 64
+
+/**
+ * \enum StreamType
+ * \brief Enumeration to define the data saved in a stream file.
+ * \var STREAM_TYPE_PLUMES
+ * \brief plumes of the transported solutes.
+ * \var STREAM_TYPE_CONTRIBUTIONS
+ * \brief boundary discharge contributions.
+ */
+enum StreamType
+{
+  STREAM_TYPE_PLUMES = 0,
+  STREAM_TYPE_CONTRIBUTIONS = 1
+};
+
+/**
+ * \struct StreamHeader
+ * \brief Structure to define the header of a binary stream file. It is
+ *   followed by ncolumns names of STREAM_NAME_SIZE characters and by records of
+ *   (ncolumns + 1) JBDOUBLE numbers, the first one being the time.
+ */
+typedef struct
+{
+/**
+ * \var label
+ * \brief STREAM_LABEL identifier.
+ * \var type
+ * \brief type of stream data.
+ * \var ncolumns
+ * \brief number of columns in a record excluding the time.
+ * \var size
+ * \brief size of a column in bytes.
+ */
+  char label[8];
+  int type, ncolumns, size;
+} StreamHeader;
+
+/**
+ * \struct Stream
+ * \brief Structure to define an output stream of plumes or contributions.
+ */
+typedef struct
+{
+/**
+ * \var file
+ * \brief output file.
+ * \var record
+ * \brief array to build a binary record.
+ * \var type
+ * \brief type of stream data.
+ * \var format
+ * \brief file format.
+ * \var ncolumns
+ * \brief number of columns in a record excluding the time.
+ */
+  FILE *file;
+  JBDOUBLE *record;
+  int type, format, ncolumns;
+} Stream;
+
+static inline int
+_stream_plumes_header (FILE * file, System * s)
+{
+  int i, j, k;
+  char name[STREAM_NAME_SIZE];
+  Channel *channel;
+#if DEBUG_STREAM_PLUMES_HEADER
+  fprintf (stderr, "stream_plumes_header: start\n");
+#endif
+  for (i = k = 0; i <= s->n; ++i)
+    {
+      channel = s->channel + i;
+      for (j = 0; j <= channel->nt; ++j, k += 2)
+        if (file)
+          {
+            memset (name, 0, STREAM_NAME_SIZE);
+            snprintf (name, STREAM_NAME_SIZE, "%s/%s/start",
+                      channel->name, s->transport[j].name);
+            fwrite (name, STREAM_NAME_SIZE, 1, file);
+            memset (name, 0, STREAM_NAME_SIZE);
+            snprintf (name, STREAM_NAME_SIZE, "%s/%s/end",
+                      channel->name, s->transport[j].name);
+            fwrite (name, STREAM_NAME_SIZE, 1, file);
+          }
+    }
+#if DEBUG_STREAM_PLUMES_HEADER
+  fprintf (stderr, "SPH ncolumns=%d\n", k);
+  fprintf (stderr, "stream_plumes_header: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_STREAM_PLUMES_HEADER
+#define stream_plumes_header _stream_plumes_header
+#else
+int stream_plumes_header (FILE *, System *);
+#endif
+
+static inline int
+_stream_contributions_header (FILE * file, System * s)
+{
+  int i, j, k, l;
+  char name[STREAM_NAME_SIZE];
+  ChannelTransport *ct;
+  Channel *channel;
+#if DEBUG_STREAM_CONTRIBUTIONS_HEADER
+  fprintf (stderr, "stream_contributions_header: start\n");
+#endif
+  for (i = l = 0; i <= s->n; ++i)
+    {
+      channel = s->channel + i;
+      for (j = 0; j <= channel->n; ++j, ++l)
+        if (file)
+          {
+            memset (name, 0, STREAM_NAME_SIZE);
+            snprintf (name, STREAM_NAME_SIZE, "%s/%s",
+                      channel->name, channel->bf[j].name);
+            fwrite (name, STREAM_NAME_SIZE, 1, file);
+          }
+      for (j = 0; j <= channel->nt; ++j)
+        {
+          ct = channel->ct + j;
+          for (k = 0; k <= ct->n; ++k, ++l)
+            if (file)
+              {
+                memset (name, 0, STREAM_NAME_SIZE);
+                snprintf (name, STREAM_NAME_SIZE, "%s/%s/%s", channel->name,
+                          s->transport[j].name, ct->bt[k].name);
+                fwrite (name, STREAM_NAME_SIZE, 1, file);
+              }
+        }
+    }
+#if DEBUG_STREAM_CONTRIBUTIONS_HEADER
+  fprintf (stderr, "SCH ncolumns=%d\n", l);
+  fprintf (stderr, "stream_contributions_header: end\n");
+#endif
+  return l;
+}
+
+#if INLINE_STREAM_CONTRIBUTIONS_HEADER
+#define stream_contributions_header _stream_contributions_header
+#else
+int stream_contributions_header (FILE *, System *);
+#endif
+
+static inline void
+_stream_plumes_record (JBDOUBLE * record, Parameters * p,
+                       TransportParameters * tp, System * s)
+{
+  int i, j, k, l;
+  JBFLOAT danger;
+  Channel *channel;
+#if DEBUG_STREAM_PLUMES_RECORD
+  fprintf (stderr, "stream_plumes_record: start\n");
+#endif
+  for (l = 0; l <= s->n; ++l)
+    {
+      channel = s->channel + l;
+      for (i = 0; i <= channel->nt; ++i)
+        {
+          danger = s->transport[i].danger;
+          for (j = channel->i; tp[j].c < danger && j < channel->i2;)
+            ++j;
+          for (k = channel->i2; tp[k].c < danger && k > 0;)
+            --k;
+          *(record++) = p[j].x;
+          *(record++) = p[k].x;
+        }
+    }
+#if DEBUG_STREAM_PLUMES_RECORD
+  fprintf (stderr, "stream_plumes_record: end\n");
+#endif
+}
+
+#if INLINE_STREAM_PLUMES_RECORD
+#define stream_plumes_record _stream_plumes_record
+#else
+void stream_plumes_record
+  (JBDOUBLE *, Parameters *, TransportParameters *, System *);
+#endif
+
+static inline void
+_stream_contributions_record (JBDOUBLE * record, System * s)
+{
+  int i, j, k;
+  ChannelTransport *ct;
+  Channel *channel;
+#if DEBUG_STREAM_CONTRIBUTIONS_RECORD
+  fprintf (stderr, "stream_contributions_record: start\n");
+#endif
+  for (i = 0; i <= s->n; ++i)
+    {
+      channel = s->channel + i;
+      for (j = 0; j <= channel->n; ++j)
+        *(record++) = channel->bf[j].contribution;
+      for (j = 0; j <= channel->nt; ++j)
+        {
+          ct = channel->ct + j;
+          for (k = 0; k <= ct->n; ++k)
+            *(record++) = ct->bt[k].contribution;
+        }
+    }
+#if DEBUG_STREAM_CONTRIBUTIONS_RECORD
+  fprintf (stderr, "stream_contributions_record: end\n");
+#endif
+}
+
+#if INLINE_STREAM_CONTRIBUTIONS_RECORD
+#define stream_contributions_record _stream_contributions_record
+#else
+void stream_contributions_record (JBDOUBLE *, System *);
+#endif
+
+static inline int
+_stream_open (Stream * stream, char *path, int type, System * s, long offset)
+{
+  StreamHeader header[1];
+#if DEBUG_STREAM_OPEN
+  fprintf (stderr, "stream_open: start\n");
+  fprintf (stderr, "SO path=%s type=%d format=%d offset=%ld\n",
+           path, type, s->streams_format, offset);
+#endif
+  stream->record = NULL;
+  stream->ncolumns = 0;
+  stream->type = type;
+  stream->format = s->streams_format;
+  if (stream->format == STREAMS_FORMAT_TEXT)
+    {
+      stream->file = write_file_open (path, 0, offset);
+      if (!stream->file)
+        goto exit1;
+      goto exit0;
+    }
+  stream->file = write_file_open (path, 1, offset);
+  if (!stream->file)
+    goto exit1;
+  if (type == STREAM_TYPE_PLUMES)
+    stream->ncolumns = stream_plumes_header (NULL, s);
+  else
+    stream->ncolumns = stream_contributions_header (NULL, s);
+  stream->record
+    = (JBDOUBLE *) g_try_malloc ((stream->ncolumns + 1) * sizeof (JBDOUBLE));
+  if (!stream->record)
+    {
+      fclose (stream->file);
+      stream->file = NULL;
+      jbw_show_error2 (path, gettext ("Not enough memory"));
+#if DEBUG_STREAM_OPEN
+      fprintf (stderr, "stream_open: end\n");
+#endif
+      return 0;
+    }
+  if (offset > 0)
+    goto exit0;
+  memset (header, 0, sizeof (StreamHeader));
+  memcpy (header->label, STREAM_LABEL, 8);
+  header->type = type;
+  header->ncolumns = stream->ncolumns;
+  header->size = sizeof (JBDOUBLE);
+  fwrite (header, sizeof (StreamHeader), 1, stream->file);
+  if (type == STREAM_TYPE_PLUMES)
+    stream_plumes_header (stream->file, s);
+  else
+    stream_contributions_header (stream->file, s);
+
+exit0:
+#if DEBUG_STREAM_OPEN
+  fprintf (stderr, "stream_open: end\n");
+#endif
+  return 1;
+
+exit1:
+  jbw_show_error2 (path, gettext ("Unable to open the file"));
+#if DEBUG_STREAM_OPEN
+  fprintf (stderr, "stream_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_STREAM_OPEN
+#define stream_open _stream_open
+#else
+int stream_open (Stream *, char *, int, System *, long);
+#endif
+
+static inline void
+_stream_write (Stream * stream, Parameters * p, TransportParameters * tp,
+               JBDOUBLE t, System * s)
+{
+#if DEBUG_STREAM_WRITE
+  fprintf (stderr, "stream_write: start\n");
+#endif
+  if (!stream->file)
+    goto exit0;
+  if (stream->format == STREAMS_FORMAT_TEXT)
+    {
+      if (stream->type == STREAM_TYPE_PLUMES)
+        write_plumes (stream->file, p, tp, t, s);
+      else
+        write_contributions (stream->file, t, s);
+      goto exit0;
+    }
+  if (stream->type == STREAM_TYPE_PLUMES)
+    {
+      if (s->nt < 0)
+        goto exit0;
+      stream_plumes_record (stream->record + 1, p, tp, s);
+    }
+  else
+    stream_contributions_record (stream->record + 1, s);
+  stream->record[0] = t;
+  fwrite (stream->record, sizeof (JBDOUBLE), stream->ncolumns + 1,
+          stream->file);
+exit0:
+#if DEBUG_STREAM_WRITE
+  fprintf (stderr, "stream_write: end\n");
+#endif
+  return;
+}
+
+#if INLINE_STREAM_WRITE
+#define stream_write _stream_write
+#else
+void stream_write
+  (Stream *, Parameters *, TransportParameters *, JBDOUBLE, System *);
+#endif
+
+static inline void
+_stream_close (Stream * stream)
+{
+#if DEBUG_STREAM_CLOSE
+  fprintf (stderr, "stream_close: start\n");
+#endif
+  if (stream->file)
+    fclose (stream->file);
+  stream->file = NULL;
+  jb_free_null ((void **) &stream->record);
+#if DEBUG_STREAM_CLOSE
+  fprintf (stderr, "stream_close: end\n");
+#endif
+}
+
+#if INLINE_STREAM_CLOSE
+#define stream_close _stream_close
+#else
+void stream_close (Stream *);
+#endif
+
+static inline int
+_stream_convert (char *name_read, char *name_write)
+{
+  int i, k;
+  JBDOUBLE *record;
+  StreamHeader header[1];
+  FILE *file_read, *file_write;
+#if DEBUG_STREAM_CONVERT
+  fprintf (stderr, "stream_convert: start\n");
+  fprintf (stderr, "SC read=%s write=%s\n", name_read, name_write);
+#endif
+  k = 0;
+  file_read = g_fopen (name_read, "rb");
+  if (!file_read)
+    {
+      jbw_show_error2 (name_read, gettext ("Unable to open the file"));
+      goto exit3;
+    }
+  if (fread (header, sizeof (StreamHeader), 1, file_read) != 1
+      || memcmp (header->label, STREAM_LABEL, 8)
+      || header->size != sizeof (JBDOUBLE) || header->ncolumns < 0
+      || fseek (file_read, header->ncolumns * STREAM_NAME_SIZE, SEEK_CUR))
+    {
+      jbw_show_error2 (name_read, gettext ("Bad binary stream file"));
+      goto exit2;
+    }
+#if DEBUG_STREAM_CONVERT
+  fprintf (stderr, "SC type=%d ncolumns=%d\n", header->type, header->ncolumns);
+#endif
+  record = (JBDOUBLE *)
+    g_try_malloc ((header->ncolumns + 1) * sizeof (JBDOUBLE));
+  if (!record)
+    {
+      jbw_show_error2 (name_read, gettext ("Not enough memory"));
+      goto exit2;
+    }
+  file_write = g_fopen (name_write, "w");
+  if (!file_write)
+    {
+      jbw_show_error2 (name_write, gettext ("Unable to open the file"));
+      goto exit1;
+    }
+  while (fread (record, sizeof (JBDOUBLE), header->ncolumns + 1, file_read)
+         == (size_t) header->ncolumns + 1)
+    {
+      if (header->type == STREAM_TYPE_PLUMES)
+        {
+          fprintf (file_write, FWL " ", record[0]);
+          for (i = 1; i < header->ncolumns; i += 2)
+            fprintf (file_write, FWF " " FWF " ",
+                     (JBFLOAT) record[i], (JBFLOAT) record[i + 1]);
+        }
+      else
+        {
+          fprintf (file_write, FWL, record[0]);
+          for (i = 1; i <= header->ncolumns; ++i)
+            fprintf (file_write, " " FWL, record[i]);
+        }
+      fprintf (file_write, "\n");
+    }
+  fclose (file_write);
+  k = 1;
+
+exit1:
+  jb_free_null ((void **) &record);
+
+exit2:
+  fclose (file_read);
+
+exit3:
+#if DEBUG_STREAM_CONVERT
+  fprintf (stderr, "stream_convert: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_STREAM_CONVERT
+#define stream_convert _stream_convert
+#else
+int stream_convert (char *, char *);
+#endif
+
+static inline int
+_write_output_open (Output * o, System * s, JBDOUBLE t, long offset)
+{
+  int k;
+  char *path;
+  ChannelGeometry *cg;
+#if DEBUG_WRITE_OUTPUT_OPEN
+  fprintf (stderr, "write_output_open: start\n");
+#endif
+  o->t = INFINITY;
+  cg = s->channel[o->ichannel].cg;
+  o->i = cg->cs[o->pos].i;
+  o->i2 = cg->cs[o->pos2].i;
+  k = o->i2 - o->i + 1;
+#if DEBUG_WRITE_OUTPUT_OPEN
+  fprintf (stderr, "WOO name=%s i=%d i2=%d\n", o->name, o->i, o->i2);
+#endif
+  o->data = (JBFLOAT *) g_try_malloc (k * o->nvariables * sizeof (JBFLOAT));
+  if (!o->data)
+    {
+      jbw_show_error2 (o->name, gettext ("Not enough memory"));
+      goto exit1;
+    }
+  path = g_build_filename (s->directory, o->name, NULL);
+  o->file = write_file_open (path, 1, offset);
+  g_free (path);
+  if (!o->file)
+    {
+      jb_free_null ((void **) &o->data);
+      jbw_show_error2 (o->name, gettext ("Unable to open the file"));
+      goto exit1;
+    }
+  if (offset <= 0)
+    {
+      fwrite (&o->nvariables, sizeof (int), 1, o->file);
+      fwrite (&k, sizeof (int), 1, o->file);
+      fwrite (o->variable, sizeof (int), o->nvariables, o->file);
+    }
+  o->t = t;
+#if DEBUG_WRITE_OUTPUT_OPEN
+  fprintf (stderr, "write_output_open: end\n");
+#endif
+  return 1;
+
+exit1:
+#if DEBUG_WRITE_OUTPUT_OPEN
+  fprintf (stderr, "write_output_open: end\n");
+#endif
+  return 0;
+}
+
+#if INLINE_WRITE_OUTPUT_OPEN
+#define write_output_open _write_output_open
+#else
+int write_output_open (Output *, System *, JBDOUBLE, long);
+#endif
+
+static inline void
+_write_output (Output * o, Parameters * p, TransportParameters * tp,
+               JBDOUBLE t, int n)
+{
+  int i, j;
+  register JBFLOAT *data;
+  Parameters *pv;
+  TransportParameters *tpv;
+#if DEBUG_WRITE_OUTPUT
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "write_output: start\n");
+#endif
+  if (!o->file)
+    goto exit0;
+  for (j = 0, data = o->data; j < o->nvariables; ++j)
+    {
+      pv = p + o->i;
+      switch (o->variable[j])
+        {
+        case OUTPUT_VARIABLE_X:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->x;
+          break;
+        case OUTPUT_VARIABLE_Q:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->Q;
+          break;
+        case OUTPUT_VARIABLE_ZS:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->zs;
+          break;
+        case OUTPUT_VARIABLE_A:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->A;
+          break;
+        case OUTPUT_VARIABLE_B:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->B;
+          break;
+        case OUTPUT_VARIABLE_ZB:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->s->sp->z;
+          break;
+        case OUTPUT_VARIABLE_ZMAX:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->s->zmax;
+          break;
+        case OUTPUT_VARIABLE_BETA:
+          for (i = o->i; i <= o->i2; ++i, ++pv)
+            *(data++) = pv->beta;
+          break;
+        default:
+          tpv = tp + o->i
+            + (o->variable[j] - OUTPUT_VARIABLE_SOLUTE) * (n + 1);
+          for (i = o->i; i <= o->i2; ++i, ++tpv)
+            *(data++) = tpv->c;
+        }
+    }
+  fwrite (&t, sizeof (JBDOUBLE), 1, o->file);
+  fwrite (o->data, sizeof (JBFLOAT), data - o->data, o->file);
+  if (o->interval > 0.)
+    o->t += o->interval;
+  else
+    o->t += ti;
+exit0:
+#if DEBUG_WRITE_OUTPUT
+  if (t >= DEBUG_TIME)
+    {
+      fprintf (stderr, "WO t=" FWL " next=" FWL "\n", t, o->t);
+      fprintf (stderr, "write_output: end\n");
+    }
+#endif
+  return;
+}
+
+#if INLINE_WRITE_OUTPUT
+#define write_output _write_output
+#else
+void write_output
+  (Output *, Parameters *, TransportParameters *, JBDOUBLE, int);
+#endif
+
+static inline void
+_write_output_close (Output * o)
+{
+#if DEBUG_WRITE_OUTPUT_CLOSE
+  fprintf (stderr, "write_output_close: start\n");
+#endif
+  if (o->file)
+    fclose (o->file);
+  o->file = NULL;
+  jb_free_null ((void **) &o->data);
+#if DEBUG_WRITE_OUTPUT_CLOSE
+  fprintf (stderr, "write_output_close: end\n");
+#endif
+}
+
+#if INLINE_WRITE_OUTPUT_CLOSE
+#define write_output_close _write_output_close
+#else
+void write_output_close (Output *);
+#endif
+
+/**
+ * \struct Sampler
+ * \brief Structure to save the solution at the measured times by interpolation
+ *   or time averaging without shortening the time steps.
+ */
+typedef struct
+{
+/**
+ * \var v0
+ * \brief variables at the start of the current time step.
+ * \var v1
+ * \brief time integrals of the variables on the current measured interval.
+ *   Solute concentrations are integrated as solute masses.
+ * \var t0
+ * \brief time of the v0 variables.
+ * \var ta
+ * \brief start time of the current measured interval.
+ * \var mode
+ * \brief output mode.
+ * \var size
+ * \brief number of cells.
+ * \var nvalues
+ * \brief number of values in a solution record.
+ */
+  JBFLOAT *v0, *v1;
+  JBDOUBLE t0, ta;
+  int mode, size, nvalues;
+} Sampler;
+
+static inline int
+_sampler_open (Sampler * s, int mode, Variables * v, int n, int nt,
+               JBDOUBLE t)
+{
+#if DEBUG_SAMPLER_OPEN
+  fprintf (stderr, "sampler_open: start\n");
+#endif
+  s->v0 = s->v1 = NULL;
+  s->mode = OUTPUT_MODE_CLIP;
+  if (mode == OUTPUT_MODE_CLIP)
+    goto exit1;
+  s->size = n + 1;
+  s->nvalues = (N_OF_VARIABLES + nt + 1) * s->size;
+  s->v0 = (JBFLOAT *) g_try_malloc (2 * s->nvalues * sizeof (JBFLOAT));
+  if (!s->v0)
+    {
+      jbw_show_error2 (gettext ("Output mode"), gettext ("Not enough memory"));
+#if DEBUG_SAMPLER_OPEN
+      fprintf (stderr, "sampler_open: end\n");
+#endif
+      return 0;
+    }
+  s->v1 = s->v0 + s->nvalues;
+  s->mode = mode;
+  variables_actualize (v);
+  memcpy (s->v0, v->x, s->nvalues * sizeof (JBFLOAT));
+  memset (s->v1, 0, s->nvalues * sizeof (JBFLOAT));
+  s->t0 = s->ta = t;
+#if DEBUG_SAMPLER_OPEN
+  fprintf (stderr, "SO mode=%d nvalues=%d\n", s->mode, s->nvalues);
+#endif
+
+exit1:
+#if DEBUG_SAMPLER_OPEN
+  fprintf (stderr, "sampler_open: end\n");
+#endif
+  return 1;
+}
+
+#if INLINE_SAMPLER_OPEN
+#define sampler_open _sampler_open
+#else
+int sampler_open (Sampler *, int, Variables *, int, int, JBDOUBLE);
+#endif
+
+static inline void
+_sampler_advance (Sampler * s, Variables * v, JBDOUBLE t)
+{
+  register int i, k;
+  register JBDOUBLE dt;
+  JBFLOAT *A0;
+#if DEBUG_SAMPLER_ADVANCE
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "sampler_advance: start\n");
+#endif
+  variables_actualize (v);
+  if (s->mode == OUTPUT_MODE_AVERAGE)
+    {
+      dt = 0.5 * (t - s->t0);
+      A0 = s->v0 + (v->A - v->x);
+      for (k = N_OF_VARIABLES * s->size, i = 0; k < s->nvalues; ++k)
+        {
+          s->v1[k] += (A0[i] * s->v0[k] + v->A[i] * v->x[k]) * dt;
+          if (++i == s->size)
+            i = 0;
+        }
+      for (k = 0; k < N_OF_VARIABLES * s->size; ++k)
+        s->v1[k] += (s->v0[k] + v->x[k]) * dt;
+    }
+  memcpy (s->v0, v->x, s->nvalues * sizeof (JBFLOAT));
+  s->t0 = t;
+#if DEBUG_SAMPLER_ADVANCE
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "sampler_advance: end\n");
+#endif
+}
+
+#if INLINE_SAMPLER_ADVANCE
+#define sampler_advance _sampler_advance
+#else
+void sampler_advance (Sampler *, Variables *, JBDOUBLE);
+#endif
+
+static inline int
+_sampler_write (Sampler * s, Variables * v, JBDOUBLE t, JBDOUBLE at,
+                FILE * file)
+{
+  register int i, k;
+  register JBDOUBLE w, dt, a, c;
+  JBDOUBLE ia;
+  JBFLOAT *A0, *v1;
+#if DEBUG_SAMPLER_WRITE
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "sampler_write: start\n");
+#endif
+  variables_actualize (v);
+  dt = at - s->t0;
+  if (t > s->t0)
+    w = dt / (t - s->t0);
+  else
+    w = 1.;
+  A0 = s->v0 + (v->A - v->x);
+  v1 = s->v1 + (v->A - v->x);
+  if (at > s->ta)
+    ia = 1. / (at - s->ta);
+  else
+    ia = 0.;
+#if DEBUG_SAMPLER_WRITE
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "SW t=" FWL " at=" FWL " w=" FWL "\n", t, at, w);
+#endif
+
+  // solute concentrations from the interpolated solute masses
+  for (k = N_OF_VARIABLES * s->size, i = 0; k < s->nvalues; ++k)
+    {
+      a = A0[i] + w * (v->A[i] - A0[i]);
+      c = s->v0[k] + w * (v->x[k] - s->v0[k]);
+      if (a > 0.)
+        c = (A0[i] * s->v0[k] + w * (v->A[i] * v->x[k] - A0[i] * s->v0[k]))
+          / a;
+      if (s->mode == OUTPUT_MODE_AVERAGE)
+        {
+          s->v1[k] += 0.5 * (A0[i] * s->v0[k] + a * c) * dt;
+          a = v1[i] + 0.5 * (A0[i] + a) * dt;
+          if (a > 0.)
+            s->v1[k] /= a;
+          else
+            s->v1[k] = c;
+        }
+      s->v0[k] = c;
+      if (++i == s->size)
+        i = 0;
+    }
+
+  // flow variables
+  for (k = 0; k < N_OF_VARIABLES * s->size; ++k)
+    {
+      c = s->v0[k] + w * (v->x[k] - s->v0[k]);
+      if (s->mode == OUTPUT_MODE_AVERAGE)
+        {
+          if (ia > 0.)
+            s->v1[k] = (s->v1[k] + 0.5 * (s->v0[k] + c) * dt) * ia;
+          else
+            s->v1[k] = c;
+        }
+      s->v0[k] = c;
+    }
+
+  s->t0 = s->ta = at;
+  if (s->mode == OUTPUT_MODE_AVERAGE)
+    {
+      k = fwrite (s->v1, sizeof (JBFLOAT), s->nvalues, file);
+      memset (s->v1, 0, s->nvalues * sizeof (JBFLOAT));
+    }
+  else
+    k = fwrite (s->v0, sizeof (JBFLOAT), s->nvalues, file);
+  if (k != s->nvalues)
+    k = 0;
+  ++nstep;
+#if DEBUG_SAMPLER_WRITE
+  if (t >= DEBUG_TIME)
+    fprintf (stderr, "sampler_write: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_SAMPLER_WRITE
+#define sampler_write _sampler_write
+#else
+int sampler_write (Sampler *, Variables *, JBDOUBLE, JBDOUBLE, FILE *);
+#endif
+
+static inline void
+_sampler_close (Sampler * s)
+{
+#if DEBUG_SAMPLER_CLOSE
+  fprintf (stderr, "sampler_close: start\n");
+#endif
+  jb_free_null ((void **) &s->v0);
+  s->v1 = NULL;
+  s->mode = OUTPUT_MODE_CLIP;
+#if DEBUG_SAMPLER_CLOSE
+  fprintf (stderr, "sampler_close: end\n");
+#endif
+}
+
+#if INLINE_SAMPLER_CLOSE
+#define sampler_close _sampler_close
+#else
+void sampler_close (Sampler *);
+#endif
+
+/**
+ * \def CHECKPOINT_LABEL
+ * \brief Macro to define the label identifying the binary checkpoint files.
+ */
+#define CHECKPOINT_LABEL "SWIGSCHK"
+
+/**
+ * \struct Checkpoint
+ * \brief Structure to define the header of a binary checkpoint file. It is
+ *   followed by the mesh cells parameters, the cell sections, the transport
+ *   parameters, the mass balances, the junction volumes and masses, the
+ *   boundary contributions, the control state of the cross sections, the
+ *   sampler state and the next time and file offset of every selective output.
+ */
+typedef struct
+{
+/**
+ * \var label
+ * \brief CHECKPOINT_LABEL identifier.
+ * \var key
+ * \brief key of the mesh geometry.
+ * \var n
+ * \brief number of mesh cells.
+ * \var nt
+ * \brief number of transported solutes.
+ * \var nout
+ * \brief number of selective outputs.
+ * \var njunctions
+ * \brief number of junctions.
+ * \var size_parameters
+ * \brief size in bytes of the saved fields of a mesh cell parameters struct.
+ * \var size_section
+ * \brief size in bytes of the scalar fields of a section.
+ * \var size_sp
+ * \brief size in bytes of a section parameters struct.
+ * \var size_fp
+ * \brief size in bytes of a friction parameters struct.
+ * \var size_tp
+ * \brief size in bytes of a transport parameters struct.
+ * \var size_mass
+ * \brief size in bytes of the saved fields of a mass balance struct.
+ * \var mode
+ * \brief sampler output mode.
+ * \var k
+ * \brief number of time steps since the last streams record.
+ * \var nstep
+ * \brief number of time points with saved results.
+ * \var channel_overflow
+ * \brief boolean defining if they are a channel overflow event.
+ * \var t
+ * \brief actual time.
+ * \var tmax
+ * \brief final time of the next calculation step.
+ * \var dt
+ * \brief size of the last time step.
+ * \var dtmax
+ * \brief maximum size of time step allowed by flow.
+ * \var fdtmax
+ * \brief maximum size of time step allowed by friction.
+ * \var dt2
+ * \brief \f$0.5 * dt\f$.
+ * \var dt2v
+ * \brief dt2 in the former time step.
+ * \var at
+ * \brief last measured time.
+ * \var st
+ * \brief next time to save the plumes and contributions.
+ * \var ct
+ * \brief next time to save a checkpoint.
+ * \var solution
+ * \brief offset of the solution file.
+ * \var plumes
+ * \brief offset of the plumes file.
+ * \var contributions
+ * \brief offset of the contributions file.
+ */
+  char label[8], key[MESH_CACHE_KEY_SIZE];
+  int n, nt, nout, njunctions, size_parameters, size_section, size_sp, size_fp,
+    size_tp, size_mass, mode, k, nstep, channel_overflow;
+  JBDOUBLE t, tmax, dt, dtmax, fdtmax, dt2, dt2v, at, st, ct;
+  gint64 solution, plumes, contributions;
+} Checkpoint;
+
+static inline int
+_checkpoint_save (Checkpoint * c, Sampler * sampler, Stream * plumes,
+                  Stream * contributions, System * s, char *path)
+{
+  int i, j, l, k;
+  char *tmp;
+  gint64 offset;
+  FILE *file;
+  Section *section;
+  Junction *jn;
+  ChannelTransport *ct;
+  CrossSection *cs;
+  Channel *channel;
+  Output *o;
+#if DEBUG_CHECKPOINT_SAVE
+  fprintf (stderr, "checkpoint_save: start\n");
+  fprintf (stderr, "CS t=" FWL "\n", t);
+#endif
+  k = 0;
+  memcpy (c->label, CHECKPOINT_LABEL, 8);
+  c->n = n;
+  c->nt = s->nt;
+  c->nout = s->nout;
+  c->njunctions = njunctions;
+  c->size_parameters = (size_t) & p->s - (size_t) p;
+  c->size_section = (size_t) & p->s->sp - (size_t) p->s;
+  c->size_sp = sizeof (SectionParameters);
+  c->size_fp = sizeof (FrictionParameters);
+  c->size_tp = sizeof (TransportParameters);
+  c->size_mass = (size_t) & m->mi - (size_t) m;
+  c->mode = sampler->mode;
+  c->nstep = nstep;
+  c->channel_overflow = channel_overflow;
+  c->t = t;
+  c->tmax = tmax;
+  c->dt = dt;
+  c->dtmax = dtmax;
+  c->fdtmax = fdtmax;
+  c->dt2 = dt2;
+#if MODEL_PRESSURE == MODEL_PRESSURE_HIGH_ORDER
+  c->dt2v = dt2v;
+#else
+  c->dt2v = 0.;
+#endif
+  c->solution = write_file_offset (s->save_solution ? s->solution_file : NULL);
+  c->plumes = write_file_offset (plumes->file);
+  c->contributions = write_file_offset (contributions->file);
+  tmp = g_strconcat (path, ".tmp", NULL);
+  file = g_fopen (tmp, "wb");
+  if (!file)
+    goto exit1;
+  fwrite (c, sizeof (Checkpoint), 1, file);
+  for (i = 0; i <= n; ++i)
+    fwrite (p + i, c->size_parameters, 1, file);
+  for (i = 0; i <= n; ++i)
+    {
+      section = p[i].s;
+      fwrite (section, c->size_section, 1, file);
+      fwrite (section->sp, sizeof (SectionParameters), section->n + 1, file);
+      fwrite (section->fp, sizeof (FrictionParameters), section->nf + 1, file);
+    }
+  fwrite (tp, sizeof (TransportParameters), (s->nt + 1) * (n + 1), file);
+  for (i = 0; i <= s->nt + 1; ++i)
+    fwrite (m + i, c->size_mass, 1, file);
+  for (i = 0, jn = junction; i <= njunctions; ++i, ++jn)
+    {
+      fwrite (jn->volume, sizeof (JunctionVolume), jn->nvolumes + 1, file);
+      fwrite (jn->mass, sizeof (JBFLOAT), s->nt + 2, file);
+    }
+  for (i = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+    {
+      for (j = 0; j <= channel->n; ++j)
+        fwrite (&channel->bf[j].contribution, sizeof (JBFLOAT), 1, file);
+      for (j = 0, ct = channel->ct; j <= channel->nt; ++j, ++ct)
+        for (l = 0; l <= ct->n; ++l)
+          fwrite (&ct->bt[l].contribution, sizeof (JBFLOAT), 1, file);
+      for (j = 0, cs = channel->cg->cs; j <= channel->cg->n; ++j, ++cs)
+        {
+          fwrite (&cs->j, sizeof (int), 1, file);
+          fwrite (&cs->nt, sizeof (int), 1, file);
+          fwrite (&cs->tmax, sizeof (JBFLOAT), 1, file);
+          fwrite (&cs->pt, sizeof (JBFLOAT), 1, file);
+          fwrite (&cs->position, sizeof (JBFLOAT), 1, file);
+          fwrite (&cs->error, sizeof (JBFLOAT), 1, file);
+        }
+    }
+  if (sampler->mode != OUTPUT_MODE_CLIP)
+    {
+      fwrite (&sampler->t0, sizeof (JBDOUBLE), 1, file);
+      fwrite (&sampler->ta, sizeof (JBDOUBLE), 1, file);
+      fwrite (sampler->v0, sizeof (JBFLOAT), 2 * sampler->nvalues, file);
+    }
+  for (i = 0, o = s->output; i <= s->nout; ++i, ++o)
+    {
+      offset = write_file_offset (o->file);
+      fwrite (&o->t, sizeof (JBDOUBLE), 1, file);
+      fwrite (&offset, sizeof (gint64), 1, file);
+    }
+  k = !ferror (file);
+  if (fclose (file))
+    k = 0;
+  if (k && g_rename (tmp, path))
+    k = 0;
+  if (!k)
+    g_remove (tmp);
+
+exit1:
+  g_free (tmp);
+  if (!k)
+    jbw_show_warning (gettext ("Unable to save the checkpoint"));
+#if DEBUG_CHECKPOINT_SAVE
+  fprintf (stderr, "checkpoint_save: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_CHECKPOINT_SAVE
+#define checkpoint_save _checkpoint_save
+#else
+int checkpoint_save
+  (Checkpoint *, Sampler *, Stream *, Stream *, System *, char *);
+#endif
+
+static inline int
+_checkpoint_load (Checkpoint * c, Sampler * sampler, Stream * plumes,
+                  Stream * contributions, System * s, char *name, char *path)
+{
+  int i, j, l, k;
+  char key[MESH_CACHE_KEY_SIZE];
+  gint64 offset;
+  JBDOUBLE to;
+  FILE *file;
+  Section *section;
+  Junction *jn;
+  ChannelTransport *ct;
+  CrossSection *cs;
+  Channel *channel;
+  Output *o;
+#if DEBUG_CHECKPOINT_LOAD
+  fprintf (stderr, "checkpoint_load: start\n");
+#endif
+  k = 0;
+  memcpy (key, c->key, MESH_CACHE_KEY_SIZE);
+  file = g_fopen (path, "rb");
+  if (!file)
+    {
+      jbw_show_error2 (name, gettext ("Unable to open the file"));
+      goto exit2;
+    }
+  if (fread (c, sizeof (Checkpoint), 1, file) != 1
+      || memcmp (c->label, CHECKPOINT_LABEL, 8)
+      || memcmp (c->key, key, MESH_CACHE_KEY_SIZE)
+      || c->n != n || c->nt != s->nt || c->nout != s->nout
+      || c->njunctions != njunctions
+      || c->size_parameters != (size_t) & p->s - (size_t) p
+      || c->size_section != (size_t) & p->s->sp - (size_t) p->s
+      || c->size_sp != sizeof (SectionParameters)
+      || c->size_fp != sizeof (FrictionParameters)
+      || c->size_tp != sizeof (TransportParameters)
+      || c->size_mass != (size_t) & m->mi - (size_t) m
+      || c->mode != sampler->mode)
+    goto exit1;
+#if DEBUG_CHECKPOINT_LOAD
+  fprintf (stderr, "CL t=" FWL "\n", c->t);
+#endif
+  for (i = 0; i <= n; ++i)
+    if (fread (p + i, c->size_parameters, 1, file) != 1)
+      goto exit1;
+  // the sections are read in separate tables and packed again in the mesh
+  // arena sharing the identical tables, as in mesh_open
+  for (i = 0; i <= n; ++i)
+    section_delete (p[i].s);
+  section_arena_delete (mesh_arena);
+  for (i = 0; i <= n; ++i)
+    {
+      section = p[i].s;
+      if (fread (section, c->size_section, 1, file) != 1
+          || section->n < 0 || section->nf < 0
+          || !section_create (section, section->n, section->nf, NULL))
+        goto exit1;
+      fread (section->sp, sizeof (SectionParameters), section->n + 1, file);
+      fread (section->fp, sizeof (FrictionParameters), section->nf + 1, file);
+    }
+  if (!mesh_pack_sections (p, n, mesh_arena))
+    goto exit2;
+  fread (tp, sizeof (TransportParameters), (s->nt + 1) * (n + 1), file);
+  for (i = 0; i <= s->nt + 1; ++i)
+    fread (m + i, c->size_mass, 1, file);
+  for (i = 0, jn = junction; i <= njunctions; ++i, ++jn)
+    {
+      fread (jn->volume, sizeof (JunctionVolume), jn->nvolumes + 1, file);
+      fread (jn->mass, sizeof (JBFLOAT), s->nt + 2, file);
+    }
+  for (i = 0, channel = s->channel; i <= s->n; ++i, ++channel)
+    {
+      for (j = 0; j <= channel->n; ++j)
+        fread (&channel->bf[j].contribution, sizeof (JBFLOAT), 1, file);
+      for (j = 0, ct = channel->ct; j <= channel->nt; ++j, ++ct)
+        for (l = 0; l <= ct->n; ++l)
+          fread (&ct->bt[l].contribution, sizeof (JBFLOAT), 1, file);
+      for (j = 0, cs = channel->cg->cs; j <= channel->cg->n; ++j, ++cs)
+        {
+          fread (&cs->j, sizeof (int), 1, file);
+          fread (&cs->nt, sizeof (int), 1, file);
+          fread (&cs->tmax, sizeof (JBFLOAT), 1, file);
+          fread (&cs->pt, sizeof (JBFLOAT), 1, file);
+          fread (&cs->position, sizeof (JBFLOAT), 1, file);
+          fread (&cs->error, sizeof (JBFLOAT), 1, file);
+        }
+    }
+  if (sampler->mode != OUTPUT_MODE_CLIP)
+    {
+      fread (&sampler->t0, sizeof (JBDOUBLE), 1, file);
+      fread (&sampler->ta, sizeof (JBDOUBLE), 1, file);
+      fread (sampler->v0, sizeof (JBFLOAT), 2 * sampler->nvalues, file);
+    }
+  if (feof (file) || ferror (file))
+    goto exit1;
+  if (s->save_solution)
+    {
+      s->solution_file = write_file_open (s->solution_path, 1, c->solution);
+      if (!s->solution_file)
+        {
+          jbw_show_error2 (s->solution_name,
+                           gettext ("Unable to open the file"));
+          goto exit2;
+        }
+    }
+  for (i = 0, o = s->output; i <= s->nout; ++i, ++o)
+    {
+      o->file = NULL;
+      if (fread (&to, sizeof (JBDOUBLE), 1, file) == 1
+          && fread (&offset, sizeof (gint64), 1, file) == 1)
+        write_output_open (o, s, to, (long) offset);
+    }
+  if (s->plumes_path)
+    stream_open (plumes, s->plumes_path, STREAM_TYPE_PLUMES, s,
+                 (long) c->plumes);
+  if (s->contributions_path)
+    stream_open (contributions, s->contributions_path,
+                 STREAM_TYPE_CONTRIBUTIONS, s, (long) c->contributions);
+  t = c->t;
+  tmax = c->tmax;
+  dt = c->dt;
+  dtmax = c->dtmax;
+  fdtmax = c->fdtmax;
+  dt2 = c->dt2;
+#if MODEL_PRESSURE == MODEL_PRESSURE_HIGH_ORDER
+  dt2v = c->dt2v;
+#endif
+  nstep = c->nstep;
+  channel_overflow = c->channel_overflow;
+  k = 1;
+  goto exit2;
+
+exit1:
+  jbw_show_error2 (name, gettext ("Bad checkpoint file"));
+
+exit2:
+  if (file)
+    fclose (file);
+#if DEBUG_CHECKPOINT_LOAD
+  fprintf (stderr, "checkpoint_load: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_CHECKPOINT_LOAD
+#define checkpoint_load _checkpoint_load
+#else
+int checkpoint_load
+  (Checkpoint *, Sampler *, Stream *, Stream *, System *, char *, char *);
+#endif
+
+/**
+ * \struct Status
+ * \brief Structure to define the live status file of a running simulation.
+ */
+typedef struct
+{
+/**
+ * \var t0
+ * \brief simulated time at the start of the run.
+ * \var interval
+ * \brief wall time interval in microseconds to rewrite the file.
+ * \var start
+ * \brief wall time at the start of the run.
+ * \var next
+ * \brief wall time to rewrite the file.
+ * \var last
+ * \brief wall time of the last rewrite.
+ * \var steps
+ * \brief number of time steps since the start of the run.
+ * \var last_steps
+ * \brief number of time steps at the last rewrite.
+ */
+  JBDOUBLE t0;
+  gint64 interval, start, next, last;
+  long int steps, last_steps;
+} Status;
+
+static inline void
+_status_open (Status * st, System * s)
+{
+#if DEBUG_STATUS_OPEN
+  fprintf (stderr, "status_open: start\n");
+#endif
+  st->t0 = t;
+  st->interval = (gint64) (1e6 * s->status_interval);
+  st->start = st->last = g_get_monotonic_time ();
+  st->next = st->start + st->interval;
+  st->steps = st->last_steps = 0;
+#if DEBUG_STATUS_OPEN
+  fprintf (stderr, "status_open: end\n");
+#endif
+}
+
+#if INLINE_STATUS_OPEN
+#define status_open _status_open
+#else
+void status_open (Status *, System *);
+#endif
+
+static inline int
+_status_write (Status * st, System * s, int finished)
+{
+  int i, j, k;
+  char *name;
+  gint64 now;
+  double wall;
+  JBDOUBLE elapsed;
+  FILE *file;
+#if DEBUG_STATUS_WRITE
+  fprintf (stderr, "status_write: start\n");
+#endif
+  k = 0;
+  now = g_get_monotonic_time ();
+  wall = 1e-6 * (now - st->start);
+  elapsed = t - st->t0;
+  name = g_strconcat (s->status_path, ".tmp", NULL);
+  file = g_fopen (name, "w");
+  if (!file)
+    goto exit1;
+  fprintf (file, "{\n  \"state\": \"%s\",\n  \"time\": " FWL ",\n"
+           "  \"final_time\": " FWL ",\n  \"progress\": " FWL ",\n",
+           finished ? (t < tf ? "stopped" : "finished") : "running",
+           t - s->initial_time,
+           tf - s->initial_time,
+           tf > s->initial_time ? (t - s->initial_time)
+           / (tf - s->initial_time) : 1.);
+  fprintf (file, "  \"time_step\": " FWL ",\n  \"steps\": %ld,\n"
+           "  \"wall_time\": %.6f,\n  \"steps_per_second\": %.6f,\n"
+           "  \"average_steps_per_second\": %.6f,\n", dt, st->steps,
+           wall, now > st->last ? 1e6 * (st->steps - st->last_steps)
+           / (now - st->last) : 0., wall > 0. ? st->steps / wall : 0.);
+  if (t >= tf)
+    fprintf (file, "  \"eta\": 0.,\n");
+  else if (!finished && elapsed > 0.)
+    fprintf (file, "  \"eta\": %.6f,\n", (double) (wall * (tf - t) / elapsed));
+  else
+    fprintf (file, "  \"eta\": null,\n");
+  fprintf (file, "  \"limiter\": {\"type\": \"%s\", \"channel\": %d, "
+           "\"index\": %d},\n", limiter_type_name[limiter->type],
+           limiter->channel, limiter->index);
+  fprintf (file, "  \"mass_errors\": [" FWL, flow_mass_error (m, p, n));
+  for (i = j = 0; i <= s->nt; ++i, j += n + 1)
+    fprintf (file, ", " FWL, transport_mass_error (m + i + 1, tp + j, n));
+  fprintf (file, "],\n  \"phases\": [\n");
+  for (i = 0; i < PROFILE_PHASES; ++i)
+    fprintf (file, "    {\"name\": \"%s\", \"calls\": %ld, \"time\": %.6f}%s\n",
+             profile_phase_name[i], (long) profile->calls[i],
+             1e-6 * profile->time[i], i < PROFILE_PHASES - 1 ? "," : "");
+  fprintf (file, "  ]\n}\n");
+  k = !ferror (file);
+  if (fclose (file))
+    k = 0;
+  if (k && g_rename (name, s->status_path))
+    k = 0;
+  if (!k)
+    g_remove (name);
+
+exit1:
+  g_free (name);
+  if (!k)
+    jbw_show_warning (gettext ("Unable to save the status file"));
+  st->last = now;
+  st->last_steps = st->steps;
+  st->next = now + st->interval;
+#if DEBUG_STATUS_WRITE
+  fprintf (stderr, "status_write: end\n");
+#endif
+  return k;
+}
+
+#if INLINE_STATUS_WRITE
+#define status_write _status_write
+#else
+int status_write (Status *, System *, int);
+#endif
+
+static inline void
+_status_step (Status * st, System * s)
+{
+#if DEBUG_STATUS_STEP
+  fprintf (stderr, "status_step: start\n");
+#endif
+  ++st->steps;
+  if (g_get_monotonic_time () >= st->next)
+    status_write (st, s, 0);
+#if DEBUG_STATUS_STEP
+  fprintf (stderr, "status_step: end\n");
+#endif
+}
+
+#if INLINE_STATUS_STEP
+#define status_step _status_step
+#else
+void status_step (Status *, System *);
+#endif
+
 #endif